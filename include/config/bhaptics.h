@@ -4,4 +4,8 @@
 
 #include "config/bluetooth.h"
 
+#ifndef SS_BH_OUTPUT_TASK_PRIORITY
+#define SS_BH_OUTPUT_TASK_PRIORITY 2
+#endif
+
 #endif
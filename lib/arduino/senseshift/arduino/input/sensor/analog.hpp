@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include <senseshift/input/sensor.hpp>
+#include <senseshift/math/fixed_point.hpp>
 
 #include <Arduino.h>
 
@@ -39,4 +40,32 @@ class AnalogSimpleSensor : public ::SenseShift::Input::IFloatSimpleSensor {
         return static_cast<float>(raw) / ANALOG_MAX;
     }
 };
+
+/// Analog sensor, that reads into a fixed-point value (between 0 and Format::ONE), without the float math.
+///
+/// \tparam Format Fixed-point format of the value, e.g. Math::Q15.
+template<typename Format>
+class AnalogFixedPointSimpleSensor : public ::SenseShift::Input::ISimpleSensor<typename Format::ValueType> {
+    const std::uint8_t pin_;
+
+  public:
+    using ValueType = typename Format::ValueType;
+
+    static constexpr auto MAX_VALUE = static_cast<std::uint32_t>(ANALOG_MAX);
+
+    explicit AnalogFixedPointSimpleSensor(const std::uint8_t pin) : pin_(pin)
+    {
+    }
+
+    void init() override
+    {
+        pinMode(this->pin_, INPUT);
+    }
+
+    inline auto getValue() -> ValueType override
+    {
+        const std::uint16_t raw = analogRead(this->pin_);
+        return Format::template fromRaw<MAX_VALUE>(raw);
+    }
+};
 } // namespace SenseShift::Arduino::Input
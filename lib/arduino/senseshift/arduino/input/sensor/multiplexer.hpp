@@ -12,6 +12,7 @@
 
 #include <senseshift/core/component.hpp>
 #include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor/multiplexer_scanner.hpp>
 
 namespace SenseShift::Arduino::Input {
 template<size_t N>
@@ -27,10 +28,12 @@ class Multiplexer {
     {
         for (const auto pin : this->pins_) {
             pinMode(pin, OUTPUT);
+            digitalWrite(pin, LOW);
         }
+        this->active_channel_ = 0;
     }
 
-    /// Select the channel.
+    /// Select the channel. Only the select pins, that differ from the active channel, are written.
     /// \param channel The channel to select.
     void selectChannel(const std::uint8_t channel)
     {
@@ -38,8 +41,11 @@ class Multiplexer {
             return;
         }
 
+        const std::uint8_t changed = this->active_channel_ ^ channel;
         for (size_t i = 0; i < N; ++i) {
-            digitalWrite(this->pins_[i], (channel >> i) & 0b0001);
+            if ((changed >> i) & 0b0001) {
+                digitalWrite(this->pins_[i], (channel >> i) & 0b0001);
+            }
         }
 
         delayMicroseconds(this->switch_delay_us_);
@@ -56,6 +62,10 @@ class Multiplexer {
 using MUX_CD74HC4057Component = Multiplexer<4>;
 using MUX_74HC4051Component = Multiplexer<3>;
 
+/// Samples all channels of the multiplexer in one pass, instead of one channel per sensor tick.
+template<size_t N>
+using MultiplexerScanner = ::SenseShift::Input::MultiplexerScanner<Multiplexer<N>>;
+
 template<size_t N>
 class MultiplexedAnalogSensor : public AnalogSimpleSensor {
   public:
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Preferences.h>
+
+#include <senseshift/core/logging.hpp>
+#include <senseshift/input/calibration_store.hpp>
+
+namespace SenseShift::Arduino::Input {
+static const char* const TAG = "calibration.nvs";
+
+/// Calibration storage in the ESP32 NVS, through the Arduino Preferences.
+class PreferencesCalibrationStorage : public ::SenseShift::Input::Calibration::ICalibrationStorage {
+  public:
+    /// \param name_space NVS namespace, up to 15 characters.
+    /// \param key NVS key of the blob, up to 15 characters.
+    explicit PreferencesCalibrationStorage(const char* name_space = "ss_calib", const char* key = "blob") :
+      name_space_(name_space), key_(key)
+    {
+    }
+
+    auto read(std::uint8_t* buffer, const std::size_t capacity) -> std::size_t override
+    {
+        Preferences preferences;
+        if (!preferences.begin(this->name_space_, true)) {
+            // The namespace does not exist until the first write
+            return 0;
+        }
+
+        std::size_t length = 0;
+        if (preferences.isKey(this->key_)) {
+            length = preferences.getBytesLength(this->key_);
+            length = length <= capacity ? preferences.getBytes(this->key_, buffer, capacity) : 0;
+        }
+
+        preferences.end();
+        return length;
+    }
+
+    auto write(const std::uint8_t* buffer, const std::size_t length) -> bool override
+    {
+        Preferences preferences;
+        if (!preferences.begin(this->name_space_, false)) {
+            LOG_E(TAG, "Failed to open the NVS namespace %s", this->name_space_);
+            return false;
+        }
+
+        const auto written = preferences.putBytes(this->key_, buffer, length);
+        preferences.end();
+
+        if (written != length) {
+            LOG_E(TAG, "Failed to write %u bytes of calibration", static_cast<unsigned>(length));
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    const char* name_space_;
+    const char* key_;
+};
+} // namespace SenseShift::Arduino::Input
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include <senseshift/input/sensor/button.hpp>
+
+namespace SenseShift::Arduino::Input {
+/// Digital button, that records the level changes from the GPIO interrupt, instead of polling the pin on every tick.
+///
+/// The ticks only process the recorded edges (usually none), and short presses between the ticks are not missed.
+///
+/// \example
+/// \code
+/// auto* button = new InterruptButtonSensor(PIN_BUTTON_A, INPUT_PULLUP, LOW);
+/// button->addEventCallback([](ButtonEvent event) {
+///     if (event == ButtonEvent::LongPress) {
+///         startCalibration();
+///     }
+/// });
+/// \endcode
+class InterruptButtonSensor : public ::SenseShift::Input::EdgeButtonSensor<> {
+  public:
+    explicit InterruptButtonSensor(
+      const std::uint8_t pin,
+      const std::uint8_t mode = INPUT_PULLUP,
+      const std::uint8_t inverted = LOW,
+      const ::SenseShift::Input::ButtonTiming& timing = {}
+    ) :
+      EdgeButtonSensor(timing), pin_(pin), mode_(mode), inverted_(inverted)
+    {
+    }
+
+    ~InterruptButtonSensor() override
+    {
+        detachInterrupt(digitalPinToInterrupt(this->pin_));
+    }
+
+    void init() override
+    {
+        pinMode(this->pin_, this->mode_);
+
+        // The button may be already held on boot
+        this->injectLevel(this->read(), millis());
+        attachInterruptArg(digitalPinToInterrupt(this->pin_), &InterruptButtonSensor::handleInterrupt, this, CHANGE);
+    }
+
+    void tick() override
+    {
+        this->update(millis());
+    }
+
+  protected:
+    void onEdgesDropped(const std::uint32_t now_ms) override
+    {
+        this->injectLevel(this->read(), now_ms);
+    }
+
+  private:
+    std::uint8_t pin_;
+    std::uint8_t mode_;
+    std::uint8_t inverted_;
+
+    [[nodiscard]] auto read() const -> bool
+    {
+        return digitalRead(this->pin_) == this->inverted_;
+    }
+
+    static void IRAM_ATTR handleInterrupt(void* arg)
+    {
+        auto* self = static_cast<InterruptButtonSensor*>(arg);
+        // Bounces may be coalesced into a single interrupt, so the level is read, instead of toggled
+        self->pushEdge(self->read(), millis());
+    }
+};
+} // namespace SenseShift::Arduino::Input
@@ -320,27 +320,27 @@ inline void addTactGloveActuators(
     const auto& layout = (side == HandSide::Left) ? TactGloveLeftLayout : TactGloveRightLayout;
 
     if (thumb != nullptr) {
-        hapticBody->addTarget(std::get<0>(layout[0]), new FloatPlane({ { std::get<1>(layout[0]), thumb } }));
+        hapticBody->addTarget(std::get<0>(layout[0]), new FloatDensePlane({ { std::get<1>(layout[0]), thumb } }));
     }
 
     if (index != nullptr) {
-        hapticBody->addTarget(std::get<0>(layout[1]), new FloatPlane({ { std::get<1>(layout[1]), index } }));
+        hapticBody->addTarget(std::get<0>(layout[1]), new FloatDensePlane({ { std::get<1>(layout[1]), index } }));
     }
 
     if (middle != nullptr) {
-        hapticBody->addTarget(std::get<0>(layout[2]), new FloatPlane({ { std::get<1>(layout[2]), middle } }));
+        hapticBody->addTarget(std::get<0>(layout[2]), new FloatDensePlane({ { std::get<1>(layout[2]), middle } }));
     }
 
     if (ring != nullptr) {
-        hapticBody->addTarget(std::get<0>(layout[3]), new FloatPlane({ { std::get<1>(layout[3]), ring } }));
+        hapticBody->addTarget(std::get<0>(layout[3]), new FloatDensePlane({ { std::get<1>(layout[3]), ring } }));
     }
 
     if (little != nullptr) {
-        hapticBody->addTarget(std::get<0>(layout[4]), new FloatPlane({ { std::get<1>(layout[4]), little } }));
+        hapticBody->addTarget(std::get<0>(layout[4]), new FloatDensePlane({ { std::get<1>(layout[4]), little } }));
     }
 
     if (wrist != nullptr) {
-        hapticBody->addTarget(std::get<0>(layout[5]), new FloatPlane({ { std::get<1>(layout[5]), wrist } }));
+        hapticBody->addTarget(std::get<0>(layout[5]), new FloatDensePlane({ { std::get<1>(layout[5]), wrist } }));
     }
 }
 } // namespace SenseShift::BH
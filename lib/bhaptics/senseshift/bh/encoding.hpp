@@ -24,6 +24,8 @@ class Decoder {
     static constexpr size_t VEST_LAYOUT_SIZE = 40;
     static constexpr size_t VEST_PAYLOAD_SIZE = 20;
 
+    using VestPayload = std::array<std::uint8_t, VEST_PAYLOAD_SIZE>;
+
     template<size_t N>
     static void applyPlain(
       FloatBody* output,
@@ -41,16 +43,28 @@ class Decoder {
     }
 
     template<size_t N>
-    static void
-      applyPlain(FloatBody* output, std::string& value, const std::array<OutputLayout, N>& layout, const Effect effect)
+    static void applyPlain(
+      FloatBody* output,
+      const std::uint8_t* data,
+      const std::size_t length,
+      const std::array<OutputLayout, N>& layout,
+      const Effect effect
+    )
     {
         std::array<std::uint8_t, N> buf{};
-        std::size_t copyLength = std::min(value.size(), sizeof(buf));
-        std::memcpy(buf.data(), value.c_str(), copyLength);
+        std::size_t copyLength = std::min(length, sizeof(buf));
+        std::memcpy(buf.data(), data, copyLength);
 
         applyPlain(output, buf, layout, effect);
     }
 
+    template<size_t N>
+    static void
+      applyPlain(FloatBody* output, std::string& value, const std::array<OutputLayout, N>& layout, const Effect effect)
+    {
+        applyPlain(output, reinterpret_cast<const std::uint8_t*>(value.data()), value.size(), layout, effect);
+    }
+
     /**
      * Apply plain-encoded data to the output.
      */
@@ -74,19 +88,59 @@ class Decoder {
     template<size_t N>
     static void applyPlain(
       FloatBody* output,
-      std::string& value,
+      const std::uint8_t* data,
+      const std::size_t length,
       const std::array<Position, N>& layout,
       const Effect effect,
       const Target target
     )
     {
         std::array<std::uint8_t, N> buf{};
-        std::size_t copyLength = std::min(value.size(), sizeof(buf));
-        std::memcpy(buf.data(), value.c_str(), copyLength);
+        std::size_t copyLength = std::min(length, sizeof(buf));
+        std::memcpy(buf.data(), data, copyLength);
 
         applyPlain(output, buf, layout, effect, target);
     }
 
+    template<size_t N>
+    static void applyPlain(
+      FloatBody* output,
+      std::string& value,
+      const std::array<Position, N>& layout,
+      const Effect effect,
+      const Target target
+    )
+    {
+        applyPlain(output, reinterpret_cast<const std::uint8_t*>(value.data()), value.size(), layout, effect, target);
+    }
+
+    /**
+     * Apply plain-encoded data to the bound layout.
+     * Decodes the given bytes in place, missing bytes are treated as zeros.
+     */
+    template<size_t N>
+    static void
+      applyPlain(const FloatBody::LayoutBinding<N>& binding, const std::uint8_t* data, const std::size_t length)
+    {
+        for (size_t i = 0; i < N; i++) {
+            const std::uint8_t byte = i < length ? data[i] : 0;
+
+            binding.effect(i, static_cast<FloatBody::Plane::Value>(effectDataFromByte(byte)));
+        }
+    }
+
+    template<size_t N>
+    static void applyPlain(const FloatBody::LayoutBinding<N>& binding, const std::array<std::uint8_t, N>& value)
+    {
+        applyPlain(binding, value.data(), N);
+    }
+
+    template<size_t N>
+    static void applyPlain(const FloatBody::LayoutBinding<N>& binding, std::string& value)
+    {
+        applyPlain(binding, reinterpret_cast<const std::uint8_t*>(value.data()), value.size());
+    }
+
     /**
      * Apply vest-encoded data to the output.
      */
@@ -113,16 +167,55 @@ class Decoder {
         }
     }
 
-    static void
-      applyVest(FloatBody* output, std::string& value, const std::array<OutputLayout, VEST_LAYOUT_SIZE>& layout)
+    static void applyVest(
+      FloatBody* output,
+      const std::uint8_t* data,
+      const std::size_t length,
+      const std::array<OutputLayout, VEST_LAYOUT_SIZE>& layout
+    )
     {
         std::array<std::uint8_t, VEST_PAYLOAD_SIZE> buf{};
-        const size_t copyLength = std::min(value.size(), sizeof(buf));
-        std::memcpy(buf.data(), value.c_str(), copyLength);
+        const size_t copyLength = std::min(length, sizeof(buf));
+        std::memcpy(buf.data(), data, copyLength);
 
         applyVest(output, buf, layout);
     }
 
+    static void
+      applyVest(FloatBody* output, std::string& value, const std::array<OutputLayout, VEST_LAYOUT_SIZE>& layout)
+    {
+        applyVest(output, reinterpret_cast<const std::uint8_t*>(value.data()), value.size(), layout);
+    }
+
+    /**
+     * Apply vest-encoded data to the bound layout.
+     * Decodes the given bytes in place, missing bytes are treated as zeros.
+     */
+    static void applyVest(
+      const FloatBody::LayoutBinding<VEST_LAYOUT_SIZE>& binding, const std::uint8_t* data, const std::size_t length
+    )
+    {
+        for (size_t i = 0; i < VEST_PAYLOAD_SIZE; i++) {
+            const std::uint8_t byte = i < length ? data[i] : 0;
+            const size_t actIndex = i * 2;
+
+            binding.effect(actIndex, static_cast<FloatBody::Plane::Value>(effectDataFromByte(((byte >> 4) & 0xf), 15)));
+            binding.effect(actIndex + 1, static_cast<FloatBody::Plane::Value>(effectDataFromByte((byte & 0xf), 15)));
+        }
+    }
+
+    static void applyVest(
+      const FloatBody::LayoutBinding<VEST_LAYOUT_SIZE>& binding, const std::array<uint8_t, VEST_PAYLOAD_SIZE>& value
+    )
+    {
+        applyVest(binding, value.data(), VEST_PAYLOAD_SIZE);
+    }
+
+    static void applyVest(const FloatBody::LayoutBinding<VEST_LAYOUT_SIZE>& binding, std::string& value)
+    {
+        applyVest(binding, reinterpret_cast<const std::uint8_t*>(value.data()), value.size());
+    }
+
     /**
      * Apply grouped vest-encoded data to the output.
      */
@@ -181,18 +274,90 @@ class Decoder {
     template<size_t N>
     static void applyVestGrouped(
       FloatBody* output,
-      std::string& value,
+      const std::uint8_t* data,
+      const std::size_t length,
       const std::array<OutputLayout, VEST_LAYOUT_SIZE>& layout,
       const std::array<std::uint8_t, N>& layoutGroups
     )
     {
         std::array<std::uint8_t, VEST_PAYLOAD_SIZE> buf{};
-        const size_t copyLength = std::min(value.size(), sizeof(buf));
-        std::memcpy(buf.data(), value.c_str(), copyLength);
+        const size_t copyLength = std::min(length, sizeof(buf));
+        std::memcpy(buf.data(), data, copyLength);
 
         applyVestGrouped(output, buf, layout, layoutGroups);
     }
 
+    template<size_t N>
+    static void applyVestGrouped(
+      FloatBody* output,
+      std::string& value,
+      const std::array<OutputLayout, VEST_LAYOUT_SIZE>& layout,
+      const std::array<std::uint8_t, N>& layoutGroups
+    )
+    {
+        applyVestGrouped(
+          output,
+          reinterpret_cast<const std::uint8_t*>(value.data()),
+          value.size(),
+          layout,
+          layoutGroups
+        );
+    }
+
+    /**
+     * Apply grouped vest-encoded data to the bound layout.
+     */
+    template<size_t N>
+    static void applyVestGrouped(
+      const FloatBody::LayoutBinding<VEST_LAYOUT_SIZE>& binding,
+      const std::uint8_t* data,
+      const std::size_t length,
+      const std::array<std::uint8_t, N>& layoutGroups
+    )
+    {
+        std::array<std::uint8_t, VEST_LAYOUT_SIZE> result{};
+
+        // Unpack values, missing bytes are treated as zeros
+        for (size_t i = 0; i < VEST_PAYLOAD_SIZE; i++) {
+            const std::uint8_t byte = i < length ? data[i] : 0;
+            const size_t actIndex = i * 2;
+
+            result[actIndex] = (byte >> 4) & 0xf;
+            result[actIndex + 1] = (byte & 0xf);
+        }
+
+        // Only the group leaders are bound to the actuators, they take the max value of their group
+        for (size_t i = 0; i < N; i++) {
+            const auto groupIndex = layoutGroups[i];
+
+            const auto maxValue = (groupIndex % 10 >= 4)
+                                    ? std::max({ result[groupIndex], result[groupIndex + 2], result[groupIndex + 4] })
+                                    : std::max({ result[groupIndex], result[groupIndex + 2] });
+
+            binding.effect(groupIndex, static_cast<FloatBody::Plane::Value>(effectDataFromByte(maxValue, 15)));
+        }
+    }
+
+    template<size_t N>
+    static void applyVestGrouped(
+      const FloatBody::LayoutBinding<VEST_LAYOUT_SIZE>& binding,
+      const std::array<std::uint8_t, VEST_PAYLOAD_SIZE>& value,
+      const std::array<std::uint8_t, N>& layoutGroups
+    )
+    {
+        applyVestGrouped(binding, value.data(), VEST_PAYLOAD_SIZE, layoutGroups);
+    }
+
+    template<size_t N>
+    static void applyVestGrouped(
+      const FloatBody::LayoutBinding<VEST_LAYOUT_SIZE>& binding,
+      std::string& value,
+      const std::array<std::uint8_t, N>& layoutGroups
+    )
+    {
+        applyVestGrouped(binding, reinterpret_cast<const std::uint8_t*>(value.data()), value.size(), layoutGroups);
+    }
+
   private:
     static auto effectDataFromByte(const uint8_t byte, const uint8_t maxValue = 100) -> VibroEffectData
     {
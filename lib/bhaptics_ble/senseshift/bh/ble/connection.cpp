@@ -107,10 +107,13 @@ class MotorCharCallbacks : public BLECharacteristicCallbacks {
 
     void onWrite(BLECharacteristic* pCharacteristic) override
     {
-        auto value = pCharacteristic->getValue();
-        std::string valueStr(value.begin(), value.end());
-
-        this->motorTransformer(valueStr);
+#if defined(SS_USE_NIMBLE) && SS_USE_NIMBLE == true
+        const auto value = pCharacteristic->getValue();
+        this->motorTransformer(reinterpret_cast<const std::uint8_t*>(value.data()), value.length());
+#else
+        // Pass the characteristic buffer as is, without copying it
+        this->motorTransformer(pCharacteristic->getData(), pCharacteristic->getLength());
+#endif
     }
 };
 
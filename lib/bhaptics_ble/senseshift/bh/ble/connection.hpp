@@ -7,6 +7,9 @@
 #include <senseshift/events.hpp>
 #include <senseshift/utility.hpp>
 
+#include <cstddef>
+#include <cstdint>
+
 #include <Arduino.h>
 #include <esp_wifi.h>
 
@@ -40,7 +43,9 @@ static ConnectionCallbacks defaultCallback;
 
 class Connection final : public IEventListener {
   public:
-    using MotorHandler = std::function<void(std::string&)>;
+    /// Handles the value, written into the motor characteristic.
+    /// The data is only valid for the duration of the call, and must not be retained.
+    using MotorHandler = std::function<void(const std::uint8_t* data, std::size_t length)>;
 
     Connection(const ConnectionConfig& config, MotorHandler motorHandler, IEventDispatcher* eventDispatcher) :
       config(config), motorHandler(motorHandler), eventDispatcher(eventDispatcher)
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef SS_DELEGATE_CAPACITY
+#define SS_DELEGATE_CAPACITY (2 * sizeof(void*))
+#endif
+
+namespace SenseShift {
+template<typename Signature, std::size_t Capacity = SS_DELEGATE_CAPACITY>
+class InlineDelegate;
+
+/// Callable wrapper like `std::function`, that stores the callable inline and never allocates.
+///
+/// The callable (e.g. lambda with its captures) must fit \p Capacity bytes, it is checked at compile time. Calling
+/// goes through a single function pointer. Trivially copyable callables (function pointers, lambdas capturing
+/// pointers or references) are copied as plain bytes.
+///
+/// \tparam Capacity Size of the inline storage, in bytes. Two pointers by default, enough for `[this]` and a pointer.
+///
+/// \example
+/// \code
+/// InlineDelegate<void(float)> delegate = [this](float value) { this->handle(value); };
+/// delegate(0.5F);
+/// \endcode
+template<typename R, typename... Args, std::size_t Capacity>
+class InlineDelegate<R(Args...), Capacity> {
+  public:
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    InlineDelegate() = default;
+
+    template<
+      typename Fn,
+      typename Callable = std::decay_t<Fn>,
+      typename = std::enable_if_t<
+        !std::is_same_v<Callable, InlineDelegate> && std::is_invocable_r_v<R, Callable&, Args...>>>
+    InlineDelegate(Fn&& fn) // NOLINT(google-explicit-constructor): implicit, same as std::function
+    {
+        static_assert(sizeof(Callable) <= Capacity, "Callable does not fit the delegate, capture less or increase it");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>, "Callable must be nothrow move constructible");
+
+        new (this->storage_) Callable(std::forward<Fn>(fn));
+        this->invoke_ = &invoke<Callable>;
+        if constexpr (!std::is_trivially_copyable_v<Callable> || !std::is_trivially_destructible_v<Callable>) {
+            this->manage_ = &manage<Callable>;
+        }
+    }
+
+    InlineDelegate(const InlineDelegate& other)
+    {
+        this->copyFrom(other);
+    }
+
+    InlineDelegate(InlineDelegate&& other) noexcept
+    {
+        this->moveFrom(other);
+    }
+
+    auto operator=(const InlineDelegate& other) -> InlineDelegate&
+    {
+        if (this != &other) {
+            this->reset();
+            this->copyFrom(other);
+        }
+        return *this;
+    }
+
+    auto operator=(InlineDelegate&& other) noexcept -> InlineDelegate&
+    {
+        if (this != &other) {
+            this->reset();
+            this->moveFrom(other);
+        }
+        return *this;
+    }
+
+    ~InlineDelegate()
+    {
+        this->reset();
+    }
+
+    /// Call the stored callable. Must not be empty.
+    auto operator()(Args... args) const -> R
+    {
+        return this->invoke_(this->storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const
+    {
+        return this->invoke_ != nullptr;
+    }
+
+    void reset()
+    {
+        if (this->manage_ != nullptr) {
+            this->manage_(Operation::Destroy, this->storage_, nullptr);
+        }
+        this->invoke_ = nullptr;
+        this->manage_ = nullptr;
+    }
+
+  private:
+    enum class Operation {
+        Copy,
+        Move,
+        Destroy,
+    };
+
+    using InvokeFn = R (*)(void*, Args&&...);
+    using ManageFn = void (*)(Operation, void*, void*);
+
+    /// Mutable, the same as in `std::function`, the callable may change its state when called.
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity]{};
+    InvokeFn invoke_ = nullptr;
+    /// Null for the trivially copyable callables.
+    ManageFn manage_ = nullptr;
+
+    template<typename Callable>
+    static auto invoke(void* storage, Args&&... args) -> R
+    {
+        return (*std::launder(reinterpret_cast<Callable*>(storage)))(std::forward<Args>(args)...);
+    }
+
+    template<typename Callable>
+    static void manage(const Operation operation, void* destination, void* source)
+    {
+        switch (operation) {
+            case Operation::Copy:
+                new (destination) Callable(*std::launder(reinterpret_cast<const Callable*>(source)));
+                break;
+            case Operation::Move:
+                new (destination) Callable(std::move(*std::launder(reinterpret_cast<Callable*>(source))));
+                std::launder(reinterpret_cast<Callable*>(source))->~Callable();
+                break;
+            case Operation::Destroy:
+                std::launder(reinterpret_cast<Callable*>(destination))->~Callable();
+                break;
+        }
+    }
+
+    void copyFrom(const InlineDelegate& other)
+    {
+        if (other.manage_ != nullptr) {
+            other.manage_(Operation::Copy, this->storage_, other.storage_);
+        } else {
+            std::memcpy(this->storage_, other.storage_, Capacity);
+        }
+        this->invoke_ = other.invoke_;
+        this->manage_ = other.manage_;
+    }
+
+    void moveFrom(InlineDelegate& other)
+    {
+        if (other.manage_ != nullptr) {
+            other.manage_(Operation::Move, this->storage_, other.storage_);
+        } else {
+            std::memcpy(this->storage_, other.storage_, Capacity);
+        }
+        this->invoke_ = other.invoke_;
+        this->manage_ = other.manage_;
+
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+};
+} // namespace SenseShift
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <senseshift/core/delegate.hpp>
 #include <senseshift/core/logging.hpp>
 
 namespace SenseShift {
@@ -139,4 +143,58 @@ class CallbackManager<void(Ts...)> {
   private:
     std::vector<CallbackType> callbacks_;
 };
+
+template<std::size_t N, typename... X>
+class StaticCallbackManager;
+
+/// Allocation-free variant of the CallbackManager, for the hot paths (e.g. sensor state publishing).
+///
+/// Holds up to \p N callbacks, each stored inline (see InlineDelegate), so neither adding nor calling them touches
+/// the heap.
+///
+/// \tparam N Max number of the callbacks.
+/// \tparam Ts The arguments for the callbacks, wrapped in void().
+template<std::size_t N, typename... Ts>
+class StaticCallbackManager<N, void(Ts...)> {
+  public:
+    using CallbackType = InlineDelegate<void(Ts...)>;
+
+    static constexpr std::size_t CAPACITY = N;
+
+    /// Add a callback to the list.
+    ///
+    /// \return False, if the list is full and the callback was not added.
+    auto add(CallbackType&& callback) -> bool
+    {
+        if (this->size_ >= N) {
+            return false;
+        }
+
+        this->callbacks_[this->size_++] = std::move(callback);
+        return true;
+    }
+
+    /// Call all callbacks in this manager.
+    void call(Ts... args) const
+    {
+        for (std::size_t i = 0; i < this->size_; i++) {
+            this->callbacks_[i](args...);
+        }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->size_;
+    }
+
+    /// Call all callbacks in this manager.
+    void operator()(Ts... args) const
+    {
+        this->call(args...);
+    }
+
+  private:
+    std::array<CallbackType, N> callbacks_{};
+    std::size_t size_ = 0;
+};
 } // namespace SenseShift
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace SenseShift {
+/// Lock-free single-producer/single-consumer mailbox, that holds only the latest published value.
+///
+/// Backed by a triple buffer: the producer and the consumer always own one buffer each, and exchange the third one
+/// atomically. Publishing never blocks and never waits for the consumer, values that were not consumed in time are
+/// overwritten (merged) by the newer ones.
+///
+/// \tparam Tp The type of the value. Copied into the mailbox on publish.
+///
+/// \example
+/// \code
+/// LatestValueMailbox<std::array<std::uint8_t, 20>> mailbox;
+///
+/// // Producer (e.g. BLE callback)
+/// mailbox.publish(packet);
+///
+/// // Consumer (e.g. output task)
+/// if (const auto* packet = mailbox.consume()) {
+///     apply(*packet);
+/// }
+/// \endcode
+template<typename Tp>
+class LatestValueMailbox {
+  public:
+    using ValueType = Tp;
+
+    /// Publish the new value. Must be called from the producer side only.
+    void publish(const ValueType& value)
+    {
+        this->buffers_[this->back_] = value;
+
+        const auto previous = this->middle_.exchange(this->back_ | FRESH_FLAG, std::memory_order_acq_rel);
+        this->back_ = previous & INDEX_MASK;
+
+        if ((previous & FRESH_FLAG) != 0) {
+            this->overwritten_.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Take the latest published value, if there is a new one. Must be called from the consumer side only.
+    ///
+    /// \return Pointer to the value, valid until the next consume() call, or nullptr if nothing new was published.
+    [[nodiscard]] auto consume() -> const ValueType*
+    {
+        if ((this->middle_.load(std::memory_order_acquire) & FRESH_FLAG) == 0) {
+            return nullptr;
+        }
+
+        const auto previous = this->middle_.exchange(this->front_, std::memory_order_acq_rel);
+        this->front_ = previous & INDEX_MASK;
+
+        return &this->buffers_[this->front_];
+    }
+
+    /// Whether there is a value, that was not consumed yet.
+    [[nodiscard]] auto hasPending() const -> bool
+    {
+        return (this->middle_.load(std::memory_order_acquire) & FRESH_FLAG) != 0;
+    }
+
+    /// Total number of published values.
+    [[nodiscard]] auto getPublishedCount() const -> std::uint32_t
+    {
+        return this->published_.load(std::memory_order_relaxed);
+    }
+
+    /// Number of values, that were overwritten before the consumer took them.
+    [[nodiscard]] auto getOverwrittenCount() const -> std::uint32_t
+    {
+        return this->overwritten_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr std::uint8_t INDEX_MASK = 0b0011;
+    static constexpr std::uint8_t FRESH_FLAG = 0b0100;
+
+    std::array<ValueType, 3> buffers_{};
+
+    /// Owned by the producer.
+    std::uint8_t back_ = 0;
+    /// Shared buffer index, with the "fresh" flag.
+    std::atomic<std::uint8_t> middle_{ 1 };
+    /// Owned by the consumer.
+    std::uint8_t front_ = 2;
+
+    std::atomic<std::uint32_t> published_{ 0 };
+    std::atomic<std::uint32_t> overwritten_{ 0 };
+};
+} // namespace SenseShift
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <senseshift/core/mailbox.hpp>
+
+namespace SenseShift {
+/// Worker thread, that handles the latest value, published into its mailbox.
+///
+/// std::thread-based counterpart of FreeRTOS::MailboxTask, for the platforms without FreeRTOS (e.g. native tests).
+/// The mailbox itself stays lock-free, the mutex is only used to park the idle thread.
+///
+/// \tparam Tp The type of the value.
+template<typename Tp>
+class ThreadMailboxWorker {
+  public:
+    using ValueType = Tp;
+    using Handler = std::function<void(const ValueType&)>;
+
+    explicit ThreadMailboxWorker(Handler handler) : handler_(std::move(handler))
+    {
+    }
+
+    ~ThreadMailboxWorker()
+    {
+        this->stop();
+    }
+
+    ThreadMailboxWorker(const ThreadMailboxWorker&) = delete;
+    auto operator=(const ThreadMailboxWorker&) -> ThreadMailboxWorker& = delete;
+
+    void begin()
+    {
+        this->running_ = true;
+        this->thread_ = std::thread([this] { this->run(); });
+    }
+
+    /// Stop the worker, after it handles the pending value.
+    void stop()
+    {
+        if (!this->thread_.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->running_ = false;
+        }
+        this->wakeup_.notify_one();
+        this->thread_.join();
+    }
+
+    /// Publish the value and wake the worker up. Must be called from a single producer thread.
+    void publish(const ValueType& value)
+    {
+        this->mailbox_.publish(value);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->notified_ = true;
+        }
+        this->wakeup_.notify_one();
+    }
+
+    [[nodiscard]] auto getMailbox() const -> const LatestValueMailbox<ValueType>&
+    {
+        return this->mailbox_;
+    }
+
+  private:
+    Handler handler_;
+    LatestValueMailbox<ValueType> mailbox_{};
+
+    std::thread thread_{};
+    std::mutex mutex_{};
+    std::condition_variable wakeup_{};
+    bool notified_ = false;
+    bool running_ = false;
+
+    void run()
+    {
+        while (true) {
+            bool running;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex_);
+                this->wakeup_.wait(lock, [this] { return this->notified_ || !this->running_; });
+                this->notified_ = false;
+                running = this->running_;
+            }
+
+            while (const auto* value = this->mailbox_.consume()) {
+                this->handler_(*value);
+            }
+
+            if (!running) {
+                return;
+            }
+        }
+    }
+};
+} // namespace SenseShift
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+
+namespace SenseShift {
+/// Timing statistics of a periodic task. Times are in microseconds.
+struct PeriodicStats {
+    /// Number of the started ticks.
+    std::uint32_t ticks = 0;
+    /// Number of the ticks, that finished after the next one was due.
+    std::uint32_t overruns = 0;
+    /// Number of the periods, that were skipped entirely, as the task was too far behind.
+    std::uint32_t skipped = 0;
+    /// Number of the ticks, that started before their deadline. Must stay 0, unless the sleep returns early.
+    std::uint32_t early = 0;
+    /// How late the last tick started, relative to its deadline.
+    std::uint32_t last_lateness = 0;
+    /// How late the latest started tick was.
+    std::uint32_t max_lateness = 0;
+    /// Sum of the lateness of all the ticks, for the mean.
+    std::uint64_t total_lateness = 0;
+
+    [[nodiscard]] auto getMeanLateness() const -> std::uint32_t
+    {
+        return this->ticks == 0 ? 0 : static_cast<std::uint32_t>(this->total_lateness / this->ticks);
+    }
+};
+
+/// Computes the absolute wake times of a periodic task, so the period never drifts, regardless of the tick duration
+/// and the wake-up latency.
+///
+/// A tick, that overruns its period, is followed by the next one immediately. If the task falls behind by more than
+/// a whole period, the missed periods are skipped instead of running them in a burst, keeping the original phase.
+///
+/// The scheduler is platform-agnostic: the caller provides the current time, and sleeps until the returned deadline.
+///
+/// \example
+/// \code
+/// PeriodicScheduler scheduler(11111); // 90 Hz
+/// scheduler.reset(now_us());
+///
+/// while (true) {
+///     scheduler.tickStarted(now_us());
+///     tick();
+///     sleep_until_us(scheduler.tickFinished(now_us()));
+/// }
+/// \endcode
+class PeriodicScheduler {
+  public:
+    /// Monotonic time, in microseconds.
+    using TimePoint = std::uint64_t;
+
+    explicit PeriodicScheduler(const std::uint32_t period_us) : period_(period_us > 0 ? period_us : 1)
+    {
+    }
+
+    /// Make the first tick due at \p now.
+    void reset(const TimePoint now)
+    {
+        this->deadline_ = now;
+        this->stats_ = {};
+    }
+
+    /// Record the start of the tick.
+    void tickStarted(const TimePoint now)
+    {
+        const auto lateness = now > this->deadline_ ? static_cast<std::uint32_t>(now - this->deadline_) : 0;
+
+        this->stats_.ticks++;
+        if (now < this->deadline_) {
+            this->stats_.early++;
+        }
+        this->stats_.last_lateness = lateness;
+        this->stats_.total_lateness += lateness;
+        if (lateness > this->stats_.max_lateness) {
+            this->stats_.max_lateness = lateness;
+        }
+    }
+
+    /// Schedule the next tick, after the current one has finished.
+    ///
+    /// \return The absolute time, at which the next tick is due. May be in the past, if the task is late.
+    auto tickFinished(const TimePoint now) -> TimePoint
+    {
+        this->deadline_ += this->period_;
+
+        if (now > this->deadline_) {
+            this->stats_.overruns++;
+
+            const auto behind = (now - this->deadline_) / this->period_;
+            if (behind > 0) {
+                this->stats_.skipped += static_cast<std::uint32_t>(behind);
+                this->deadline_ += behind * this->period_;
+            }
+        }
+
+        return this->deadline_;
+    }
+
+    /// Time left until the next tick is due, 0 if it is already due.
+    [[nodiscard]] auto getWaitTime(const TimePoint now) const -> std::uint32_t
+    {
+        return this->deadline_ > now ? static_cast<std::uint32_t>(this->deadline_ - now) : 0;
+    }
+
+    [[nodiscard]] auto getPeriod() const -> std::uint32_t
+    {
+        return this->period_;
+    }
+
+    [[nodiscard]] auto getDeadline() const -> TimePoint
+    {
+        return this->deadline_;
+    }
+
+    [[nodiscard]] auto getStats() const -> const PeriodicStats&
+    {
+        return this->stats_;
+    }
+
+  private:
+    std::uint32_t period_;
+    TimePoint deadline_ = 0;
+    PeriodicStats stats_{};
+};
+} // namespace SenseShift
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <senseshift/core/periodic.hpp>
+
+namespace SenseShift {
+/// Worker thread, that calls the handler with a fixed period, using absolute wake times.
+///
+/// std::chrono-based counterpart of FreeRTOS::ComponentUpdateTask, for the platforms without FreeRTOS (e.g. native
+/// tests).
+class ThreadPeriodicWorker {
+  public:
+    using Handler = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    ThreadPeriodicWorker(Handler handler, const std::chrono::microseconds period) :
+      handler_(std::move(handler)), scheduler_(static_cast<std::uint32_t>(period.count()))
+    {
+    }
+
+    ~ThreadPeriodicWorker()
+    {
+        this->stop();
+    }
+
+    ThreadPeriodicWorker(const ThreadPeriodicWorker&) = delete;
+    auto operator=(const ThreadPeriodicWorker&) -> ThreadPeriodicWorker& = delete;
+
+    void begin()
+    {
+        this->running_ = true;
+        this->thread_ = std::thread([this] { this->run(); });
+    }
+
+    /// Stop the worker, after it finishes the current tick.
+    void stop()
+    {
+        if (!this->thread_.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->running_ = false;
+        }
+        this->wakeup_.notify_one();
+        this->thread_.join();
+    }
+
+    /// Timing statistics. Only consistent after the worker is stopped.
+    [[nodiscard]] auto getStats() const -> const PeriodicStats&
+    {
+        return this->scheduler_.getStats();
+    }
+
+  private:
+    Handler handler_;
+    PeriodicScheduler scheduler_;
+
+    std::thread thread_{};
+    std::mutex mutex_{};
+    std::condition_variable wakeup_{};
+    bool running_ = false;
+
+    static auto now() -> PeriodicScheduler::TimePoint
+    {
+        const auto elapsed = Clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+    void run()
+    {
+        this->scheduler_.reset(now());
+
+        while (true) {
+            this->scheduler_.tickStarted(now());
+            this->handler_();
+            const auto deadline = this->scheduler_.tickFinished(now());
+
+            const auto wake = Clock::time_point(std::chrono::microseconds(deadline));
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            if (this->wakeup_.wait_until(lock, wake, [this] { return !this->running_; })) {
+                return;
+            }
+        }
+    }
+};
+} // namespace SenseShift
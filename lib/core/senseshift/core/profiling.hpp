@@ -0,0 +1,267 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#ifndef SS_PROFILING_ENABLED
+#define SS_PROFILING_ENABLED false
+#endif
+
+namespace SenseShift {
+/// Monotonic clock, in microseconds. Wraps around every ~71 minutes, durations are still correct across the wrap.
+struct SteadyMicrosClock {
+    static auto now() -> std::uint32_t
+    {
+        const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+};
+
+/// Percentiles of the recorded latencies, in microseconds.
+struct LatencySummary {
+    std::uint32_t count;
+    std::uint32_t min;
+    std::uint32_t p50;
+    std::uint32_t p99;
+    std::uint32_t max;
+};
+
+/// Fixed-bucket latency histogram, never allocates.
+///
+/// Values below 8us get a bucket each, the larger ones are split into 4 buckets per power of two, so the percentiles
+/// are within 25% of the real value. Values above ~1s share the last bucket. Min and max are exact.
+class LatencyHistogram {
+  public:
+    static constexpr std::size_t SUB_BUCKETS = 4;
+    static constexpr std::size_t LINEAR_BUCKETS = 8;
+    /// Highest power of two with its own buckets: 2^20us, about a second.
+    static constexpr std::size_t MAX_OCTAVE = 20;
+    static constexpr std::size_t BUCKET_COUNT = LINEAR_BUCKETS + (MAX_OCTAVE - 3 + 1) * SUB_BUCKETS;
+
+    void record(const std::uint32_t value)
+    {
+        this->buckets_[bucketOf(value)]++;
+        this->count_++;
+
+        if (this->count_ == 1 || value < this->min_) {
+            this->min_ = value;
+        }
+        if (value > this->max_) {
+            this->max_ = value;
+        }
+    }
+
+    void reset()
+    {
+        this->buckets_.fill(0);
+        this->count_ = 0;
+        this->min_ = 0;
+        this->max_ = 0;
+    }
+
+    [[nodiscard]] auto count() const -> std::uint32_t
+    {
+        return this->count_;
+    }
+
+    [[nodiscard]] auto min() const -> std::uint32_t
+    {
+        return this->min_;
+    }
+
+    [[nodiscard]] auto max() const -> std::uint32_t
+    {
+        return this->max_;
+    }
+
+    /// Upper estimate of the \p quantile (between 0 and 1) of the recorded values, 0 if nothing was recorded.
+    [[nodiscard]] auto percentile(const float quantile) const -> std::uint32_t
+    {
+        if (this->count_ == 0) {
+            return 0;
+        }
+
+        auto target = static_cast<std::uint32_t>(quantile * static_cast<float>(this->count_) + 0.5F);
+        if (target < 1) {
+            target = 1;
+        }
+
+        std::uint32_t seen = 0;
+        for (std::size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            seen += this->buckets_[bucket];
+            if (seen >= target) {
+                const auto upper = upperBoundOf(bucket);
+                if (upper > this->max_) {
+                    return this->max_;
+                }
+                return upper < this->min_ ? this->min_ : upper;
+            }
+        }
+        return this->max_;
+    }
+
+    [[nodiscard]] auto summary() const -> LatencySummary
+    {
+        return { this->count_, this->min_, this->percentile(0.5F), this->percentile(0.99F), this->max_ };
+    }
+
+    [[nodiscard]] static constexpr auto bucketOf(const std::uint32_t value) -> std::size_t
+    {
+        if (value < LINEAR_BUCKETS) {
+            return value;
+        }
+
+        std::size_t octave = 31 - __builtin_clz(value);
+        if (octave > MAX_OCTAVE) {
+            return BUCKET_COUNT - 1;
+        }
+
+        const auto sub = (value >> (octave - 2)) & (SUB_BUCKETS - 1);
+        return LINEAR_BUCKETS + (octave - 3) * SUB_BUCKETS + sub;
+    }
+
+    /// Max value, that falls into the bucket.
+    [[nodiscard]] static constexpr auto upperBoundOf(const std::size_t bucket) -> std::uint32_t
+    {
+        if (bucket < LINEAR_BUCKETS) {
+            return bucket;
+        }
+
+        const auto octave = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + 3;
+        const auto sub = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+        const auto step = static_cast<std::uint32_t>(1) << (octave - 2);
+        return (static_cast<std::uint32_t>(1) << octave) + (sub + 1) * step - 1;
+    }
+
+  private:
+    std::array<std::uint32_t, BUCKET_COUNT> buckets_{};
+    std::uint32_t count_ = 0;
+    std::uint32_t min_ = 0;
+    std::uint32_t max_ = 0;
+};
+
+/// Records the duration of each stage of a repeated pipeline into its own histogram.
+///
+/// \tparam N The number of stages.
+/// \tparam Clock Must provide `static auto now() -> std::uint32_t`, in microseconds. Mock it to test time budgets.
+///
+/// \example
+/// \code
+/// StageTimer<2> timer;
+///
+/// timer.start();
+/// read();
+/// timer.lap(0);
+/// send();
+/// timer.lap(1);
+/// \endcode
+template<std::size_t N, typename Clock = SteadyMicrosClock>
+class StageTimer {
+  public:
+    static constexpr std::size_t STAGE_COUNT = N;
+
+    /// Start timing the first stage.
+    void start()
+    {
+        this->last_ = Clock::now();
+    }
+
+    /// Record the time since the previous lap (or start) into the \p stage, and start timing the next one.
+    void lap(const std::size_t stage)
+    {
+        const auto now = Clock::now();
+        if (stage < N) {
+            this->stages_[stage].record(now - this->last_);
+        }
+        this->last_ = now;
+    }
+
+    void reset()
+    {
+        for (auto& histogram : this->stages_) {
+            histogram.reset();
+        }
+    }
+
+    [[nodiscard]] auto getHistogram(const std::size_t stage) const -> const LatencyHistogram&
+    {
+        return this->stages_[stage];
+    }
+
+    /// Write the summary of every stage, one line per stage: `name n=<count> min=<us> p50=<us> p99=<us> max=<us>`.
+    ///
+    /// \return The length of the report, without the terminator. Truncated to fit the buffer.
+    auto format(char* buffer, const std::size_t length, const std::array<const char*, N>& names) const
+      -> std::size_t
+    {
+        if (length == 0) {
+            return 0;
+        }
+
+        std::size_t written = 0;
+        for (std::size_t stage = 0; stage < N && written + 1 < length; stage++) {
+            const auto summary = this->stages_[stage].summary();
+            const auto result = std::snprintf(
+              buffer + written,
+              length - written,
+              "%s n=%u min=%u p50=%u p99=%u max=%u\n",
+              names[stage],
+              static_cast<unsigned>(summary.count),
+              static_cast<unsigned>(summary.min),
+              static_cast<unsigned>(summary.p50),
+              static_cast<unsigned>(summary.p99),
+              static_cast<unsigned>(summary.max)
+            );
+            if (result < 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        return written < length ? written : length - 1;
+    }
+
+  private:
+    std::array<LatencyHistogram, N> stages_{};
+    std::uint32_t last_ = 0;
+};
+
+/// StageTimer with the same interface, that records nothing. Compiles to no code, and takes no memory for histograms.
+template<std::size_t N, typename Clock = SteadyMicrosClock>
+class NullStageTimer {
+  public:
+    static constexpr std::size_t STAGE_COUNT = N;
+
+    void start()
+    {
+    }
+
+    void lap(const std::size_t /*stage*/)
+    {
+    }
+
+    void reset()
+    {
+    }
+
+    auto format(char* buffer, const std::size_t length, const std::array<const char*, N>& /*names*/) const
+      -> std::size_t
+    {
+        if (length > 0) {
+            buffer[0] = '\0';
+        }
+        return 0;
+    }
+};
+
+/// Stage timer, that is compiled out unless SS_PROFILING_ENABLED is set.
+#if defined(SS_PROFILING_ENABLED) && SS_PROFILING_ENABLED == true
+template<std::size_t N, typename Clock = SteadyMicrosClock>
+using ProfilingStageTimer = StageTimer<N, Clock>;
+#else
+template<std::size_t N, typename Clock = SteadyMicrosClock>
+using ProfilingStageTimer = NullStageTimer<N, Clock>;
+#endif
+} // namespace SenseShift
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace SenseShift {
+/// Fixed-capacity FIFO, backed by a static array. Never allocates.
+///
+/// When full, pushing a new value overwrites the oldest one.
+///
+/// \tparam Tp The type of the stored values.
+/// \tparam N The capacity of the buffer.
+template<typename Tp, std::size_t N>
+class RingBuffer {
+    static_assert(N > 0, "RingBuffer capacity must be greater than 0");
+
+  public:
+    using ValueType = Tp;
+
+    /// Append the value to the end of the buffer, evicting the oldest value if the buffer is full.
+    void push(const ValueType& value)
+    {
+        this->buffer_[this->head_] = value;
+        this->head_ = next(this->head_);
+
+        if (this->size_ < N) {
+            this->size_++;
+        }
+    }
+
+    /// Remove the oldest value from the buffer.
+    void pop()
+    {
+        if (this->size_ > 0) {
+            this->size_--;
+        }
+    }
+
+    void clear()
+    {
+        this->head_ = 0;
+        this->size_ = 0;
+    }
+
+    /// Get the oldest value. Undefined if the buffer is empty.
+    [[nodiscard]] auto front() const -> const ValueType&
+    {
+        return (*this)[0];
+    }
+
+    /// Get the newest value. Undefined if the buffer is empty.
+    [[nodiscard]] auto back() const -> const ValueType&
+    {
+        return (*this)[this->size_ - 1];
+    }
+
+    /// Get the value by its age, 0 being the oldest.
+    [[nodiscard]] auto operator[](std::size_t index) const -> const ValueType&
+    {
+        return this->buffer_[(this->head_ + N - this->size_ + index) % N];
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->size_;
+    }
+
+    [[nodiscard]] static constexpr auto capacity() -> std::size_t
+    {
+        return N;
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return this->size_ == 0;
+    }
+
+    [[nodiscard]] auto full() const -> bool
+    {
+        return this->size_ == N;
+    }
+
+  private:
+    std::array<ValueType, N> buffer_{};
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+
+    static constexpr auto next(std::size_t index) -> std::size_t
+    {
+        return (index + 1) == N ? 0 : index + 1;
+    }
+};
+} // namespace SenseShift
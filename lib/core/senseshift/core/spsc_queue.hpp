@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SenseShift {
+/// Lock-free single-producer/single-consumer FIFO queue of a fixed capacity.
+///
+/// Unlike the LatestValueMailbox, every pushed value is kept in order, until the queue is full. Pushing never blocks
+/// and never allocates, so the producer may be an interrupt handler. Values, that do not fit, are dropped and counted.
+///
+/// \tparam Tp The type of the value. Copied into the queue on push.
+/// \tparam N The capacity, must be a power of two.
+///
+/// \example
+/// \code
+/// SpscQueue<Edge, 16> edges;
+///
+/// // Producer (e.g. GPIO interrupt)
+/// edges.push({ millis(), level });
+///
+/// // Consumer (e.g. sensor task)
+/// Edge edge;
+/// while (edges.pop(edge)) {
+///     handle(edge);
+/// }
+/// \endcode
+template<typename Tp, std::size_t N>
+class SpscQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    using ValueType = Tp;
+
+    /// Append the value. Must be called from the producer side only.
+    ///
+    /// \return False, if the queue is full and the value was dropped.
+    auto push(const ValueType& value) -> bool
+    {
+        const auto head = this->head_.load(std::memory_order_relaxed);
+        if (head - this->tail_.load(std::memory_order_acquire) >= N) {
+            this->dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        this->buffer_[head & MASK] = value;
+        this->head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Take the oldest value. Must be called from the consumer side only.
+    ///
+    /// \return False, if the queue is empty.
+    auto pop(ValueType& value) -> bool
+    {
+        const auto tail = this->tail_.load(std::memory_order_relaxed);
+        if (tail == this->head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = this->buffer_[tail & MASK];
+        this->tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Number of the queued values. Exact only on the consumer side.
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->head_.load(std::memory_order_acquire) - this->tail_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return this->size() == 0;
+    }
+
+    [[nodiscard]] static constexpr auto capacity() -> std::size_t
+    {
+        return N;
+    }
+
+    /// Number of the values, that were dropped because the queue was full.
+    [[nodiscard]] auto getDroppedCount() const -> std::uint32_t
+    {
+        return this->dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr std::uint32_t MASK = N - 1;
+
+    std::array<ValueType, N> buffer_{};
+
+    /// Free-running write position, owned by the producer.
+    std::atomic<std::uint32_t> head_{ 0 };
+    /// Free-running read position, owned by the consumer.
+    std::atomic<std::uint32_t> tail_{ 0 };
+
+    std::atomic<std::uint32_t> dropped_{ 0 };
+};
+} // namespace SenseShift
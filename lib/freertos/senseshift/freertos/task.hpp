@@ -1,10 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <type_traits>
 
 #include <senseshift/core/component.hpp>
 #include <senseshift/core/logging.hpp>
+#include <senseshift/core/mailbox.hpp>
+#include <senseshift/core/periodic.hpp>
 
 extern "C" void delay(uint32_t ms);
 
@@ -12,6 +16,7 @@ extern "C" void delay(uint32_t ms);
 #include <Arduino.h>
 #include <freertos/FreeRTOS.h> // Include the base FreeRTOS definitions.
 #include <freertos/task.h>     // Include the task definitions.
+#include <esp_timer.h>
 
 extern "C" {
 BaseType_t xTaskCreateUniversal(
@@ -110,7 +115,8 @@ class Task {
     }
 
   private:
-    const TaskConfig& taskConfig;
+    /// Copied, as the config is usually passed as a temporary, but it is only used in begin().
+    const TaskConfig taskConfig;
     TaskHandle_t taskHandle = nullptr;
 
     static void taskFunction(void* params)
@@ -120,18 +126,37 @@ class Task {
     }
 };
 
+/// Task, that ticks the component with a fixed period.
+///
+/// Wake times are absolute, so the period does not drift with the tick duration, and periods that are not a whole
+/// number of milliseconds average out exactly. The task sleeps in whole RTOS ticks until the deadline has passed, so
+/// a single tick may start up to one RTOS tick late, but never early (see getStats()).
 template<typename Tp>
 class ComponentUpdateTask : public Task<ComponentUpdateTask<Tp>> {
     static_assert(std::is_same_v<decltype(&Tp::init), void (Tp::*)()>);
     static_assert(std::is_same_v<decltype(&Tp::tick), void (Tp::*)()>);
 
   public:
+    /// \param updateDelay The period, in milliseconds.
     ComponentUpdateTask(Tp* component, std::uint32_t updateDelay, const TaskConfig& taskConfig) :
-      Task<ComponentUpdateTask<Tp>>(taskConfig), component_(component), updateDelay_(updateDelay)
+      ComponentUpdateTask(component, std::chrono::milliseconds(updateDelay), taskConfig)
+    {
+    }
+
+    ComponentUpdateTask(Tp* component, std::chrono::microseconds period, const TaskConfig& taskConfig) :
+      Task<ComponentUpdateTask<Tp>>(taskConfig),
+      component_(component),
+      scheduler_(static_cast<std::uint32_t>(period.count()))
     {
         log_i("creating ComponentUpdateTask: %s", taskConfig.name);
     }
 
+    /// Timing statistics of the task. Updated from the task itself, so the values may be one tick behind.
+    [[nodiscard]] auto getStats() const -> const PeriodicStats&
+    {
+        return this->scheduler_.getStats();
+    }
+
     void begin() override
     {
         this->component_->init();
@@ -141,18 +166,21 @@ class ComponentUpdateTask : public Task<ComponentUpdateTask<Tp>> {
   protected:
     [[noreturn]] void run()
     {
-        auto now = millis();
+        constexpr std::uint32_t tickPeriodUs = portTICK_PERIOD_MS * 1000;
 
-        while (true) {
-            now = millis();
+        this->scheduler_.reset(esp_timer_get_time());
 
+        while (true) {
+            this->scheduler_.tickStarted(esp_timer_get_time());
             this->component_->tick();
-
-            const auto elapsed = millis() - now;
-
-            log_d("T: %d, Fmax: %dHz, Ft: %dHz", elapsed, 1000 / elapsed, 1000 / this->updateDelay_);
-            if (elapsed < this->updateDelay_) {
-                delay(this->updateDelay_ - elapsed);
+            this->scheduler_.tickFinished(esp_timer_get_time());
+
+            // vTaskDelay(n) returns on the n-th tick interrupt, which may come up to a whole RTOS tick sooner than n
+            // periods, so the deadline is checked again after every wake-up
+            auto wait = this->scheduler_.getWaitTime(esp_timer_get_time());
+            while (wait > 0) {
+                vTaskDelay((wait + tickPeriodUs - 1) / tickPeriodUs);
+                wait = this->scheduler_.getWaitTime(esp_timer_get_time());
             }
         }
     }
@@ -161,6 +189,62 @@ class ComponentUpdateTask : public Task<ComponentUpdateTask<Tp>> {
     friend class Task<ComponentUpdateTask>;
 
     Tp* component_;
-    std::uint32_t updateDelay_;
+    PeriodicScheduler scheduler_;
+};
+
+/// Task, that handles the latest value, published into its mailbox.
+///
+/// Publishing never blocks: the value is put into the lock-free mailbox, and the task is woken up with a direct
+/// notification. Values, published while the task was busy, are merged, so only the latest one is handled. A value,
+/// published before begin(), is kept in the mailbox, and handled as soon as the task starts.
+///
+/// \tparam Tp The type of the value.
+template<typename Tp>
+class MailboxTask : public Task<MailboxTask<Tp>> {
+  public:
+    using ValueType = Tp;
+    using Handler = std::function<void(const ValueType&)>;
+
+    MailboxTask(Handler handler, const TaskConfig& taskConfig) :
+      Task<MailboxTask<Tp>>(taskConfig), handler_(std::move(handler))
+    {
+        log_i("creating MailboxTask: %s", taskConfig.name);
+    }
+
+    /// Publish the value and wake the task up. Must be called from a single producer task.
+    void publish(const ValueType& value)
+    {
+        this->mailbox_.publish(value);
+
+        // Not started yet: the value is picked up by the first pass of run()
+        auto* handle = this->getHandle();
+        if (handle != nullptr) {
+            xTaskNotifyGive(handle);
+        }
+    }
+
+    [[nodiscard]] auto getMailbox() const -> const LatestValueMailbox<ValueType>&
+    {
+        return this->mailbox_;
+    }
+
+  protected:
+    [[noreturn]] void run()
+    {
+        while (true) {
+            // Drained before the first wait too, as the notifications are lost until the task is created
+            while (const auto* value = this->mailbox_.consume()) {
+                this->handler_(*value);
+            }
+
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+
+  private:
+    friend class Task<MailboxTask>;
+
+    Handler handler_;
+    LatestValueMailbox<ValueType> mailbox_{};
 };
 } // namespace SenseShift::FreeRTOS
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <senseshift/core/component.hpp>
 #include <senseshift/input/sensor.hpp>
 #include <senseshift/input/sensor/analog_threshold.hpp>
@@ -40,6 +42,11 @@ class GrabGesture : public Gesture {
         });
     }
 
+    [[nodiscard]] auto getDependencies() -> std::vector<::SenseShift::Input::ISensorNode*> override
+    {
+        return { this->fingers_.index, this->fingers_.middle, this->fingers_.ring, this->fingers_.pinky };
+    }
+
     void tick()
     {
         if (this->attach_callbacks_) {
@@ -84,6 +91,11 @@ class PinchGesture : public Gesture {
         });
     }
 
+    [[nodiscard]] auto getDependencies() -> std::vector<::SenseShift::Input::ISensorNode*> override
+    {
+        return { this->fingers_.thumb, this->fingers_.index };
+    }
+
     void tick()
     {
         if (this->attach_callbacks_) {
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <senseshift/core/component.hpp>
+#include <senseshift/input/sensor.hpp>
+
+namespace SenseShift::Body::Hands::Input {
+/// Set of the fingers, a bit per finger.
+using FingerMask = std::uint8_t;
+
+inline constexpr FingerMask FINGER_MASK_THUMB = 1U << 0;
+inline constexpr FingerMask FINGER_MASK_INDEX = 1U << 1;
+inline constexpr FingerMask FINGER_MASK_MIDDLE = 1U << 2;
+inline constexpr FingerMask FINGER_MASK_RING = 1U << 3;
+inline constexpr FingerMask FINGER_MASK_PINKY = 1U << 4;
+
+/// State of all the gestures of the engine, a bit per gesture.
+using GestureMask = std::uint32_t;
+using GestureSensor = ::SenseShift::Input::Sensor<GestureMask>;
+
+/// Gesture, that is active while all of its fingers are curled.
+struct GestureDefinition {
+    /// Fingers, that must all be curled.
+    FingerMask fingers;
+    /// Curl, that all the fingers must reach, to activate the gesture.
+    float threshold_upper;
+    /// Curl, that any finger must drop below, to deactivate the gesture. Same as the upper one, for no hysteresis.
+    float threshold_lower;
+};
+
+/// Curl sensors of the fingers. Missing ones are null.
+struct HandFingers {
+    ::SenseShift::Input::FloatSensor* thumb;
+    ::SenseShift::Input::FloatSensor* index;
+    ::SenseShift::Input::FloatSensor* middle;
+    ::SenseShift::Input::FloatSensor* ring;
+    ::SenseShift::Input::FloatSensor* pinky;
+};
+
+/// Bits of the built-in gestures, in the engine created with defaultGestures().
+enum class HandGesture : std::uint8_t {
+    Trigger = 0,
+    Grab = 1,
+    Pinch = 2,
+};
+
+/// Definitions of the built-in gestures, in the order of HandGesture. The user-defined ones may follow them.
+constexpr auto defaultGestures(const float trigger_threshold, const float grab_threshold, const float pinch_threshold)
+  -> std::array<GestureDefinition, 3>
+{
+    return { {
+      { FINGER_MASK_INDEX, trigger_threshold, trigger_threshold },
+      { FINGER_MASK_INDEX | FINGER_MASK_MIDDLE | FINGER_MASK_RING | FINGER_MASK_PINKY, grab_threshold, grab_threshold },
+      { FINGER_MASK_THUMB | FINGER_MASK_INDEX, pinch_threshold, pinch_threshold },
+    } };
+}
+
+/// Evaluates all the gestures of the hand at once, and publishes them as a packed bitfield (bit N is gesture N).
+///
+/// The finger curls are read once per tick, instead of once per gesture. Every gesture is then a compare of the curls
+/// against its threshold (picked by its current state, for the hysteresis), and a test of the resulting finger mask
+/// against its own, without the branches. The gestures are the same as TriggerGesture, GrabGesture and PinchGesture,
+/// except that the threshold is inclusive, as in AnalogThresholdSensor.
+///
+/// A missing finger reads as not curled at all.
+///
+/// \tparam GestureCount Number of the gestures, up to 32.
+///
+/// \example
+/// \code
+/// constexpr auto defaults = defaultGestures(0.5F, 0.5F, 0.5F);
+/// // Built-in ones, and the "gun": index and middle extended, ring and pinky curled
+/// auto* gestures = new HandGestureEngine<4>(
+///   { .thumb = thumb, .index = index, .middle = middle, .ring = ring, .pinky = pinky },
+///   { { defaults[0], defaults[1], defaults[2], { FINGER_MASK_RING | FINGER_MASK_PINKY, 0.7F, 0.6F } } }
+/// );
+///
+/// const bool grab = gestures->isActive(static_cast<std::size_t>(HandGesture::Grab));
+/// \endcode
+template<std::size_t GestureCount>
+class HandGestureEngine : public GestureSensor {
+    static_assert(GestureCount > 0 && GestureCount <= sizeof(GestureMask) * 8, "Too many gestures for the mask");
+
+  public:
+    static constexpr std::size_t FINGER_COUNT = 5;
+
+    using Fingers = HandFingers;
+    using Gestures = std::array<GestureDefinition, GestureCount>;
+
+    HandGestureEngine(const Fingers& fingers, const Gestures& gestures) :
+      GestureSensor(0), fingers_({ fingers.thumb, fingers.index, fingers.middle, fingers.ring, fingers.pinky })
+    {
+        for (std::size_t i = 0; i < GestureCount; i++) {
+            this->masks_[i] = gestures[i].fingers;
+            this->thresholds_[0][i] = gestures[i].threshold_upper;
+            this->thresholds_[1][i] = gestures[i].threshold_lower;
+        }
+    }
+
+    void init() override
+    {
+        for (auto* finger : this->fingers_) {
+            SS_INIT_NOT_NULL(finger);
+        }
+    }
+
+    [[nodiscard]] auto getDependencies() -> std::vector<::SenseShift::Input::ISensorNode*> override
+    {
+        std::vector<::SenseShift::Input::ISensorNode*> dependencies{};
+        for (auto* finger : this->fingers_) {
+            if (finger != nullptr) {
+                dependencies.push_back(finger);
+            }
+        }
+        return dependencies;
+    }
+
+    void tick() override
+    {
+        std::array<float, FINGER_COUNT> curls{};
+        for (std::size_t i = 0; i < FINGER_COUNT; i++) {
+            curls[i] = this->fingers_[i] != nullptr ? this->fingers_[i]->getValue() : 0.0F;
+        }
+
+        this->publishState(this->evaluate(curls));
+    }
+
+    /// State of the gestures for the given curls (in the order of the fingers, thumb first), from the current one.
+    [[nodiscard]] auto evaluate(const std::array<float, FINGER_COUNT>& curls) -> GestureMask
+    {
+        const auto previous = this->getValue();
+        GestureMask state = 0;
+
+        // Gestures usually share the threshold, then the fingers are compared once for all of them
+        auto compared_threshold = std::numeric_limits<float>::quiet_NaN();
+        FingerMask curled = 0;
+
+        for (std::size_t i = 0; i < GestureCount; i++) {
+            // Indexed by the state, instead of a branch: the gestures flip unpredictably
+            const auto threshold = this->thresholds_[(previous >> i) & 1U][i];
+            if (threshold != compared_threshold) {
+                compared_threshold = threshold;
+                // Spelled out, so the shifts are constant
+                curled = static_cast<FingerMask>(
+                  static_cast<unsigned>(curls[0] >= threshold) | (static_cast<unsigned>(curls[1] >= threshold) << 1U)
+                  | (static_cast<unsigned>(curls[2] >= threshold) << 2U)
+                  | (static_cast<unsigned>(curls[3] >= threshold) << 3U)
+                  | (static_cast<unsigned>(curls[4] >= threshold) << 4U)
+                );
+            }
+
+            const auto mask = this->masks_[i];
+            state |= static_cast<GestureMask>((curled & mask) == mask) << i;
+        }
+
+        return state;
+    }
+
+    [[nodiscard]] auto isActive(const std::size_t gesture) -> bool
+    {
+        return ((this->getValue() >> gesture) & 1U) != 0;
+    }
+
+  private:
+    std::array<::SenseShift::Input::FloatSensor*, FINGER_COUNT> fingers_;
+
+    std::array<FingerMask, GestureCount> masks_{};
+    /// Upper thresholds (for the inactive gestures), then the lower ones (for the active).
+    std::array<std::array<float, GestureCount>, 2> thresholds_{};
+};
+} // namespace SenseShift::Body::Hands::Input
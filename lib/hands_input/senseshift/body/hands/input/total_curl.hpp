@@ -1,35 +1,77 @@
 #pragma once
 
-#include <functional>
-#include <utility>
+#include <array>
+#include <cstddef>
 #include <vector>
 
 #include <senseshift/core/component.hpp>
 #include <senseshift/input/sensor.hpp>
 
 namespace SenseShift::Body::Hands::Input {
+/// Joint of the finger, and its share in the total curl of the finger.
+struct CurlJoint {
+    ::SenseShift::Input::FloatSensor* sensor;
+    float weight = 1.0F;
+};
+
+/// Total curl of the finger, as the weighted average of its joint curls.
+///
+/// The joints are referenced, not copied: they are the same sensors, that are read, ticked and calibrated with the rest
+/// of the input. The weights are normalized once, so the average is a single multiply-add per joint.
+///
+/// \tparam JointCount Number of the joints.
+///
+/// \example
+/// \code
+/// auto* index_curl = new TotalCurl<3>({ {
+///   { index_mcp_sensor, 0.5F },
+///   { index_pip_sensor, 0.3F },
+///   { index_dip_sensor, 0.2F },
+/// } });
+/// \endcode
+template<std::size_t JointCount>
 class TotalCurl : public ::SenseShift::Input::FloatSensor {
+    static_assert(JointCount > 0, "Finger must have at least one joint");
+
   public:
-    /// \param joints The joints to calculate the total curl from.
+    using Joints = std::array<CurlJoint, JointCount>;
+
+    /// \param joints The joints to calculate the total curl from. Weights must not be negative, and are equal, if all
+    ///               of them are zero.
     /// \param attach_callbacks Whether to attach callbacks to the joints to update the total curl when they update.
-    ///                         If false, the total curl will only be recalculated when the tick() method is called.
+    ///                         If false, the total curl will only be recalculated when the tick() method is called,
+    ///                         e.g. by the SensorGraph, after the joints.
     ///                         Setting this to <b>true is not recommended</b>, as it will cause the total curl to
     ///                         be recalculated multiple times per tick (the same as number of joints).
-    explicit TotalCurl(std::vector<::SenseShift::Input::FloatSensor> joints, bool attach_callbacks = false) :
-      joints_(std::move(joints)), attach_callbacks_(attach_callbacks)
+    explicit TotalCurl(const Joints& joints, bool attach_callbacks = false) : attach_callbacks_(attach_callbacks)
     {
+        float total_weight = 0.0F;
+        for (const auto& joint : joints) {
+            total_weight += joint.weight;
+        }
+
+        for (std::size_t i = 0; i < JointCount; i++) {
+            this->joints_[i] = joints[i].sensor;
+            this->weights_[i] = total_weight > 0.0F ? joints[i].weight / total_weight
+                                                    : 1.0F / static_cast<float>(JointCount);
+        }
     }
 
     void init() override
     {
-        for (auto& joint : this->joints_) {
-            SS_SUBSENSOR_INIT(&joint, this->attach_callbacks_, [this](float /*value*/) {
+        for (auto* joint : this->joints_) {
+            SS_SUBSENSOR_INIT(joint, this->attach_callbacks_, [this](float /*value*/) {
                 this->recalculateState();
             });
         }
     }
 
-    void tick()
+    [[nodiscard]] auto getDependencies() -> std::vector<::SenseShift::Input::ISensorNode*> override
+    {
+        return { this->joints_.begin(), this->joints_.end() };
+    }
+
+    void tick() override
     {
         if (this->attach_callbacks_) {
             LOG_E("total_curl", "tick() called when attach_callbacks_ is true, infinite loop go wroom-wroom!");
@@ -41,17 +83,27 @@ class TotalCurl : public ::SenseShift::Input::FloatSensor {
     {
         float total = 0.0F;
 
-        for (auto& joint : this->joints_) {
-            total += joint.getValue();
+        for (std::size_t i = 0; i < JointCount; i++) {
+            total += this->joints_[i]->getValue() * this->weights_[i];
         }
 
-        if (!this->joints_.empty()) {
-            this->publishState(total / static_cast<float>(this->joints_.size()));
-        }
+        this->publishState(total);
+    }
+
+    [[nodiscard]] auto getJoint(const std::size_t index) const -> ::SenseShift::Input::FloatSensor*
+    {
+        return this->joints_[index];
+    }
+
+    /// Normalized weight of the joint: the weights of all the joints sum up to 1.
+    [[nodiscard]] auto getWeight(const std::size_t index) const -> float
+    {
+        return this->weights_[index];
     }
 
   private:
-    std::vector<::SenseShift::Input::FloatSensor> joints_;
+    std::array<::SenseShift::Input::FloatSensor*, JointCount> joints_{};
+    std::array<float, JointCount> weights_{};
 
     bool attach_callbacks_ = false;
 };
@@ -19,5 +19,22 @@ void OutputBody<Tp, Ta>::effect(const Target& target, const Position& pos, const
     plane.value()->effect(pos, val);
 }
 
+template<typename Tp, typename Ta>
+auto OutputBody<Tp, Ta>::getActuator(const Target& target, const Position& pos) -> typename Plane::Actuator*
+{
+    auto plane = this->getTarget(target);
+    if (!plane.has_value()) {
+        LOG_W(TAG, "No target found for layout: %d", target);
+        return nullptr;
+    }
+
+    auto* actuator = plane.value()->getActuator(pos);
+    if (actuator == nullptr) {
+        LOG_W(TAG, "No actuator for point (%u, %u) of target %d", pos.x, pos.y, target);
+    }
+
+    return actuator;
+}
+
 template class OutputBody<Position::Value, Output::IFloatOutput::ValueType>;
 } // namespace SenseShift::Body::Haptics
@@ -3,12 +3,57 @@
 #include "senseshift/body/haptics/interface.hpp"
 #include "senseshift/body/haptics/plane.hpp"
 
+#include <array>
+#include <cstddef>
 #include <map>
 #include <optional>
+#include <tuple>
 
 #include <senseshift/output/output.hpp>
 
 namespace SenseShift::Body::Haptics {
+/// Actuators of the body, resolved once for every index of the output layout.
+///
+/// Values are written straight into the actuators, without any target or position lookups. Such writes are not
+/// reflected in the actuator states of the planes.
+///
+/// \tparam To The type of the output value.
+/// \tparam N The size of the layout.
+template<typename To, std::size_t N>
+class OutputLayoutBinding {
+  public:
+    using Value = To;
+    using Actuator = Output::IOutput<Value>;
+
+    OutputLayoutBinding() = default;
+
+    explicit OutputLayoutBinding(const std::array<Actuator*, N>& actuators) : actuators_(actuators)
+    {
+    }
+
+    /// Write the value into the actuator at the given layout index, if it is bound.
+    void effect(std::size_t index, const Value& val) const
+    {
+        auto* actuator = this->actuators_[index];
+        if (actuator != nullptr) {
+            actuator->writeState(val);
+        }
+    }
+
+    [[nodiscard]] auto getActuator(std::size_t index) const -> Actuator*
+    {
+        return this->actuators_[index];
+    }
+
+    [[nodiscard]] static constexpr auto size() -> std::size_t
+    {
+        return N;
+    }
+
+  private:
+    std::array<Actuator*, N> actuators_{};
+};
+
 /// IOutput body, contains all the output planes.
 ///
 /// \tparam Tc The type of the coordinate.
@@ -17,9 +62,12 @@ template<typename Tc, typename To>
 class OutputBody {
   public:
     /// The type of the output plane for the given target.
-    using Plane = OutputPlane<Tc, To>;
+    using Plane = IOutputPlane<Tc, To>;
     /// The type of the target to output plane map (e.g. Chest -> OutputPlane).
     using TargetPlaneMap = std::map<Target, Plane*>;
+    /// The type of the layout, bound to the actuators of this body.
+    template<std::size_t N>
+    using LayoutBinding = OutputLayoutBinding<To, N>;
 
     OutputBody() = default;
 
@@ -47,6 +95,35 @@ class OutputBody {
 
     void effect(const Target& target, const Position& pos, const typename Plane::Value& val);
 
+    /// Get the actuator, that handles the given point of the target, or nullptr if there is none.
+    auto getActuator(const Target& target, const Position& pos) -> typename Plane::Actuator*;
+
+    /// Resolve every (target, position) pair of the layout into the actuator.
+    /// Must be called after all the targets are added.
+    template<std::size_t N>
+    auto bindLayout(const std::array<std::tuple<Target, Position>, N>& layout) -> LayoutBinding<N>
+    {
+        std::array<typename Plane::Actuator*, N> actuators{};
+        for (std::size_t i = 0; i < N; i++) {
+            actuators[i] = this->getActuator(std::get<0>(layout[i]), std::get<1>(layout[i]));
+        }
+
+        return LayoutBinding<N>(actuators);
+    }
+
+    /// Resolve every position of the layout on the single target into the actuator.
+    /// Must be called after all the targets are added.
+    template<std::size_t N>
+    auto bindLayout(const Target& target, const std::array<Position, N>& layout) -> LayoutBinding<N>
+    {
+        std::array<typename Plane::Actuator*, N> actuators{};
+        for (std::size_t i = 0; i < N; i++) {
+            actuators[i] = this->getActuator(target, layout[i]);
+        }
+
+        return LayoutBinding<N>(actuators);
+    }
+
     auto getTargets() const -> const TargetPlaneMap*
     {
         return &targets_;
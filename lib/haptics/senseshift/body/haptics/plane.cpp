@@ -2,6 +2,7 @@
 #include "senseshift/body/haptics/interface.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <map>
 
 #include <senseshift/core/logging.hpp>
@@ -50,33 +51,289 @@ void OutputPlane<Tc, To>::effect(const Position& pos, const Value& val)
     this->states_[pos] = val;
 }
 
+template<typename Tc, typename To>
+void OutputPlane<Tc, To>::enableChangeOnlyWrites(std::uint32_t maxDuty)
+{
+    for (auto& [point, actuator] : this->actuators_) {
+        if (actuator->skipsUnchangedWrites()) {
+            continue;
+        }
+
+        actuator = new Output::ChangeOnlyOutputDecorator(actuator, maxDuty, &this->write_counters_);
+    }
+}
+
+template<typename Tc, typename To>
+auto OutputPlane<Tc, To>::getActuator(const Position& pos) -> Actuator*
+{
+    auto find = this->actuators_.find(pos);
+    if (find == this->actuators_.end()) {
+        return nullptr;
+    }
+
+    return find->second;
+}
+
+/// Squared distance, exact for the 8-bit coordinates.
+template<typename Tc>
+static auto squaredDistance(const Math::Point2<Tc>& lhs, const Math::Point2<Tc>& rhs) -> int
+{
+    const int dx = static_cast<int>(lhs.x) - static_cast<int>(rhs.x);
+    const int dy = static_cast<int>(lhs.y) - static_cast<int>(rhs.y);
+    return dx * dx + dy * dy;
+}
+
+/// Squared distance from the point to the nearest and to the farthest point of the box.
+static void boxDistances(int x, int y, int min_x, int min_y, int max_x, int max_y, int& nearest, int& farthest)
+{
+    const int near_dx = x < min_x ? min_x - x : (x > max_x ? x - max_x : 0);
+    const int near_dy = y < min_y ? min_y - y : (y > max_y ? y - max_y : 0);
+    const int far_dx = std::max(x - min_x, max_x - x);
+    const int far_dy = std::max(y - min_y, max_y - y);
+
+    nearest = near_dx * near_dx + near_dy * near_dy;
+    farthest = far_dx * far_dx + far_dy * far_dy;
+}
+
+template<typename Tc, typename To>
+OutputPlane_Closest<Tc, To>::OutputPlane_Closest(
+  const typename OutputPlane<Tc, To>::ActuatorMap& actuators, std::uint8_t resolution
+) :
+  OutputPlane<Tc, To>(actuators), resolution_(std::min(resolution, MAX_RESOLUTION))
+{
+    const auto& points = *this->getAvailablePoints();
+    this->sorted_points_.assign(points.begin(), points.end());
+
+    if (this->sorted_points_.empty()) {
+        return;
+    }
+    if (this->sorted_points_.size() > std::numeric_limits<LookupIndex>::max() + 1U) {
+        LOG_W(
+          TAG,
+          "Too many actuators for the closest point lookup, using the linear search: %u",
+          static_cast<unsigned>(this->sorted_points_.size())
+        );
+        return;
+    }
+
+    const std::size_t grid_size = 1U << this->resolution_;
+    const int cell_size = (1 << MAX_RESOLUTION) >> this->resolution_;
+    this->lookup_.resize(grid_size * grid_size);
+
+    std::vector<int> nearest(this->sorted_points_.size());
+    std::vector<LookupIndex> cell_candidates{};
+    cell_candidates.reserve(this->sorted_points_.size());
+    // neighbouring cells along the same edge of the diagram usually share the candidates
+    std::map<std::vector<LookupIndex>, LookupCell> shared_offsets{};
+
+    for (std::size_t cell_y = 0; cell_y < grid_size; cell_y++) {
+        for (std::size_t cell_x = 0; cell_x < grid_size; cell_x++) {
+            const int min_x = static_cast<int>(cell_x) * cell_size;
+            const int min_y = static_cast<int>(cell_y) * cell_size;
+            const int max_x = min_x + cell_size - 1;
+            const int max_y = min_y + cell_size - 1;
+
+            // every point of the cell is at most `bound` away from some actuator, so no actuator, that is farther
+            // away from the whole cell, can be the closest one
+            int bound = std::numeric_limits<int>::max();
+            for (std::size_t i = 0; i < this->sorted_points_.size(); i++) {
+                int farthest = 0;
+                const auto& point = this->sorted_points_[i];
+                boxDistances(point.x, point.y, min_x, min_y, max_x, max_y, nearest[i], farthest);
+                bound = std::min(bound, farthest);
+            }
+
+            cell_candidates.clear();
+            for (std::size_t i = 0; i < this->sorted_points_.size(); i++) {
+                if (nearest[i] <= bound) {
+                    cell_candidates.push_back(static_cast<LookupIndex>(i));
+                }
+            }
+
+            auto& cell = this->lookup_[cell_y * grid_size + cell_x];
+            if (cell_candidates.size() == 1) {
+                cell = cell_candidates.front();
+                continue;
+            }
+
+            const auto find = shared_offsets.find(cell_candidates);
+            if (find != shared_offsets.end()) {
+                cell = find->second;
+                continue;
+            }
+
+            if (this->candidates_.size() >= SHARED_CELL) {
+                LOG_W(TAG, "Too many shared cells for the closest point lookup, using the linear search");
+                this->lookup_.clear();
+                this->lookup_.shrink_to_fit();
+                this->candidates_.clear();
+                this->candidates_.shrink_to_fit();
+                return;
+            }
+
+            cell = static_cast<LookupCell>(SHARED_CELL | this->candidates_.size());
+            shared_offsets.emplace(cell_candidates, cell);
+
+            // at most 256 candidates, stored as count - 1
+            this->candidates_.push_back(static_cast<LookupIndex>(cell_candidates.size() - 1));
+            this->candidates_.insert(this->candidates_.end(), cell_candidates.begin(), cell_candidates.end());
+        }
+    }
+    this->candidates_.shrink_to_fit();
+
+    LOG_D(
+      TAG,
+      "Closest point lookup: %ux%u cells, %u bytes",
+      static_cast<unsigned>(grid_size),
+      static_cast<unsigned>(grid_size),
+      static_cast<unsigned>(this->getLookupMemoryUsage())
+    );
+}
+
+template<typename Tc, typename To>
+auto OutputPlane_Closest<Tc, To>::getCellIndex(const Position& pos) const -> std::size_t
+{
+    const std::uint8_t shift = MAX_RESOLUTION - this->resolution_;
+
+    return (static_cast<std::size_t>(pos.y >> shift) << this->resolution_) | static_cast<std::size_t>(pos.x >> shift);
+}
+
 template<typename Tc, typename To>
 void OutputPlane_Closest<Tc, To>::effect(const Position& pos, const Value& val)
 {
-    auto& closest = this->findClosestPoint(*this->getAvailablePoints(), pos);
-    OutputPlane<Tc, To>::effect(closest, val);
+    if (this->sorted_points_.empty()) {
+        LOG_W(TAG, "No actuator for point (%u, %u)", pos.x, pos.y);
+        return;
+    }
+
+    OutputPlane<Tc, To>::effect(this->findClosestPoint(pos), val);
 }
 
 template<typename Tc, typename To>
-auto OutputPlane_Closest<Tc, To>::findClosestPoint(const PositionSet& pts, const Position& target) -> const Position&
+auto OutputPlane_Closest<Tc, To>::getActuator(const Position& pos) -> typename OutputPlane<Tc, To>::Actuator*
 {
-    // check if exact point exists
-    const auto find = pts.find(target);
-    if (find != pts.end()) {
-        return *find;
+    if (this->sorted_points_.empty()) {
+        return nullptr;
     }
 
-    // find the closest point by square distance
-    std::multimap<float, Position> distance_map = {};
-    for (const auto& point : pts) {
-        distance_map.insert({ (target - point), point });
+    return OutputPlane<Tc, To>::getActuator(this->findClosestPoint(pos));
+}
+
+template<typename Tc, typename To>
+auto OutputPlane_Closest<Tc, To>::findClosestPoint(const Position& target) const -> const Position&
+{
+    const LookupIndex* candidates = nullptr;
+    std::size_t count = 0;
+
+    if (this->lookup_.empty()) {
+        // linear search
+        count = this->sorted_points_.size();
+    } else {
+        const auto cell = this->lookup_[this->getCellIndex(target)];
+        if ((cell & SHARED_CELL) == 0) {
+            return this->sorted_points_[cell];
+        }
+
+        candidates = &this->candidates_[cell & ~SHARED_CELL];
+        count = static_cast<std::size_t>(*candidates++) + 1;
+    }
+
+    // squared distances are exact, ties are resolved to the lowest position
+    std::size_t closest = 0;
+    int closest_distance = std::numeric_limits<int>::max();
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t index = candidates != nullptr ? candidates[i] : i;
+        const int distance = squaredDistance(target, this->sorted_points_[index]);
+        if (distance < closest_distance) {
+            closest = index;
+            closest_distance = distance;
+        }
+    }
+
+    return this->sorted_points_[closest];
+}
+
+template<typename Tc, typename To>
+DensePlane<Tc, To>::DensePlane(const ActuatorMap& actuators) :
+  points_(), actuators_(), states_(actuators.size(), static_cast<Value>(0))
+{
+    this->points_.reserve(actuators.size());
+    this->actuators_.reserve(actuators.size());
+
+    // std::map is already ordered by the position
+    for (const auto& [point, actuator] : actuators) {
+        this->points_.push_back(point);
+        this->actuators_.push_back(actuator);
+    }
+}
+
+template<typename Tc, typename To>
+void DensePlane<Tc, To>::setup()
+{
+    for (auto* actuator : this->actuators_) {
+        actuator->init();
+    }
+}
+
+template<typename Tc, typename To>
+auto DensePlane<Tc, To>::findIndex(const Position& pos) const -> std::optional<std::size_t>
+{
+    std::size_t length = this->points_.size();
+    if (length == 0) {
+        return std::nullopt;
+    }
+
+    // branch-free lower bound
+    const Position* base = this->points_.data();
+    while (length > 1) {
+        const std::size_t half = length / 2;
+        base = (base[half - 1] < pos) ? base + half : base;
+        length -= half;
     }
 
-    const auto nearest = std::min_element(distance_map.begin(), distance_map.end());
+    if (*base != pos) {
+        return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(base - this->points_.data());
+}
+
+template<typename Tc, typename To>
+void DensePlane<Tc, To>::effect(const Position& pos, const Value& val)
+{
+    const auto index = this->findIndex(pos);
+    if (!index.has_value()) {
+        LOG_W(TAG, "No actuator for point (%u, %u)", pos.x, pos.y);
+        return;
+    }
+
+    this->effect(index.value(), val);
+}
+
+template<typename Tc, typename To>
+void DensePlane<Tc, To>::enableChangeOnlyWrites(std::uint32_t maxDuty)
+{
+    for (auto& actuator : this->actuators_) {
+        if (actuator->skipsUnchangedWrites()) {
+            continue;
+        }
+
+        actuator = new Output::ChangeOnlyOutputDecorator(actuator, maxDuty, &this->write_counters_);
+    }
+}
+
+template<typename Tc, typename To>
+auto DensePlane<Tc, To>::getActuator(const Position& pos) -> Actuator*
+{
+    const auto index = this->findIndex(pos);
+    if (!index.has_value()) {
+        return nullptr;
+    }
 
-    return nearest->second;
+    return this->actuators_[index.value()];
 }
 
 template class OutputPlane<Position::Value, Output::IFloatOutput::ValueType>;
 template class OutputPlane_Closest<Position::Value, Output::IFloatOutput::ValueType>;
+template class DensePlane<Position::Value, Output::IFloatOutput::ValueType>;
 } // namespace SenseShift::Body::Haptics
@@ -3,21 +3,50 @@
 #include "senseshift/body/haptics/interface.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 
+#include <senseshift/core/logging.hpp>
 #include <senseshift/math/point2.hpp>
 #include <senseshift/output/output.hpp>
 #include <senseshift/utility.hpp>
 
 namespace SenseShift::Body::Haptics {
-/// Output "plane" (e.g. Chest, Palm, Finger, etc.).
+/// Output "plane" interface (e.g. Chest, Palm, Finger, etc.).
 ///
 /// \tparam Tc The type of the coordinate.
 /// \tparam To The type of the output value.
 template<typename Tc, typename To>
-class OutputPlane {
+class IOutputPlane {
+  public:
+    /// The type of the coordinate (e.g. std::uint8_t) for the plane.
+    using Coordinate = Tc;
+    /// The type of the position (e.g. Point2<std::uint8_t>) for the plane.
+    using Position = Math::Point2<Coordinate>;
+
+    /// The type of the output value (e.g. float) for the plane.
+    using Value = To;
+    /// The type of the actuator for the plane.
+    using Actuator = Output::IOutput<Value>;
+
+    virtual ~IOutputPlane() = default;
+
+    virtual void setup() = 0;
+    virtual void effect(const Position&, const Value&) = 0;
+
+    /// Get the actuator, that handles the given point, or nullptr if there is none.
+    virtual auto getActuator(const Position&) -> Actuator* = 0;
+};
+
+/// Output plane, backed by the ordered map of the actuators.
+///
+/// \tparam Tc The type of the coordinate.
+/// \tparam To The type of the output value.
+template<typename Tc, typename To>
+class OutputPlane : public IOutputPlane<Tc, To> {
   public:
     /// The type of the coordinate (e.g. std::uint8_t) for the plane.
     using Coordinate = Tc;
@@ -40,8 +69,9 @@ class OutputPlane {
         this->setActuators(actuators);
     }
 
-    void setup();
-    virtual void effect(const Position&, const Value&);
+    void setup() override;
+    void effect(const Position&, const Value&) override;
+    auto getActuator(const Position&) -> Actuator* override;
 
     auto getAvailablePoints() const -> const PositionSet*
     {
@@ -53,6 +83,19 @@ class OutputPlane {
         return &states_;
     }
 
+    /// Skip the writes, that would not change the duty cycle of the actuators. The actuators, that already skip them
+    /// (see IOutput::skipsUnchangedWrites()), are left as is, so it can be called more than once.
+    /// Must be called before the plane is set up or bound into a layout.
+    ///
+    /// \param maxDuty The max duty cycle of the actuators (e.g. 4095 for 12-bit PWM).
+    void enableChangeOnlyWrites(std::uint32_t maxDuty);
+
+    /// Issued and suppressed actuator writes, tracked once change-only writes are enabled.
+    [[nodiscard]] auto getWriteCounters() const -> const Output::OutputWriteCounters&
+    {
+        return this->write_counters_;
+    }
+
   protected:
     void setActuators(const ActuatorMap& actuators);
 
@@ -60,32 +103,158 @@ class OutputPlane {
     PositionSet points_;
     ActuatorMap actuators_{};
     PositionStateMap states_{};
+    Output::OutputWriteCounters write_counters_{};
 };
 
 /// Output plane, finds the closest actuator for the given point.
 /// \deprecated We should guarantee on the driver level, that the actuator is always exists.
 ///
+/// The actuators, that can be the closest to some point of the cell (a Voronoi diagram), are precomputed for every cell
+/// of the plane once, on construction. Most of the cells have a single one, so the effect is a table lookup, otherwise
+/// only the few candidates of the cell are compared. The result is the same as of the linear search over all the
+/// actuators, ties are resolved to the lowest position. The lookup grid has `(2^resolution)^2` cells, e.g. 64x64
+/// (8 KiB) for the default resolution of 6 bits per coordinate. Planes of more than 256 actuators use the linear search.
+///
 /// \tparam Tc The type of the coordinate.
 /// \tparam To The type of the output value.
 template<typename Tc, typename To>
 class OutputPlane_Closest : public OutputPlane<Tc, To> {
+    static_assert(sizeof(Tc) == 1, "OutputPlane_Closest lookup grid requires 8-bit coordinates");
+
   public:
     using Value = To;
     using PositionSet = typename OutputPlane<Tc, To>::PositionSet;
+    /// Index of the actuator in the lookup grid, limits the grid to 256 actuators.
+    using LookupIndex = std::uint8_t;
+    /// Cell of the lookup grid: either the index of its single candidate, or SHARED_CELL and the offset of its
+    /// candidates.
+    using LookupCell = std::uint16_t;
+
+    static constexpr LookupCell SHARED_CELL = 0x8000;
+
+    static constexpr std::uint8_t DEFAULT_RESOLUTION = 6;
+    static constexpr std::uint8_t MAX_RESOLUTION = 8;
 
-    explicit OutputPlane_Closest(const typename OutputPlane<Tc, To>::ActuatorMap& actuators) :
-      OutputPlane<Tc, To>(actuators)
+    /// \param actuators The actuators of the plane.
+    /// \param resolution Bits of each coordinate, used for the lookup grid, from 0 (single cell) to 8 (256x256 cells).
+    explicit OutputPlane_Closest(
+      const typename OutputPlane<Tc, To>::ActuatorMap& actuators, std::uint8_t resolution = DEFAULT_RESOLUTION
+    );
+
+    void effect(const Position&, const Value&) override;
+    auto getActuator(const Position&) -> typename OutputPlane<Tc, To>::Actuator* override;
+
+    /// Get the position of the closest actuator to the given point.
+    [[nodiscard]] auto findClosestPoint(const Position&) const -> const Position&;
+
+    [[nodiscard]] auto getResolution() const -> std::uint8_t
     {
+        return this->resolution_;
     }
 
+    /// Memory, used by the lookup grid, the candidates of the shared cells and the position table, in bytes.
+    [[nodiscard]] auto getLookupMemoryUsage() const -> std::size_t
+    {
+        return this->lookup_.capacity() * sizeof(LookupCell) + this->candidates_.capacity() * sizeof(LookupIndex)
+               + this->sorted_points_.capacity() * sizeof(Position);
+    }
+
+  private:
+    std::uint8_t resolution_;
+    /// Actuator positions, in ascending order.
+    std::vector<Position> sorted_points_{};
+    /// Every cell of the grid, row by row. Empty, if the linear search is used.
+    std::vector<LookupCell> lookup_{};
+    /// Candidates of the shared cells: the count, followed by the indices, in ascending order.
+    std::vector<LookupIndex> candidates_{};
+
+    [[nodiscard]] auto getCellIndex(const Position&) const -> std::size_t;
+};
+
+/// Output plane, backed by the flat arrays of the actuators, sorted by their position.
+///
+/// All the storage is allocated once, on construction. Lookups are branch-free binary searches over the contiguous
+/// array of the positions, and do not allocate. Actuators can also be addressed directly, by their index.
+///
+/// \tparam Tc The type of the coordinate.
+/// \tparam To The type of the output value.
+///
+/// \example
+/// \code
+/// auto frontOutputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>({ ... });
+/// app->getVibroBody()->addTarget(Target::ChestFront, new FloatDensePlane(frontOutputs));
+/// \endcode
+template<typename Tc, typename To>
+class DensePlane : public IOutputPlane<Tc, To> {
+  public:
+    using Coordinate = Tc;
+    using Position = Math::Point2<Coordinate>;
+    using Value = To;
+    using Actuator = Output::IOutput<Value>;
+
+    using ActuatorMap = std::map<Position, Actuator*>;
+
+    explicit DensePlane(const ActuatorMap& actuators);
+
+    void setup() override;
     void effect(const Position&, const Value&) override;
+    auto getActuator(const Position&) -> Actuator* override;
+
+    /// Write the value to the actuator with the given index, skipping the position lookup.
+    void effect(std::size_t index, const Value& val)
+    {
+        if (index >= this->actuators_.size()) {
+            LOG_W("haptic.plane", "No actuator with index %u", static_cast<unsigned>(index));
+            return;
+        }
+
+        this->actuators_[index]->writeState(val);
+        this->states_[index] = val;
+    }
+
+    /// Find the index of the actuator at the given position.
+    [[nodiscard]] auto findIndex(const Position&) const -> std::optional<std::size_t>;
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->points_.size();
+    }
+
+    /// Positions of the actuators, in ascending order.
+    [[nodiscard]] auto getAvailablePoints() const -> const std::vector<Position>&
+    {
+        return this->points_;
+    }
+
+    /// Last written values, in the same order as the positions.
+    [[nodiscard]] auto getActuatorStates() const -> const std::vector<Value>&
+    {
+        return this->states_;
+    }
+
+    /// Skip the writes, that would not change the duty cycle of the actuators. The actuators, that already skip them
+    /// (see IOutput::skipsUnchangedWrites()), are left as is, so it can be called more than once.
+    /// Must be called before the plane is set up or bound into a layout.
+    ///
+    /// \param maxDuty The max duty cycle of the actuators (e.g. 4095 for 12-bit PWM).
+    void enableChangeOnlyWrites(std::uint32_t maxDuty);
+
+    /// Issued and suppressed actuator writes, tracked once change-only writes are enabled.
+    [[nodiscard]] auto getWriteCounters() const -> const Output::OutputWriteCounters&
+    {
+        return this->write_counters_;
+    }
 
   private:
-    static auto findClosestPoint(const PositionSet&, const Position&) -> const Position&;
+    std::vector<Position> points_;
+    std::vector<Actuator*> actuators_;
+    std::vector<Value> states_;
+    Output::OutputWriteCounters write_counters_{};
 };
 
 using FloatPlane = OutputPlane<Position::Value, Output::IFloatOutput::ValueType>;
 using FloatPlane_Closest = OutputPlane_Closest<Position::Value, Output::IFloatOutput::ValueType>;
+using FloatDensePlane = DensePlane<Position::Value, Output::IFloatOutput::ValueType>;
 
 // TODO: configurable margin
 class PlaneMapper_Margin {
@@ -9,6 +9,13 @@
 
 namespace SenseShift::Input::Calibration {
 
+/// Learned input range of a calibrator, that can be persisted across reboots.
+template<typename Tp>
+struct CalibrationRange {
+    Tp min;
+    Tp max;
+};
+
 template<typename Tp>
 struct ICalibrator {
     /// Reset the calibration.
@@ -19,6 +26,22 @@ struct ICalibrator {
 
     /// Calibrate the input value.
     [[nodiscard]] virtual auto calibrate(Tp input) const -> Tp = 0;
+
+    /// Get the learned range, to persist it.
+    ///
+    /// \return False, if the calibrator has learned nothing (or has nothing to learn).
+    virtual auto getRange(CalibrationRange<Tp>& /*range*/) const -> bool
+    {
+        return false;
+    }
+
+    /// Restore the previously persisted range.
+    ///
+    /// \return False, if the range was not accepted.
+    virtual auto setRange(const CalibrationRange<Tp>& /*range*/) -> bool
+    {
+        return false;
+    }
 };
 
 template<typename Tp>
@@ -104,12 +127,33 @@ class MinMaxCalibrator : public ICalibrator<Tp> {
         }
     }
 
+    auto getRange(CalibrationRange<Tp>& range) const -> bool override
+    {
+        if (value_min_ > value_max_) {
+            return false;
+        }
+
+        range = { value_min_, value_max_ };
+        return true;
+    }
+
+    auto setRange(const CalibrationRange<Tp>& range) -> bool override
+    {
+        if (range.min > range.max) {
+            return false;
+        }
+
+        value_min_ = range.min;
+        value_max_ = range.max;
+        return true;
+    }
+
     auto calibrate(ValueType input) const -> ValueType override
     {
         // This means we haven't had any calibration data yet.
         // Return a neutral value right in the middle of the output range.
         if (value_min_ > value_max_) {
-            return (output_min_ + output_max_) / 2.0F;
+            return (output_min_ + output_max_) / 2;
         }
 
         if (input <= value_min_) {
@@ -183,10 +227,33 @@ class CenterPointDeviationCalibrator : public ICalibrator<Tp> {
         }
     }
 
+    /// The range is in the sensor units (0 to sensor_max), and is persisted as-is.
+    auto getRange(CalibrationRange<Tp>& range) const -> bool override
+    {
+        if (this->range_min_ == this->sensor_max_ && this->range_max_ == 0) {
+            return false;
+        }
+
+        range = { this->range_min_, this->range_max_ };
+        return true;
+    }
+
+    auto setRange(const CalibrationRange<Tp>& range) -> bool override
+    {
+        const auto in_bounds = [this](const Tp value) { return value >= 0 && value <= this->sensor_max_; };
+        if (!in_bounds(range.min) || !in_bounds(range.max)) {
+            return false;
+        }
+
+        this->range_min_ = range.min;
+        this->range_max_ = range.max;
+        return true;
+    }
+
     auto calibrate(ValueType input) const -> ValueType override
     {
         // Find the center point of the sensor, so we know how much we have deviated from it.
-        Tp center = (this->range_min_ + this->range_max_) / 2.0F;
+        Tp center = (this->range_min_ + this->range_max_) / 2;
 
         // Map the input to the sensor range of motion.
         int output = ::SenseShift::remap<Tp>(input, this->output_min_, this->output_max_, 0, this->sensor_max_);
@@ -252,7 +319,7 @@ class FixedCenterPointDeviationCalibrator : public ICalibrator<Tp> {
     auto calibrate(ValueType input) const -> ValueType override
     {
         // Find the center point of the sensor, so we know how much we have deviated from it.
-        Tp center = this->sensor_max_ / 2.0F;
+        Tp center = this->sensor_max_ / 2;
 
         // Map the input to the sensor range of motion.
         int output = ::SenseShift::remap<Tp>(input, this->output_min_, this->output_max_, 0, this->sensor_max_);
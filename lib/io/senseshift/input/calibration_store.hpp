@@ -0,0 +1,392 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "senseshift/input/calibration.hpp"
+
+#include "senseshift/core/logging.hpp"
+
+namespace SenseShift::Input::Calibration {
+/// Non-volatile storage of a single calibration blob (e.g. NVS, or a file).
+class ICalibrationStorage {
+  public:
+    virtual ~ICalibrationStorage() = default;
+
+    /// Read the stored blob.
+    ///
+    /// \return Number of the read bytes, 0 if nothing is stored, or it does not fit the buffer.
+    virtual auto read(std::uint8_t* buffer, std::size_t capacity) -> std::size_t = 0;
+
+    /// Replace the stored blob.
+    virtual auto write(const std::uint8_t* buffer, std::size_t length) -> bool = 0;
+};
+
+/// Calibration ranges of the input channels, in a compact versioned binary format.
+///
+/// Layout: magic "SC", version, entry count, hash of the channel configuration (4 bytes, little-endian), then every
+/// entry as the channel index (1 byte), min and max (float, little-endian, 4 bytes each), then the CRC-16/CCITT of all
+/// the previous bytes. A blob of a different version is rejected as a whole, so the format can change freely.
+class CalibrationBlob {
+  public:
+    using Range = CalibrationRange<float>;
+
+    static constexpr std::uint8_t MAGIC[2] = { 'S', 'C' };
+    static constexpr std::uint8_t VERSION = 2;
+
+    static constexpr std::size_t MAX_ENTRIES = 32;
+    static constexpr std::size_t HEADER_SIZE = 8;
+    static constexpr std::size_t ENTRY_SIZE = 9;
+    static constexpr std::size_t CRC_SIZE = 2;
+    static constexpr std::size_t MAX_SIZE = HEADER_SIZE + MAX_ENTRIES * ENTRY_SIZE + CRC_SIZE;
+
+    void clear()
+    {
+        this->count_ = 0;
+    }
+
+    /// Set the range of the channel, replacing the previous one.
+    ///
+    /// \return False, if the blob is full.
+    auto set(const std::uint8_t channel, const Range& range) -> bool
+    {
+        for (std::size_t i = 0; i < this->count_; i++) {
+            if (this->entries_[i].channel == channel) {
+                this->entries_[i].range = range;
+                return true;
+            }
+        }
+
+        if (this->count_ >= MAX_ENTRIES) {
+            return false;
+        }
+
+        this->entries_[this->count_++] = { channel, range };
+        return true;
+    }
+
+    /// \return False, if the channel has no range.
+    auto get(const std::uint8_t channel, Range& range) const -> bool
+    {
+        for (std::size_t i = 0; i < this->count_; i++) {
+            if (this->entries_[i].channel == channel) {
+                range = this->entries_[i].range;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->count_;
+    }
+
+    void setConfigHash(const std::uint32_t hash)
+    {
+        this->config_hash_ = hash;
+    }
+
+    /// Hash of the channel configuration, the ranges were collected with (see configHash()).
+    [[nodiscard]] auto getConfigHash() const -> std::uint32_t
+    {
+        return this->config_hash_;
+    }
+
+    /// \return Length of the encoded blob, 0 if it does not fit the buffer.
+    auto encode(std::uint8_t* buffer, const std::size_t capacity) const -> std::size_t
+    {
+        const auto length = HEADER_SIZE + this->count_ * ENTRY_SIZE + CRC_SIZE;
+        if (length > capacity) {
+            return 0;
+        }
+
+        buffer[0] = MAGIC[0];
+        buffer[1] = MAGIC[1];
+        buffer[2] = VERSION;
+        buffer[3] = static_cast<std::uint8_t>(this->count_);
+        writeUint32(buffer + 4, this->config_hash_);
+
+        auto* entry = buffer + HEADER_SIZE;
+        for (std::size_t i = 0; i < this->count_; i++, entry += ENTRY_SIZE) {
+            entry[0] = this->entries_[i].channel;
+            writeFloat(entry + 1, this->entries_[i].range.min);
+            writeFloat(entry + 5, this->entries_[i].range.max);
+        }
+
+        const auto crc = crc16(buffer, length - CRC_SIZE);
+        buffer[length - 2] = static_cast<std::uint8_t>(crc & 0xFF);
+        buffer[length - 1] = static_cast<std::uint8_t>(crc >> 8);
+
+        return length;
+    }
+
+    /// Replace the contents with the encoded blob.
+    ///
+    /// \return False, if the blob is malformed, corrupted, or of another version. The contents are cleared then.
+    auto decode(const std::uint8_t* buffer, const std::size_t length) -> bool
+    {
+        this->clear();
+
+        if (length < HEADER_SIZE + CRC_SIZE || buffer[0] != MAGIC[0] || buffer[1] != MAGIC[1]
+            || buffer[2] != VERSION) {
+            return false;
+        }
+
+        const std::size_t count = buffer[3];
+        if (count > MAX_ENTRIES || length != HEADER_SIZE + count * ENTRY_SIZE + CRC_SIZE) {
+            return false;
+        }
+
+        const auto crc = static_cast<std::uint16_t>(buffer[length - 2] | (buffer[length - 1] << 8));
+        if (crc != crc16(buffer, length - CRC_SIZE)) {
+            return false;
+        }
+
+        const auto* entry = buffer + HEADER_SIZE;
+        for (std::size_t i = 0; i < count; i++, entry += ENTRY_SIZE) {
+            this->entries_[i] = { entry[0], { readFloat(entry + 1), readFloat(entry + 5) } };
+        }
+        this->count_ = count;
+        this->config_hash_ = readUint32(buffer + 4);
+
+        return true;
+    }
+
+    static auto crc16(const std::uint8_t* data, const std::size_t length) -> std::uint16_t
+    {
+        std::uint16_t crc = 0xFFFF;
+        for (std::size_t i = 0; i < length; i++) {
+            crc ^= static_cast<std::uint16_t>(data[i] << 8);
+            for (auto bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) != 0 ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021)
+                                          : static_cast<std::uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    /// FNV-1a hash of the channel configuration description (e.g. the stringified pins and flags), so the ranges are
+    /// not restored to the other sensors.
+    static constexpr auto configHash(const char* config) -> std::uint32_t
+    {
+        std::uint32_t hash = 2166136261U;
+        for (; *config != '\0'; config++) {
+            hash = (hash ^ static_cast<std::uint8_t>(*config)) * 16777619U;
+        }
+        return hash;
+    }
+
+  private:
+    struct Entry {
+        std::uint8_t channel;
+        Range range;
+    };
+
+    std::array<Entry, MAX_ENTRIES> entries_{};
+    std::size_t count_ = 0;
+    std::uint32_t config_hash_ = 0;
+
+    static void writeUint32(std::uint8_t* buffer, const std::uint32_t value)
+    {
+        for (auto i = 0; i < 4; i++) {
+            buffer[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+
+    static auto readUint32(const std::uint8_t* buffer) -> std::uint32_t
+    {
+        std::uint32_t value = 0;
+        for (auto i = 0; i < 4; i++) {
+            value |= static_cast<std::uint32_t>(buffer[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    static void writeFloat(std::uint8_t* buffer, const float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUint32(buffer, bits);
+    }
+
+    static auto readFloat(const std::uint8_t* buffer) -> float
+    {
+        const auto bits = readUint32(buffer);
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+/// Saves and restores the calibrators of the input channels.
+///
+/// The blob is only written, when it differs from the stored one, to spare the flash. A blob collected with another
+/// channel configuration (e.g. after the pins were changed) is discarded on load.
+///
+/// \example
+/// \code
+/// CalibrationStore store(new FileCalibrationStorage("calibration.bin"), CalibrationBlob::configHash("A0,A1,A2"));
+///
+/// store.load();
+/// store.restore(0, index_calibrator);
+///
+/// store.collect(0, index_calibrator);
+/// store.save();
+/// \endcode
+class CalibrationStore {
+  public:
+    explicit CalibrationStore(ICalibrationStorage* storage, const std::uint32_t config_hash = 0) :
+      storage_(storage), config_hash_(config_hash)
+    {
+        this->blob_.setConfigHash(config_hash);
+    }
+
+    /// Read the stored blob.
+    ///
+    /// \return False, if nothing valid is stored, or it was collected with another channel configuration.
+    auto load() -> bool
+    {
+        std::array<std::uint8_t, CalibrationBlob::MAX_SIZE> buffer{};
+        const auto length = this->storage_->read(buffer.data(), buffer.size());
+
+        if (length == 0 || !this->blob_.decode(buffer.data(), length)) {
+            this->blob_.setConfigHash(this->config_hash_);
+            this->stored_crc_.reset();
+            return false;
+        }
+
+        if (this->blob_.getConfigHash() != this->config_hash_) {
+            LOG_W("calibration", "Stored calibration is for another channel configuration, discarding it");
+            this->blob_.clear();
+            this->blob_.setConfigHash(this->config_hash_);
+            this->stored_crc_.reset();
+            return false;
+        }
+
+        this->stored_crc_ = CalibrationBlob::crc16(buffer.data(), length);
+        return true;
+    }
+
+    /// Write the blob, unless the same one is already stored.
+    auto save() -> bool
+    {
+        std::array<std::uint8_t, CalibrationBlob::MAX_SIZE> buffer{};
+        const auto length = this->blob_.encode(buffer.data(), buffer.size());
+        if (length == 0) {
+            return false;
+        }
+
+        const auto crc = CalibrationBlob::crc16(buffer.data(), length);
+        if (this->stored_crc_.has_value() && this->stored_crc_.value() == crc) {
+            return true;
+        }
+
+        if (!this->storage_->write(buffer.data(), length)) {
+            return false;
+        }
+
+        this->stored_crc_ = crc;
+        this->write_count_++;
+        return true;
+    }
+
+    /// Copy the range of the calibrator into the blob.
+    ///
+    /// \return False, if the calibrator has nothing to persist.
+    template<typename Tp>
+    auto collect(const std::uint8_t channel, const ICalibrator<Tp>& calibrator) -> bool
+    {
+        CalibrationRange<Tp> range{};
+        if (!calibrator.getRange(range)) {
+            return false;
+        }
+
+        return this->blob_.set(channel, { static_cast<float>(range.min), static_cast<float>(range.max) });
+    }
+
+    /// Restore the range of the calibrator from the blob.
+    ///
+    /// \return False, if the channel has no stored range, or the calibrator did not accept it.
+    template<typename Tp>
+    auto restore(const std::uint8_t channel, ICalibrator<Tp>& calibrator) const -> bool
+    {
+        CalibrationBlob::Range range{};
+        if (!this->blob_.get(channel, range)) {
+            return false;
+        }
+
+        return calibrator.setRange({ static_cast<Tp>(range.min), static_cast<Tp>(range.max) });
+    }
+
+    [[nodiscard]] auto getBlob() -> CalibrationBlob&
+    {
+        return this->blob_;
+    }
+
+    [[nodiscard]] auto getBlob() const -> const CalibrationBlob&
+    {
+        return this->blob_;
+    }
+
+    /// Number of the actual writes to the storage.
+    [[nodiscard]] auto getWriteCount() const -> std::uint32_t
+    {
+        return this->write_count_;
+    }
+
+  private:
+    ICalibrationStorage* storage_;
+    std::uint32_t config_hash_;
+    CalibrationBlob blob_{};
+    std::optional<std::uint16_t> stored_crc_{};
+    std::uint32_t write_count_ = 0;
+};
+
+/// Calibration storage in a regular file. Used on native, and on the targets with a filesystem.
+class FileCalibrationStorage : public ICalibrationStorage {
+  public:
+    explicit FileCalibrationStorage(std::string path) : path_(std::move(path))
+    {
+    }
+
+    auto read(std::uint8_t* buffer, const std::size_t capacity) -> std::size_t override
+    {
+        auto* file = std::fopen(this->path_.c_str(), "rb");
+        if (file == nullptr) {
+            return 0;
+        }
+
+        const auto length = std::fread(buffer, 1, capacity, file);
+        // The blob must fit the buffer as a whole
+        const bool truncated = std::fgetc(file) != EOF;
+        std::fclose(file);
+
+        return truncated ? 0 : length;
+    }
+
+    auto write(const std::uint8_t* buffer, const std::size_t length) -> bool override
+    {
+        auto* file = std::fopen(this->path_.c_str(), "wb");
+        if (file == nullptr) {
+            return false;
+        }
+
+        const auto written = std::fwrite(buffer, 1, length, file);
+        const bool closed = std::fclose(file) == 0;
+
+        return written == length && closed;
+    }
+
+  private:
+    std::string path_;
+};
+} // namespace SenseShift::Input::Calibration
@@ -7,12 +7,14 @@
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <senseshift/core/helpers.hpp>
 #include <senseshift/core/logging.hpp>
+#include <senseshift/core/ring_buffer.hpp>
 
 namespace SenseShift::Input::Filter {
 template<typename Tp>
@@ -99,6 +101,61 @@ class Filtered {
     std::vector<FilterType> filters_ = {};
 };
 
+/// Filter chain, composed at compile time.
+///
+/// Filters are stored inline and called without going through the vtable, so the compiler can inline the whole
+/// chain. The chain itself is a filter too, so it can be appended to the runtime chain as a single node.
+///
+/// \tparam Filters Filters to apply, in order.
+///
+/// \example
+/// \code
+/// auto chain = StaticFilterChain(ExponentialMovingAverageFilter<float>(0.8F), AnalogInvertFilter());
+/// \endcode
+template<typename... Filters>
+class StaticFilterChain final : public IFilter<typename std::tuple_element_t<0, std::tuple<Filters...>>::ValueType> {
+  public:
+    using ValueType = typename std::tuple_element_t<0, std::tuple<Filters...>>::ValueType;
+
+    static_assert(
+      (std::is_same_v<typename Filters::ValueType, ValueType> && ...),
+      "StaticFilterChain requires all filters to have the same value type"
+    );
+
+    explicit StaticFilterChain(Filters... filters) : filters_(std::move(filters)...)
+    {
+    }
+
+    auto filter(ISimpleSensor<ValueType>* sensor, ValueType value) -> ValueType override
+    {
+        return this->apply(sensor, value, std::index_sequence_for<Filters...>{});
+    }
+
+    /// Get the filter at the given position in the chain.
+    template<std::size_t I>
+    auto get() -> std::tuple_element_t<I, std::tuple<Filters...>>&
+    {
+        return std::get<I>(this->filters_);
+    }
+
+    static constexpr auto size() -> std::size_t
+    {
+        return sizeof...(Filters);
+    }
+
+  private:
+    std::tuple<Filters...> filters_;
+
+    template<std::size_t... Is>
+    inline auto apply(ISimpleSensor<ValueType>* sensor, ValueType value, std::index_sequence<Is...> /*unused*/)
+      -> ValueType
+    {
+        // Qualified calls are not dispatched through the vtable
+        ((value = std::get<Is>(this->filters_).Filters::filter(sensor, value)), ...);
+        return value;
+    }
+};
+
 template<typename Tp>
 class AddFilter : public IFilter<Tp> {
   public:
@@ -200,6 +257,9 @@ class LambdaFilter : public IFilter<Tp> {
     Lambda filter_;
 };
 
+/// Sliding window moving average with the window size set at runtime.
+///
+/// \see StaticSlidingWindowMovingAverageFilter for an allocation-free, constant time version.
 template<typename Tp>
 class SlidingWindowMovingAverageFilter : public IFilter<Tp> {
     static_assert(std::is_arithmetic_v<Tp>, "SlidingWindowAverageFilter only supports arithmetic types");
@@ -232,30 +292,316 @@ class SlidingWindowMovingAverageFilter : public IFilter<Tp> {
     }
 };
 
+/// Sliding window moving average with the window size fixed at compile time.
+///
+/// Backed by a static ring buffer and a running sum, so every sample costs O(1) and nothing is allocated.
+/// For floating point types the sum is re-calculated once per window to stop the rounding error from drifting.
+///
+/// \tparam Tp Type of the filtered value.
+/// \tparam N Size of the window.
+template<typename Tp, std::size_t N>
+class StaticSlidingWindowMovingAverageFilter : public IFilter<Tp> {
+    static_assert(std::is_arithmetic_v<Tp>, "StaticSlidingWindowMovingAverageFilter only supports arithmetic types");
+
+  public:
+    using SumType = std::conditional_t<std::is_floating_point_v<Tp>, Tp, std::intmax_t>;
+
+    auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
+    {
+        if (this->window_.full()) {
+            this->sum_ -= static_cast<SumType>(this->window_.front());
+        }
+        this->window_.push(value);
+        this->sum_ += static_cast<SumType>(value);
+
+        if constexpr (std::is_floating_point_v<Tp>) {
+            if (++this->since_renormalize_ >= N) {
+                this->renormalize();
+            }
+        }
+
+        return static_cast<Tp>(this->sum_ / static_cast<SumType>(this->window_.size()));
+    }
+
+  private:
+    RingBuffer<Tp, N> window_;
+    SumType sum_ = SumType();
+    std::size_t since_renormalize_ = 0;
+
+    void renormalize()
+    {
+        SumType sum = SumType();
+        for (std::size_t i = 0; i < this->window_.size(); i++) {
+            sum += static_cast<SumType>(this->window_[i]);
+        }
+
+        this->sum_ = sum;
+        this->since_renormalize_ = 0;
+    }
+};
+
+/// Sliding window of fixed size, that also keeps its values sorted.
+///
+/// Insertion and eviction shift at most N elements of a static array, nothing is allocated.
+template<typename Tp, std::size_t N>
+class SortedSlidingWindow {
+  public:
+    void push(Tp value)
+    {
+        if (this->window_.full()) {
+            const auto evicted = this->window_.front();
+            auto* const end = this->sorted_.data() + this->window_.size();
+            auto* const position = std::lower_bound(this->sorted_.data(), end, evicted);
+            std::copy(position + 1, end, position);
+        }
+        this->window_.push(value);
+
+        auto* const begin = this->sorted_.data();
+        auto* const end = begin + this->window_.size() - 1;
+        auto* const position = std::upper_bound(begin, end, value);
+        std::copy_backward(position, end, end + 1);
+        *position = value;
+    }
+
+    /// Get the value by its rank, 0 being the smallest.
+    [[nodiscard]] auto operator[](std::size_t rank) const -> Tp
+    {
+        return this->sorted_[rank];
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->window_.size();
+    }
+
+  private:
+    RingBuffer<Tp, N> window_;
+    std::array<Tp, N> sorted_{};
+};
+
+/// Sliding window median filter with the window size fixed at compile time.
+/// Rejects outliers (spikes) completely, as long as they take less than half of the window.
+///
+/// \tparam Tp Type of the filtered value.
+/// \tparam N Size of the window.
+template<typename Tp, std::size_t N>
+class StaticSlidingWindowMedianFilter : public IFilter<Tp> {
+    static_assert(std::is_arithmetic_v<Tp>, "StaticSlidingWindowMedianFilter only supports arithmetic types");
+
+  public:
+    auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
+    {
+        this->window_.push(value);
+
+        const auto size = this->window_.size();
+        if (size % 2 == 1) {
+            return this->window_[size / 2];
+        }
+
+        // The window is sorted, so `high - low` is never negative, and no intermediate sum can overflow
+        const auto low = this->window_[size / 2 - 1];
+        const auto high = this->window_[size / 2];
+        return static_cast<Tp>(low + (high - low) / 2);
+    }
+
+  private:
+    SortedSlidingWindow<Tp, N> window_;
+};
+
+/// Sliding window trimmed mean filter with the window size fixed at compile time.
+/// Drops \p Trim smallest and \p Trim largest values of the window, and averages the rest.
+///
+/// \tparam Tp Type of the filtered value.
+/// \tparam N Size of the window.
+/// \tparam Trim Number of values to drop from each end of the window.
+template<typename Tp, std::size_t N, std::size_t Trim = N / 4>
+class StaticSlidingWindowTrimmedMeanFilter : public IFilter<Tp> {
+    static_assert(std::is_arithmetic_v<Tp>, "StaticSlidingWindowTrimmedMeanFilter only supports arithmetic types");
+    static_assert(Trim * 2 < N, "Trimmed mean filter must keep at least one value");
+
+  public:
+    using SumType = std::conditional_t<std::is_floating_point_v<Tp>, Tp, std::intmax_t>;
+
+    auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
+    {
+        this->window_.push(value);
+
+        const auto size = this->window_.size();
+        // Trim proportionally less, while the window is still filling up
+        const auto trim = std::min(Trim, (size - 1) / 2);
+
+        SumType sum = SumType();
+        for (std::size_t i = trim; i < size - trim; i++) {
+            sum += static_cast<SumType>(this->window_[i]);
+        }
+
+        return static_cast<Tp>(sum / static_cast<SumType>(size - trim * 2));
+    }
+
+  private:
+    SortedSlidingWindow<Tp, N> window_;
+};
+
+/// Exponential moving average.
+///
+/// For the integer types (e.g. fixed-point values, see Math::Q15), the filter runs on the integer ALU only: alpha is
+/// converted once, and the average keeps 16 extra fractional bits, so the small steps are not lost to rounding. The
+/// integer values must be within +-2^23 then.
 template<typename Tp>
 class ExponentialMovingAverageFilter : public IFilter<Tp> {
     static_assert(std::is_arithmetic_v<Tp>, "ExponentialMovingAverageFilter only supports arithmetic types");
 
   public:
-    explicit ExponentialMovingAverageFilter(float alpha) : alpha_(alpha){};
+    using AccumulatorType = std::conditional_t<std::is_floating_point_v<Tp>, Tp, std::int64_t>;
+
+    explicit ExponentialMovingAverageFilter(float alpha) :
+      alpha_(alpha), alpha_fixed_(static_cast<std::int32_t>(alpha * (1 << FRACTION_BITS) + 0.5F)){};
+
+    auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
+    {
+        if constexpr (std::is_floating_point_v<Tp>) {
+            if (this->is_first_) {
+                this->is_first_ = false;
+
+                this->acc_ = value;
+                return this->acc_;
+            }
+
+            this->acc_ = (this->alpha_ * value) + ((1 - this->alpha_) * this->acc_);
+            return this->acc_;
+        } else {
+            const auto scaled = static_cast<AccumulatorType>(value) * (1 << FRACTION_BITS);
+            if (this->is_first_) {
+                this->is_first_ = false;
+
+                this->acc_ = scaled;
+                return value;
+            }
+
+            this->acc_ += ((scaled - this->acc_) * this->alpha_fixed_) >> FRACTION_BITS;
+            return static_cast<Tp>((this->acc_ + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+        }
+    }
+
+  private:
+    static constexpr std::uint8_t FRACTION_BITS = 16;
+
+    bool is_first_ = true;
+    float alpha_;
+    /// Alpha with FRACTION_BITS fractional bits, for the integer types.
+    std::int32_t alpha_fixed_;
+    AccumulatorType acc_ = AccumulatorType();
+};
+
+/// One-Euro filter: exponential smoothing with the cutoff frequency rising with the speed of the signal.
+///
+/// At rest, the cutoff is \p min_cutoff, which removes the jitter. In motion, the cutoff rises by \p beta per unit of
+/// speed, so the lag is cut down exactly when it is noticeable.
+///
+/// \see https://gery.casiez.net/1euro/
+///
+/// \tparam Tp Floating point type of the filtered value.
+template<typename Tp>
+class OneEuroFilter : public IFilter<Tp> {
+    static_assert(std::is_floating_point_v<Tp>, "OneEuroFilter only supports floating point types");
+
+  public:
+    /// \param rate Sample rate, in Hz.
+    /// \param min_cutoff Cutoff frequency at rest, in Hz. Lower means less jitter.
+    /// \param beta Cutoff frequency increase per unit/s of speed. Higher means less lag in motion.
+    /// \param derivative_cutoff Cutoff frequency of the speed estimate, in Hz.
+    explicit OneEuroFilter(Tp rate, Tp min_cutoff = 1.0, Tp beta = 0.0, Tp derivative_cutoff = 1.0) :
+      rate_(rate),
+      min_cutoff_(min_cutoff),
+      beta_(beta),
+      derivative_alpha_(smoothingFactor(rate, derivative_cutoff)){};
 
     auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
     {
         if (this->is_first_) {
             this->is_first_ = false;
 
-            this->acc_ = value;
-            return this->acc_;
+            this->value_ = value;
+            return this->value_;
         }
 
-        this->acc_ = (this->alpha_ * value) + ((1 - this->alpha_) * this->acc_);
-        return this->acc_;
+        const auto speed = (value - this->value_) * this->rate_;
+        this->speed_ += this->derivative_alpha_ * (speed - this->speed_);
+
+        const auto cutoff = this->min_cutoff_ + this->beta_ * std::abs(this->speed_);
+        this->value_ += smoothingFactor(this->rate_, cutoff) * (value - this->value_);
+        return this->value_;
     }
 
   private:
     bool is_first_ = true;
-    float alpha_;
-    Tp acc_;
+    Tp rate_;
+    Tp min_cutoff_;
+    Tp beta_;
+    Tp derivative_alpha_;
+
+    Tp value_ = Tp();
+    /// Smoothed speed, in units/s.
+    Tp speed_ = Tp();
+
+    /// Smoothing factor of the exponential filter with the given cutoff frequency.
+    static auto smoothingFactor(Tp rate, Tp cutoff) -> Tp
+    {
+        constexpr Tp two_pi = static_cast<Tp>(6.283185307179586);
+        return 1 / (1 + rate / (two_pi * cutoff));
+    }
+};
+
+/// Alpha-beta tracker: estimates the value and its velocity, and predicts the next value from them.
+///
+/// Unlike the moving averages, it has no steady lag on a ramp (e.g. a finger moving at constant speed). The output
+/// can also be extrapolated ahead by \p lead samples, to compensate the known delay further down the line (e.g.
+/// transport). Extrapolation overshoots at the stops, so it is usually followed by a ClampFilter.
+///
+/// \tparam Tp Floating point type of the filtered value.
+template<typename Tp>
+class AlphaBetaFilter : public IFilter<Tp> {
+    static_assert(std::is_floating_point_v<Tp>, "AlphaBetaFilter only supports floating point types");
+
+  public:
+    /// \param alpha Value correction gain, between 0 and 1. Lower means more smoothing.
+    /// \param beta Velocity correction gain. alpha^2 / (2 - alpha) gives the critically damped response.
+    /// \param lead Number of the samples to extrapolate the output ahead.
+    AlphaBetaFilter(Tp alpha, Tp beta, Tp lead = 0.0) : alpha_(alpha), beta_(beta), lead_(lead){};
+
+    auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
+    {
+        if (this->is_first_) {
+            this->is_first_ = false;
+
+            this->value_ = value;
+            return this->value_;
+        }
+
+        const auto predicted = this->value_ + this->velocity_;
+        const auto residual = value - predicted;
+
+        this->value_ = predicted + this->alpha_ * residual;
+        this->velocity_ += this->beta_ * residual;
+
+        return this->value_ + this->velocity_ * this->lead_;
+    }
+
+    /// Estimated velocity, in units per sample.
+    [[nodiscard]] auto getVelocity() const -> Tp
+    {
+        return this->velocity_;
+    }
+
+  private:
+    bool is_first_ = true;
+    Tp alpha_;
+    Tp beta_;
+    Tp lead_;
+
+    Tp value_ = Tp();
+    /// Velocity, in units per sample.
+    Tp velocity_ = Tp();
 };
 
 /// Deadzone filter. Clamps acc_ to center if it is within the deadzone.
@@ -299,6 +645,25 @@ class LookupTableInterpolationFilter : public IFilter<Tp> {
     Container const& lookup_table_;
 };
 
+/// Passes the value through unchanged. Stands in for a filter, that is disabled at compile time, in a
+/// StaticFilterChain.
+///
+/// \example
+/// \code
+/// StaticFilterChain(
+///     ExponentialMovingAverageFilter<float>(0.8F),
+///     std::conditional_t<INVERT, AnalogInvertFilter, IdentityFilter<float>>()
+/// )
+/// \endcode
+template<typename Tp>
+class IdentityFilter : public IFilter<Tp> {
+  public:
+    auto filter(ISimpleSensor<Tp>* /*sensor*/, Tp value) -> Tp override
+    {
+        return value;
+    }
+};
+
 /// Specialized filter for analog sensors (between 0.0 and 1.0).
 class AnalogInvertFilter : public IFilter<float> {
   public:
@@ -307,4 +672,18 @@ class AnalogInvertFilter : public IFilter<float> {
         return 1.0F - value;
     }
 };
+
+/// Fixed-point version of the AnalogInvertFilter (between 0 and Format::ONE).
+///
+/// \tparam Format Fixed-point format of the values, e.g. Math::Q15.
+template<typename Format>
+class FixedPointAnalogInvertFilter : public IFilter<typename Format::ValueType> {
+  public:
+    using ValueType = typename Format::ValueType;
+
+    auto filter(ISimpleSensor<ValueType>* /*sensor*/, ValueType value) -> ValueType override
+    {
+        return Format::ONE - value;
+    }
+};
 } // namespace SenseShift::Input::Filter
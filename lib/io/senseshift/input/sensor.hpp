@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <numeric>
 #include <optional>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "senseshift/input/calibration.hpp"
@@ -11,6 +13,11 @@
 #include "senseshift/core/component.hpp"
 #include "senseshift/core/helpers.hpp"
 
+// Max number of the value (and, separately, raw value) subscribers of a sensor
+#ifndef SS_SENSOR_CALLBACKS_MAX
+#define SS_SENSOR_CALLBACKS_MAX 4
+#endif
+
 #define SS_SUBSENSOR_INIT(SENSOR, ATTACH_CALLBACK, CALLBACK) \
     (SENSOR)->init();                                        \
     if (ATTACH_CALLBACK) {                                   \
@@ -34,38 +41,64 @@ class ISimpleSensor : public virtual IInitializable {
 using IBinarySimpleSensor = ISimpleSensor<bool>;
 using IFloatSimpleSensor = ISimpleSensor<float>;
 
+/// Sensor, as seen by the SensorGraph: ticked, watched for the value changes, and maybe computed from other sensors.
+class ISensorNode : public virtual IInitializable {
+  public:
+    virtual void tick() = 0;
+
+    /// Counter of the value changes: if it did not change, neither did the value.
+    [[nodiscard]] virtual auto getRevision() const -> std::uint32_t = 0;
+
+    /// Sensors the value is computed from (e.g. fingers of a gesture). Empty for the sources.
+    [[nodiscard]] virtual auto getDependencies() -> std::vector<ISensorNode*>
+    {
+        return {};
+    }
+};
+
 template<typename Tp>
 class ISensor : public ISimpleSensor<Tp>, public Calibration::Calibrated<Tp>, public Filter::Filtered<Tp> {};
 
+/// \note The callbacks are stored inline, up to SS_SENSOR_CALLBACKS_MAX of each kind, and must fit an InlineDelegate
+/// (e.g. a lambda capturing `this`), so publishing the state never allocates.
 template<typename Tp>
-class Sensor : public ISensor<Tp> {
+class Sensor : public ISensor<Tp>, public ISensorNode {
   public:
     using ValueType = Tp;
-    using CallbackManagerType = CallbackManager<void(ValueType)>;
+    using CallbackManagerType = StaticCallbackManager<SS_SENSOR_CALLBACKS_MAX, void(ValueType)>;
     using CallbackType = typename CallbackManagerType::CallbackType;
 
-    explicit Sensor(Tp value = Tp()) : raw_value_(value), value_(this->applyFilters(value))
+    explicit Sensor(Tp value = Tp()) : raw_value_(value), value_(value)
     {
     }
 
     void addValueCallback(CallbackType&& callback)
     {
-        this->callbacks_.add(std::move(callback));
+        if (!this->callbacks_.add(std::move(callback))) {
+            LOG_E("sensor", "Too many value callbacks, increase SS_SENSOR_CALLBACKS_MAX");
+        }
     }
 
     void addRawValueCallback(CallbackType&& callback)
     {
-        this->raw_callbacks_.add(std::move(callback));
+        if (!this->raw_callbacks_.add(std::move(callback))) {
+            LOG_E("sensor", "Too many raw value callbacks, increase SS_SENSOR_CALLBACKS_MAX");
+        }
     }
 
     void init() override
     {
     }
 
-    virtual void tick()
+    void tick() override
     {
     }
 
+    [[nodiscard]] auto getRevision() const -> std::uint32_t override
+    {
+        return this->revision_;
+    }
+
     /// Publish the given state to the sensor.
     ///
     /// Firstly, the given state will be assigned to the sensor's raw_value_.
@@ -75,11 +108,8 @@ class Sensor : public ISensor<Tp> {
     /// \param rawValue The new .raw_value_.
     void publishState(ValueType rawValue)
     {
-        this->raw_value_ = rawValue;
-        this->raw_callbacks_.call(this->raw_value_);
-
-        this->value_ = this->applyFilters(rawValue);
-        this->callbacks_.call(this->value_);
+        this->publishRawState(rawValue);
+        this->publishFilteredState(this->applyFilters(rawValue));
     }
 
     /// Get the current sensor .value_.
@@ -95,10 +125,32 @@ class Sensor : public ISensor<Tp> {
     }
 
   protected:
-    /// Apply current filters to value.
-    auto applyFilters(ValueType value) -> ValueType
+    /// Assign the raw state and notify raw state subscribers.
+    void publishRawState(ValueType rawValue)
+    {
+        this->raw_value_ = rawValue;
+        this->raw_callbacks_.call(this->raw_value_);
+    }
+
+    /// Assign the already filtered state and notify state subscribers.
+    void publishFilteredState(ValueType value)
+    {
+        if (value != this->value_) {
+            this->revision_++;
+        }
+        this->value_ = value;
+        this->callbacks_.call(this->value_);
+    }
+
+    /// Apply calibration and current filters to value.
+    virtual auto applyFilters(ValueType value) -> ValueType
+    {
+        return this->applyFilterChain(this->applyCalibration(value));
+    }
+
+    /// Update the calibrator (if calibrating) and calibrate the value.
+    auto applyCalibration(ValueType value) -> ValueType
     {
-        /// Apply calibration
         if (this->getCalibrator() != nullptr) {
             if (this->isCalibrating()) {
                 this->getCalibrator()->update(value);
@@ -107,7 +159,12 @@ class Sensor : public ISensor<Tp> {
             value = this->getCalibrator()->calibrate(value);
         }
 
-        /// Apply filters
+        return value;
+    }
+
+    /// Apply the runtime filter chain to value.
+    auto applyFilterChain(ValueType value) -> ValueType
+    {
         for (auto filter : this->getFilters()) {
             value = filter->filter(nullptr, value);
         }
@@ -121,6 +178,7 @@ class Sensor : public ISensor<Tp> {
 
     ValueType raw_value_;
     ValueType value_;
+    std::uint32_t revision_ = 0;
 
     /// Storage for raw state callbacks.
     CallbackManagerType raw_callbacks_ = CallbackManagerType();
@@ -130,7 +188,7 @@ class Sensor : public ISensor<Tp> {
 
 using FloatSensor = Sensor<float>;
 
-// todo: support double/triple/N-times/long click and so on
+/// See EdgeButtonSensor for the debounced buttons, with the double click and long press events.
 using BinarySensor = Sensor<bool>;
 
 template<typename Tp>
@@ -173,6 +231,74 @@ class SimpleSensorDecorator : public Sensor<Tp> {
     SourceType* source_;
 };
 
+/// Sensor decorator with the filter chain composed at compile time (see Filter::StaticFilterChain).
+///
+/// The compile-time chain is applied right after calibration, followed by the runtime filters (if any), however the
+/// state is published (e.g. through a `Sensor<Tp>*` by the MultiplexerScanner).
+///
+/// \example
+/// \code
+/// auto* sensor = new StaticFilteredSensorDecorator(
+///     new AnalogSimpleSensor(PIN),
+///     StaticFilterChain(ExponentialMovingAverageFilter<float>(0.8F), AnalogInvertFilter())
+/// );
+/// \endcode
+template<typename Tp, typename Chain>
+class StaticFilteredSensorDecorator : public Sensor<Tp> {
+    static_assert(std::is_same_v<typename Chain::ValueType, Tp>, "Filter chain must have the same value type");
+
+  public:
+    using ValueType = Tp;
+    using SourceType = ISimpleSensor<ValueType>;
+    using ChainType = Chain;
+
+    StaticFilteredSensorDecorator(SourceType* source, Chain chain) :
+      Sensor<Tp>(), source_(source), chain_(std::move(chain))
+    {
+    }
+
+    void init() override
+    {
+        this->source_->init();
+    }
+
+    void tick() override
+    {
+        this->updateValue();
+    }
+
+    auto updateValue() -> ValueType
+    {
+        // Same as publishState(), but with the chain called directly, so it is inlined
+        const auto raw_value = this->readRawValue();
+        this->publishRawState(raw_value);
+        this->publishFilteredState(this->applyFilters(raw_value));
+
+        return this->getValue();
+    }
+
+    [[nodiscard]] auto readRawValue() -> ValueType
+    {
+        return this->source_->getValue();
+    }
+
+    auto getChain() -> Chain&
+    {
+        return this->chain_;
+    }
+
+  protected:
+    /// Apply calibration, the compile-time chain and the runtime filters to value.
+    auto applyFilters(ValueType value) -> ValueType final
+    {
+        return this->applyFilterChain(this->chain_.filter(nullptr, this->applyCalibration(value)));
+    }
+
+  private:
+    SourceType* source_;
+    Chain chain_;
+};
+
 namespace _private {
 class TheFloatSensor : public Sensor<float> {};
 } // namespace _private
@@ -2,6 +2,7 @@
 
 #include "senseshift/input/sensor.hpp"
 #include <type_traits>
+#include <vector>
 
 namespace SenseShift::Input {
 template<typename Tp = float>
@@ -37,6 +38,11 @@ class AnalogThresholdSensor : public BinarySensor {
         });
     }
 
+    [[nodiscard]] auto getDependencies() -> std::vector<ISensorNode*> override
+    {
+        return { this->source_ };
+    }
+
     void tick()
     {
         if (this->attach_callbacks_) {
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <senseshift/core/helpers.hpp>
+#include <senseshift/core/spsc_queue.hpp>
+
+#include "senseshift/input/sensor.hpp"
+
+namespace SenseShift::Input {
+enum class ButtonEvent : std::uint8_t {
+    Press,
+    Release,
+    /// Second press, shortly after the first short one.
+    DoubleClick,
+    /// Held for the long press time. Emitted while still held, once per press.
+    LongPress,
+};
+
+struct ButtonTiming {
+    /// Edges within this time after an accepted one are bounces.
+    std::uint32_t debounce_ms = 20;
+    /// Max time from the release of the first click to the second press.
+    std::uint32_t double_click_ms = 300;
+    std::uint32_t long_press_ms = 800;
+};
+
+/// Level change of the button input, \c pressed is the level after the change.
+struct ButtonEdge {
+    std::uint32_t time_ms;
+    bool pressed;
+};
+
+/// Turns the timestamped raw edges of a button into debounced state and events.
+///
+/// Debounce is on the leading edge: the first edge is accepted at once, and the following ones are ignored for the
+/// debounce time. If the input settled at another level by then, it is accepted at the end of the debounce time. So
+/// the press is reported without the added latency, and a glitch shorter than the debounce time is still a press.
+///
+/// Time only moves forward through the edges and update(), so the detector does not depend on any clock, and the
+/// edges may be fed in batches, long after they happened.
+class ButtonEventDetector {
+  public:
+    using CallbackManagerType = CallbackManager<void(ButtonEvent)>;
+    using CallbackType = typename CallbackManagerType::CallbackType;
+
+    explicit ButtonEventDetector(const ButtonTiming& timing = {}) : timing_(timing)
+    {
+    }
+
+    void addEventCallback(CallbackType&& callback)
+    {
+        this->callbacks_.add(std::move(callback));
+    }
+
+    /// Feed the raw edge. Must not be older, than the previous edge or update().
+    void edge(const ButtonEdge& edge)
+    {
+        this->settle(edge.time_ms);
+
+        this->raw_ = edge.pressed;
+        if (edge.pressed == this->pressed_) {
+            return;
+        }
+
+        if (this->changed_ && edge.time_ms - this->changed_at_ < this->timing_.debounce_ms) {
+            // Bounce, reconciled by settle() at the end of the debounce time
+            return;
+        }
+
+        this->commit(edge.pressed, edge.time_ms);
+    }
+
+    /// Advance the time without an edge: settle the bounces and detect the long press.
+    void update(const std::uint32_t now_ms)
+    {
+        this->settle(now_ms);
+    }
+
+    /// Current debounced state.
+    [[nodiscard]] auto isPressed() const -> bool
+    {
+        return this->pressed_;
+    }
+
+    /// Whether the button is pressed, or was pressed at any moment since the previous call.
+    ///
+    /// A short press between two reads is still seen by the reader this way.
+    [[nodiscard]] auto consumePressed() -> bool
+    {
+        const bool pressed = this->pressed_ || this->latched_;
+        this->latched_ = false;
+        return pressed;
+    }
+
+    [[nodiscard]] auto getTiming() const -> const ButtonTiming&
+    {
+        return this->timing_;
+    }
+
+  private:
+    ButtonTiming timing_;
+    CallbackManagerType callbacks_{};
+
+    /// Last raw level.
+    bool raw_ = false;
+    /// Debounced level.
+    bool pressed_ = false;
+    /// Pressed since the last consumePressed().
+    bool latched_ = false;
+
+    /// Whether any edge was accepted yet, there is no debounce before the first one.
+    bool changed_ = false;
+    std::uint32_t changed_at_ = 0;
+
+    bool long_pressed_ = false;
+    /// Short clicks in the current double-click sequence.
+    std::uint8_t clicks_ = 0;
+    std::uint32_t released_at_ = 0;
+
+    void settle(const std::uint32_t now_ms)
+    {
+        if (this->raw_ != this->pressed_ && now_ms - this->changed_at_ >= this->timing_.debounce_ms) {
+            this->commit(this->raw_, this->changed_at_ + this->timing_.debounce_ms);
+        }
+
+        if (this->pressed_ && !this->long_pressed_ && now_ms - this->changed_at_ >= this->timing_.long_press_ms) {
+            this->long_pressed_ = true;
+            this->callbacks_.call(ButtonEvent::LongPress);
+        }
+    }
+
+    void commit(const bool pressed, const std::uint32_t time_ms)
+    {
+        this->pressed_ = pressed;
+        this->changed_ = true;
+        this->changed_at_ = time_ms;
+
+        if (pressed) {
+            this->latched_ = true;
+            this->long_pressed_ = false;
+            this->callbacks_.call(ButtonEvent::Press);
+
+            if (this->clicks_ == 1 && time_ms - this->released_at_ <= this->timing_.double_click_ms) {
+                this->clicks_ = 0;
+                this->callbacks_.call(ButtonEvent::DoubleClick);
+            } else {
+                this->clicks_ = 1;
+            }
+            return;
+        }
+
+        this->released_at_ = time_ms;
+        if (this->long_pressed_) {
+            // Long press does not start a double click
+            this->clicks_ = 0;
+        }
+        this->callbacks_.call(ButtonEvent::Release);
+    }
+};
+
+/// Binary sensor fed by the timestamped edges, instead of polling the input on every tick.
+///
+/// The edges are recorded into a lock-free queue by pushEdge(), usually from an interrupt handler, and turned into the
+/// value and the events on update(), from the sensor task. The value is latched: a press that started and ended
+/// between two updates is still reported as pressed once.
+///
+/// \tparam QueueSize Capacity of the edge queue, must be a power of two. On overflow, the newest edges are dropped,
+/// and onEdgesDropped() is called on the next update, to resync the level.
+template<std::size_t QueueSize = 16>
+class EdgeButtonSensor : public BinarySensor {
+  public:
+    using EventCallbackType = ButtonEventDetector::CallbackType;
+
+    explicit EdgeButtonSensor(const ButtonTiming& timing = {}) : BinarySensor(false), detector_(timing)
+    {
+    }
+
+    void addEventCallback(EventCallbackType&& callback)
+    {
+        this->detector_.addEventCallback(std::move(callback));
+    }
+
+    /// Record the edge. Safe to call from a single producer (e.g. interrupt handler), concurrently with update().
+    void pushEdge(const bool pressed, const std::uint32_t time_ms)
+    {
+        this->edges_.push({ time_ms, pressed });
+    }
+
+    /// Process the recorded edges, and publish the state.
+    void update(const std::uint32_t now_ms)
+    {
+        ButtonEdge edge{};
+        while (this->edges_.pop(edge)) {
+            this->detector_.edge(edge);
+        }
+
+        const auto dropped = this->edges_.getDroppedCount();
+        if (dropped != this->seen_dropped_) {
+            this->seen_dropped_ = dropped;
+            this->onEdgesDropped(now_ms);
+        }
+
+        this->detector_.update(now_ms);
+        this->publishState(this->detector_.consumePressed());
+    }
+
+    [[nodiscard]] auto isPressed() const -> bool
+    {
+        return this->detector_.isPressed();
+    }
+
+    /// Number of the edges, that did not fit the queue.
+    [[nodiscard]] auto getDroppedEdgeCount() const -> std::uint32_t
+    {
+        return this->edges_.getDroppedCount();
+    }
+
+  protected:
+    /// Called from update(), when some edges were lost. The level of the input may differ from the tracked one then,
+    /// so the implementations should read it and injectLevel().
+    virtual void onEdgesDropped(std::uint32_t /*now_ms*/)
+    {
+    }
+
+    /// Feed the actual level of the input directly, bypassing the queue. Consumer side only.
+    void injectLevel(const bool pressed, const std::uint32_t time_ms)
+    {
+        this->detector_.edge({ time_ms, pressed });
+    }
+
+  private:
+    SpscQueue<ButtonEdge, QueueSize> edges_{};
+    ButtonEventDetector detector_;
+    std::uint32_t seen_dropped_ = 0;
+};
+} // namespace SenseShift::Input
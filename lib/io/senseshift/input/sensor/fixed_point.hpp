@@ -0,0 +1,114 @@
+#pragma once
+
+#include <senseshift/math/fixed_point.hpp>
+
+#include "senseshift/input/calibration.hpp"
+#include "senseshift/input/sensor.hpp"
+
+namespace SenseShift::Input {
+/// Exposes the calibrator of a fixed-point sensor, to the owner of its float adapter (see FixedPointSensorAdapter).
+///
+/// The calibration itself is done by the fixed-point sensor, so update() and calibrate() are no-ops here. The range
+/// is converted to float, to be persisted along with the float calibrators.
+template<typename Format>
+class FixedPointCalibratorProxy : public Calibration::ICalibrator<float> {
+  public:
+    using SourceType = Calibration::ICalibrator<typename Format::ValueType>;
+
+    explicit FixedPointCalibratorProxy(SourceType* source) : source_(source)
+    {
+    }
+
+    void reset() override
+    {
+        this->source_->reset();
+    }
+
+    void update(float /*input*/) override
+    {
+    }
+
+    [[nodiscard]] auto calibrate(float input) const -> float override
+    {
+        return input;
+    }
+
+    auto getRange(Calibration::CalibrationRange<float>& range) const -> bool override
+    {
+        Calibration::CalibrationRange<typename Format::ValueType> source_range{};
+        if (!this->source_->getRange(source_range)) {
+            return false;
+        }
+
+        range = { Format::toFloat(source_range.min), Format::toFloat(source_range.max) };
+        return true;
+    }
+
+    auto setRange(const Calibration::CalibrationRange<float>& range) -> bool override
+    {
+        return this->source_->setRange({ Format::fromFloat(range.min), Format::fromFloat(range.max) });
+    }
+
+  private:
+    SourceType* source_;
+};
+
+/// Float sensor, backed by a fixed-point sensor (e.g. reading, filtering and calibrating in Math::Q15).
+///
+/// Everything up to the value is done in fixed point, and the value is converted to float once per tick, for the
+/// consumers that need floats (e.g. OpenGloves encoding). The calibration of the adapter (start, stop, reset,
+/// persisted range) is forwarded to the fixed-point sensor.
+///
+/// \tparam Format Fixed-point format of the source values, e.g. Math::Q15.
+///
+/// \example
+/// \code
+/// auto* source = new StaticFilteredSensorDecorator(
+///     new AnalogFixedPointSimpleSensor<Q15>(PIN),
+///     StaticFilterChain(ExponentialMovingAverageFilter<Q15::ValueType>(0.8F))
+/// );
+/// auto* sensor = new FixedPointSensorAdapter<Q15>(source, new MinMaxCalibrator<Q15::ValueType>(0, Q15::ONE));
+/// \endcode
+template<typename Format>
+class FixedPointSensorAdapter : public FloatSensor {
+  public:
+    using SourceType = Sensor<typename Format::ValueType>;
+    using SourceCalibratorType = Calibration::ICalibrator<typename Format::ValueType>;
+
+    /// \param calibrator Calibrator of the source, in fixed point. Optional.
+    explicit FixedPointSensorAdapter(SourceType* source, SourceCalibratorType* calibrator = nullptr) :
+      FloatSensor(), source_(source), calibrator_proxy_(calibrator)
+    {
+        if (calibrator != nullptr) {
+            this->source_->setCalibrator(calibrator);
+            this->setCalibrator(&this->calibrator_proxy_);
+        }
+    }
+
+    void init() override
+    {
+        this->source_->init();
+    }
+
+    void tick() override
+    {
+        if (this->isCalibrating()) {
+            this->source_->startCalibration();
+        } else {
+            this->source_->stopCalibration();
+        }
+
+        this->source_->tick();
+        this->publishState(Format::toFloat(this->source_->getValue()));
+    }
+
+    [[nodiscard]] auto getSource() -> SourceType*
+    {
+        return this->source_;
+    }
+
+  private:
+    SourceType* source_;
+    FixedPointCalibratorProxy<Format> calibrator_proxy_;
+};
+} // namespace SenseShift::Input
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "senseshift/input/sensor.hpp"
+
+#include <senseshift/core/component.hpp>
+
+namespace SenseShift::Input {
+/// Position of the \p code in the (reflected binary) Gray code sequence, i.e. the inverse Gray code.
+constexpr auto grayCodeRank(std::uint8_t code) -> std::uint8_t
+{
+    code ^= code >> 1;
+    code ^= code >> 2;
+    code ^= code >> 4;
+    return code;
+}
+
+/// Samples all registered channels of an analog multiplexer in one pass, and publishes the results into the sensors.
+///
+/// Channels are visited in Gray code order, so, when all channels are used, only one select pin toggles per step
+/// (including the wrap-around to the first channel of the next scan).
+///
+/// \tparam Mux Multiplexer type, must provide `init()` and `selectChannel(std::uint8_t)`.
+///
+/// \example
+/// \code
+/// auto* mux = new MUX_CD74HC4057Component({ 16, 17, 18, 19 });
+/// auto* scanner = new MultiplexerScanner(mux, new AnalogSimpleSensor(36));
+/// scanner->addChannel(0, thumb_curl_sensor);
+/// scanner->addChannel(1, index_curl_sensor);
+/// \endcode
+template<typename Mux>
+class MultiplexerScanner : public IInitializable {
+  public:
+    using SignalSource = IFloatSimpleSensor;
+    using Target = FloatSensor;
+
+    struct Channel {
+        std::uint8_t channel;
+        Target* sensor;
+    };
+
+    /// \param mux The multiplexer to scan.
+    /// \param signal The ADC source, connected to the SIG pin of the multiplexer.
+    MultiplexerScanner(Mux* mux, SignalSource* signal) : mux_(mux), signal_(signal)
+    {
+    }
+
+    /// Register the sensor, that will receive the values of the given channel.
+    /// Must be called before init(), as it allocates.
+    void addChannel(std::uint8_t channel, Target* sensor)
+    {
+        const Channel entry = { channel, sensor };
+        const auto position =
+          std::upper_bound(this->channels_.begin(), this->channels_.end(), entry, [](const auto& a, const auto& b) {
+              return grayCodeRank(a.channel) < grayCodeRank(b.channel);
+          });
+
+        this->channels_.insert(position, entry);
+    }
+
+    void init() override
+    {
+        this->mux_->init();
+        this->signal_->init();
+
+        for (const auto& entry : this->channels_) {
+            entry.sensor->init();
+        }
+    }
+
+    /// Sample every registered channel once.
+    void tick()
+    {
+        for (const auto& entry : this->channels_) {
+            this->mux_->selectChannel(entry.channel);
+            entry.sensor->publishState(this->signal_->getValue());
+        }
+    }
+
+    /// Registered channels, in the scan order.
+    [[nodiscard]] auto getChannels() const -> const std::vector<Channel>&
+    {
+        return this->channels_;
+    }
+
+  private:
+    Mux* mux_;
+    SignalSource* signal_;
+    std::vector<Channel> channels_{};
+};
+} // namespace SenseShift::Input
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "senseshift/input/sensor.hpp"
+
+namespace SenseShift::Input {
+/// Oversampling front-end for a noisy analog source (e.g. the ESP32 ADC).
+///
+/// Every read takes a burst of samples from the source, drops the lowest and the highest ones (outliers), and
+/// averages the rest. Unlike a moving average across the ticks, the value only depends on the current burst, so it
+/// adds no latency. The noise falls with the square root of the averaged samples count, at the cost of the burst read
+/// time.
+///
+/// \example
+/// \code
+/// // 8 samples, 2 lowest and 2 highest dropped, the 4 in the middle averaged
+/// auto* source = new OversamplingSensor(new AnalogSimpleSensor(PIN), 8, 2);
+/// \endcode
+class OversamplingSensor : public IFloatSimpleSensor {
+  public:
+    static constexpr std::size_t MAX_SAMPLES = 32;
+
+    /// \param samples Number of the samples in a burst, up to MAX_SAMPLES.
+    /// \param trim Number of the samples dropped from each end of the sorted burst.
+    OversamplingSensor(IFloatSimpleSensor* source, const std::uint8_t samples, const std::uint8_t trim = 0) :
+      source_(source),
+      samples_(std::clamp<std::size_t>(samples, 1, MAX_SAMPLES)),
+      trim_(std::min<std::size_t>(trim, (this->samples_ - 1) / 2))
+    {
+    }
+
+    void init() override
+    {
+        this->source_->init();
+    }
+
+    auto getValue() -> float override
+    {
+        for (std::size_t i = 0; i < this->samples_; i++) {
+            this->burst_[i] = this->source_->getValue();
+        }
+
+        const auto begin = this->burst_.begin();
+        const auto end = begin + this->samples_;
+        if (this->trim_ > 0) {
+            std::sort(begin, end);
+        }
+
+        float sum = 0.0F;
+        for (auto it = begin + this->trim_; it != end - this->trim_; ++it) {
+            sum += *it;
+        }
+        return sum / static_cast<float>(this->samples_ - 2 * this->trim_);
+    }
+
+    [[nodiscard]] auto getSamples() const -> std::size_t
+    {
+        return this->samples_;
+    }
+
+    [[nodiscard]] auto getTrim() const -> std::size_t
+    {
+        return this->trim_;
+    }
+
+  private:
+    IFloatSimpleSensor* source_;
+    const std::size_t samples_;
+    const std::size_t trim_;
+
+    std::array<float, MAX_SAMPLES> burst_{};
+};
+} // namespace SenseShift::Input
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <senseshift/core/component.hpp>
+#include <senseshift/core/logging.hpp>
+
+#include "senseshift/input/sensor.hpp"
+
+namespace SenseShift::Input {
+/// Ticks the sensors in the order of their dependencies, once per tick each.
+///
+/// The dependencies are learned from ISensorNode::getDependencies() on init(), including the sensors that were not
+/// added directly (e.g. fingers of a gesture). Then, on every tick, the sources (sensors without dependencies) are
+/// ticked first, and the derived sensors (e.g. gestures, total curl) after all of their dependencies. A derived sensor
+/// is skipped, if none of its dependencies changed the value since its last tick.
+///
+/// The derived sensors must not attach the callbacks to their dependencies then, or they are recalculated on every
+/// update of each dependency as well.
+///
+/// \example
+/// \code
+/// SensorGraph graph;
+/// graph.add(grab); // Fingers are added with it
+/// graph.add(trigger);
+/// graph.init();
+///
+/// graph.tick(); // Fingers first, then grab and trigger
+/// \endcode
+class SensorGraph : public IInitializable {
+  public:
+    /// Add the sensor, and its dependencies (on init). Must be called before init().
+    void add(ISensorNode* sensor)
+    {
+        this->roots_.push_back(sensor);
+    }
+
+    /// Sort the sensors by their dependencies, and initialize them in that order.
+    ///
+    /// Dependency cycles are reported and broken at the sensor that closes the cycle, so ticking always terminates.
+    void init() override
+    {
+        this->nodes_.clear();
+        this->dependencies_.clear();
+
+        std::map<ISensorNode*, VisitState> visited{};
+        for (auto* root : this->roots_) {
+            this->visit(root, visited);
+        }
+
+        for (auto& node : this->nodes_) {
+            node.sensor->init();
+        }
+    }
+
+    /// Tick the sources, then the derived sensors with the changed dependencies.
+    void tick()
+    {
+        for (auto& node : this->nodes_) {
+            if (node.dependency_count == 0) {
+                node.sensor->tick();
+                continue;
+            }
+
+            // Revisions only grow, so their sum changes whenever any of them does
+            std::uint32_t revisions = 0;
+            for (std::size_t i = 0; i < node.dependency_count; i++) {
+                revisions += this->dependencies_[node.first_dependency + i]->getRevision();
+            }
+            if (node.evaluated && revisions == node.seen_revisions) {
+                continue;
+            }
+
+            node.sensor->tick();
+            node.seen_revisions = revisions;
+            node.evaluated = true;
+        }
+    }
+
+    /// Number of the sensors in the graph, including the learned dependencies. Known after init().
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return this->nodes_.size();
+    }
+
+    /// Sensors in the order they are ticked. Known after init().
+    [[nodiscard]] auto getOrder() const -> std::vector<ISensorNode*>
+    {
+        std::vector<ISensorNode*> order{};
+        order.reserve(this->nodes_.size());
+        for (const auto& node : this->nodes_) {
+            order.push_back(node.sensor);
+        }
+        return order;
+    }
+
+  private:
+    enum class VisitState : std::uint8_t {
+        Visiting,
+        Done,
+    };
+
+    struct Node {
+        ISensorNode* sensor;
+        /// Dependencies are in the shared dependencies_ list, so the tick does not chase the pointers.
+        std::size_t first_dependency;
+        std::size_t dependency_count;
+        bool evaluated = false;
+        std::uint32_t seen_revisions = 0;
+    };
+
+    std::vector<ISensorNode*> roots_{};
+    std::vector<Node> nodes_{};
+    std::vector<ISensorNode*> dependencies_{};
+
+    /// Depth-first, so the node is appended right after all of its dependencies.
+    void visit(ISensorNode* sensor, std::map<ISensorNode*, VisitState>& visited)
+    {
+        const auto state = visited.find(sensor);
+        if (state != visited.end()) {
+            if (state->second == VisitState::Visiting) {
+                LOG_E("sensor_graph", "Dependency cycle, the dependency is ignored");
+            }
+            return;
+        }
+        visited[sensor] = VisitState::Visiting;
+
+        std::vector<ISensorNode*> dependencies{};
+        for (auto* dependency : sensor->getDependencies()) {
+            this->visit(dependency, visited);
+            // Still visiting means the dependency closes a cycle
+            if (visited[dependency] == VisitState::Done) {
+                dependencies.push_back(dependency);
+            }
+        }
+
+        this->nodes_.push_back({ sensor, this->dependencies_.size(), dependencies.size() });
+        this->dependencies_.insert(this->dependencies_.end(), dependencies.begin(), dependencies.end());
+        visited[sensor] = VisitState::Done;
+    }
+};
+} // namespace SenseShift::Input
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "senseshift/input/calibration.hpp"
+#include "senseshift/input/sensor.hpp"
+
+namespace SenseShift::Input {
+/// Flat, struct-of-arrays view of a fixed set of float sensors.
+///
+/// Every channel's raw value, filtered value, calibration bounds and calibrated value live in contiguous arrays, so
+/// reading the whole set is a linear pass over memory instead of chasing a pointer (and a virtual call) per sensor.
+///
+/// The sensors still own their filters and calibrators. On top of that, the table can min-max calibrate the
+/// channels, bound with `calibrate = true` (the output range is [0, 1], same as Calibration::MinMaxCalibrator<float>).
+/// The bounds are turned into a scale and an offset, so applying the calibration is a multiply and a clamp per
+/// calibrated channel. Such sensors should have no calibrator of their own. The other channels are only copied.
+///
+/// Unbound channels read as 0.
+///
+/// \tparam N The number of channels.
+///
+/// \example
+/// \code
+/// SensorTable<2> table;
+/// table.bind(0, index_curl_sensor, true);
+/// table.bind(1, middle_curl_sensor, true);
+/// table.init();
+///
+/// table.tick();
+/// const auto index_curl = table.getValue(0);
+/// \endcode
+template<std::size_t N>
+class SensorTable {
+  public:
+    static constexpr std::size_t CHANNEL_COUNT = N;
+
+    using SensorType = Sensor<float>;
+    using Values = std::array<float, N>;
+
+    SensorTable()
+    {
+        this->resetCalibration();
+    }
+
+    /// Bind the sensor to the channel, replacing the previous one.
+    ///
+    /// \param calibrate Whether the table should min-max calibrate the filtered value of the channel.
+    /// \return False, if the channel is out of range.
+    auto bind(const std::size_t channel, SensorType* sensor, const bool calibrate = false) -> bool
+    {
+        if (channel >= N) {
+            return false;
+        }
+
+        this->sensors_[channel] = sensor;
+        this->calibrated_[channel] = calibrate && sensor != nullptr;
+        this->updateMapping(channel);
+        this->rebuildActiveList();
+        return true;
+    }
+
+    void init()
+    {
+        for (std::size_t i = 0; i < this->active_count_; i++) {
+            this->sensors_[this->active_[i]]->init();
+        }
+    }
+
+    /// Tick the bound sensors, copy their values into the table, and calibrate them.
+    void tick()
+    {
+        for (std::size_t i = 0; i < this->active_count_; i++) {
+            this->sensors_[this->active_[i]]->tick();
+        }
+
+        this->collect();
+    }
+
+    /// Copy the values of the bound sensors into the table, and calibrate them, without ticking the sensors. For the
+    /// sensors ticked elsewhere (e.g. by a SensorGraph, in the order of their dependencies).
+    void collect()
+    {
+        for (std::size_t i = 0; i < this->active_count_; i++) {
+            const auto channel = this->active_[i];
+            auto* sensor = this->sensors_[channel];
+
+            this->raw_[channel] = sensor->getRawValue();
+            this->filtered_[channel] = sensor->getValue();
+        }
+
+        for (std::size_t i = 0; i < this->passthrough_count_; i++) {
+            const auto channel = this->passthrough_[i];
+            this->values_[channel] = this->filtered_[channel];
+        }
+
+        this->calibrate();
+    }
+
+    /// Update the bounds (if calibrating), and compute the calibrated values of the channels the table calibrates.
+    void calibrate()
+    {
+        if (this->calibrating_) {
+            for (std::size_t i = 0; i < this->calibrated_count_; i++) {
+                const auto channel = this->calibrated_channels_[i];
+                const auto input = this->filtered_[channel];
+                if (input < this->min_[channel] || input > this->max_[channel]) {
+                    this->min_[channel] = std::min(this->min_[channel], input);
+                    this->max_[channel] = std::max(this->max_[channel], input);
+                    this->updateMapping(channel);
+                }
+            }
+        }
+
+        // Every calibrated channel is mapped the same way, without the branches
+        for (std::size_t i = 0; i < this->calibrated_count_; i++) {
+            const auto channel = this->calibrated_channels_[i];
+            const auto mapped = (this->filtered_[channel] - this->offset_[channel]) * this->scale_[channel];
+            this->values_[channel] = std::min(std::max(mapped, this->low_[channel]), this->high_[channel]);
+        }
+    }
+
+    void resetCalibration()
+    {
+        this->min_.fill(1.0F);
+        this->max_.fill(0.0F);
+        for (std::size_t i = 0; i < N; i++) {
+            this->updateMapping(i);
+        }
+    }
+
+    void startCalibration()
+    {
+        this->calibrating_ = true;
+    }
+
+    void stopCalibration()
+    {
+        this->calibrating_ = false;
+    }
+
+    [[nodiscard]] auto isCalibrating() const -> bool
+    {
+        return this->calibrating_;
+    }
+
+    [[nodiscard]] auto getSensor(const std::size_t channel) const -> SensorType*
+    {
+        return this->sensors_[channel];
+    }
+
+    /// Calibrated value of the channel (or the filtered one, if the table does not calibrate it).
+    [[nodiscard]] auto getValue(const std::size_t channel) const -> float
+    {
+        return this->values_[channel];
+    }
+
+    [[nodiscard]] auto getFilteredValue(const std::size_t channel) const -> float
+    {
+        return this->filtered_[channel];
+    }
+
+    [[nodiscard]] auto getRawValue(const std::size_t channel) const -> float
+    {
+        return this->raw_[channel];
+    }
+
+    [[nodiscard]] auto getValues() const -> const Values&
+    {
+        return this->values_;
+    }
+
+    [[nodiscard]] auto getRawValues() const -> const Values&
+    {
+        return this->raw_;
+    }
+
+    [[nodiscard]] auto getCalibrationMin(const std::size_t channel) const -> float
+    {
+        return this->min_[channel];
+    }
+
+    [[nodiscard]] auto getCalibrationMax(const std::size_t channel) const -> float
+    {
+        return this->max_[channel];
+    }
+
+    /// Whether the table calibrates the channel.
+    [[nodiscard]] auto isChannelCalibrated(const std::size_t channel) const -> bool
+    {
+        return this->calibrated_[channel];
+    }
+
+    /// Get the learned range of the channel, to persist it.
+    ///
+    /// \return False, if the table does not calibrate the channel, or has learned nothing yet.
+    auto getCalibrationRange(const std::size_t channel, Calibration::CalibrationRange<float>& range) const -> bool
+    {
+        if (!this->calibrated_[channel] || this->min_[channel] > this->max_[channel]) {
+            return false;
+        }
+
+        range = { this->min_[channel], this->max_[channel] };
+        return true;
+    }
+
+    /// Restore the previously persisted range of the channel.
+    ///
+    /// \return False, if the table does not calibrate the channel, or the range is invalid.
+    auto setCalibrationRange(const std::size_t channel, const Calibration::CalibrationRange<float>& range) -> bool
+    {
+        if (!this->calibrated_[channel] || range.min > range.max) {
+            return false;
+        }
+
+        this->min_[channel] = range.min;
+        this->max_[channel] = range.max;
+        this->updateMapping(channel);
+        return true;
+    }
+
+    /// Number of the bound channels.
+    [[nodiscard]] auto getActiveCount() const -> std::size_t
+    {
+        return this->active_count_;
+    }
+
+  private:
+    Values raw_{};
+    Values filtered_{};
+    Values values_{};
+    Values min_{};
+    Values max_{};
+    std::array<bool, N> calibrated_{};
+
+    /// The calibrated value is `clamp((filtered - offset) * scale, low, high)`, precomputed from the bounds.
+    Values offset_{};
+    Values scale_{};
+    Values low_{};
+    Values high_{};
+
+    bool calibrating_ = false;
+
+    std::array<SensorType*, N> sensors_{};
+    /// Indices of the bound channels, so tick() does not have to skip the empty ones.
+    std::array<std::uint8_t, N> active_{};
+    std::size_t active_count_ = 0;
+    /// Indices of the bound channels, calibrated by the table, and the rest of them.
+    std::array<std::uint8_t, N> calibrated_channels_{};
+    std::size_t calibrated_count_ = 0;
+    std::array<std::uint8_t, N> passthrough_{};
+    std::size_t passthrough_count_ = 0;
+
+    static_assert(N <= std::numeric_limits<std::uint8_t>::max(), "Too many channels");
+
+    void updateMapping(const std::size_t channel)
+    {
+        const auto min = this->min_[channel];
+        const auto max = this->max_[channel];
+
+        if (!this->calibrated_[channel]) {
+            // Pass through
+            this->offset_[channel] = 0.0F;
+            this->scale_[channel] = 1.0F;
+            this->low_[channel] = -std::numeric_limits<float>::infinity();
+            this->high_[channel] = std::numeric_limits<float>::infinity();
+        } else if (min > max) {
+            // No calibration data yet: neutral value, right in the middle of the output range.
+            this->offset_[channel] = 0.0F;
+            this->scale_[channel] = 0.0F;
+            this->low_[channel] = 0.5F;
+            this->high_[channel] = 0.5F;
+        } else {
+            this->offset_[channel] = min;
+            this->scale_[channel] = 1.0F / std::max(max - min, std::numeric_limits<float>::min());
+            this->low_[channel] = 0.0F;
+            this->high_[channel] = 1.0F;
+        }
+    }
+
+    void rebuildActiveList()
+    {
+        this->active_count_ = 0;
+        this->calibrated_count_ = 0;
+        this->passthrough_count_ = 0;
+
+        for (std::size_t i = 0; i < N; i++) {
+            if (this->sensors_[i] == nullptr) {
+                continue;
+            }
+
+            const auto channel = static_cast<std::uint8_t>(i);
+            this->active_[this->active_count_++] = channel;
+            if (this->calibrated_[i]) {
+                this->calibrated_channels_[this->calibrated_count_++] = channel;
+            } else {
+                this->passthrough_[this->passthrough_count_++] = channel;
+            }
+        }
+    }
+};
+} // namespace SenseShift::Input
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <senseshift/core/component.hpp>
 
 namespace SenseShift::Output {
@@ -9,8 +11,75 @@ class IOutput : public IInitializable {
     using ValueType = Tp;
 
     virtual void writeState(ValueType value) = 0;
+
+    /// Whether the output skips the writes, that would not change its state, by itself.
+    [[nodiscard]] virtual auto skipsUnchangedWrites() const -> bool
+    {
+        return false;
+    }
 };
 
 using IBinaryOutput = IOutput<bool>;
 using IFloatOutput = IOutput<float>;
+
+/// Number of the writes, that were passed to the outputs, and that were skipped as unchanged.
+struct OutputWriteCounters {
+    std::uint32_t issued = 0;
+    std::uint32_t suppressed = 0;
+};
+
+/// Float output decorator, that skips the writes, which would not change the duty cycle of the wrapped output.
+///
+/// The value is quantised the same way the PWM outputs do (`value * maxDuty`, truncated), and compared against the
+/// last written one.
+class ChangeOnlyOutputDecorator : public IFloatOutput {
+  public:
+    /// \param output The wrapped output.
+    /// \param maxDuty The max duty cycle of the wrapped output (e.g. 4095 for 12-bit PWM).
+    /// \param counters Optional counters, can be shared between multiple decorators.
+    ChangeOnlyOutputDecorator(IFloatOutput* output, std::uint32_t maxDuty, OutputWriteCounters* counters = nullptr) :
+      output_(output), max_duty_(maxDuty), counters_(counters)
+    {
+    }
+
+    void init() override
+    {
+        this->output_->init();
+    }
+
+    void writeState(const ValueType value) override
+    {
+        const auto duty = static_cast<std::int32_t>(value * static_cast<ValueType>(this->max_duty_));
+        if (duty == this->last_duty_) {
+            if (this->counters_ != nullptr) {
+                this->counters_->suppressed++;
+            }
+            return;
+        }
+
+        this->last_duty_ = duty;
+        this->output_->writeState(value);
+
+        if (this->counters_ != nullptr) {
+            this->counters_->issued++;
+        }
+    }
+
+    [[nodiscard]] auto skipsUnchangedWrites() const -> bool override
+    {
+        return true;
+    }
+
+    [[nodiscard]] auto getOutput() const -> IFloatOutput*
+    {
+        return this->output_;
+    }
+
+  private:
+    IFloatOutput* output_;
+    std::uint32_t max_duty_;
+    OutputWriteCounters* counters_;
+    /// Nothing was written yet, so the first write always goes through.
+    std::int32_t last_duty_ = -1;
+};
 } // namespace SenseShift::Output
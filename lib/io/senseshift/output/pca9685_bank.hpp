@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <senseshift/core/component.hpp>
+#include <senseshift/core/logging.hpp>
+#include <senseshift/output/output.hpp>
+
+namespace SenseShift::Output {
+template<typename Bus>
+class PCA9685BankOutput;
+
+/// Stages the duty cycles of all 16 channels of a PCA9685, and writes the changed ones in a single auto-increment
+/// I2C transaction on flush().
+///
+/// \tparam Bus TwoWire-like I2C bus: `beginTransmission()`, `write()`, `endTransmission()`, `requestFrom()` and
+/// `read()`.
+///
+/// \example
+/// \code
+/// auto* bank = new PCA9685Bank<TwoWire>(Wire, 0x40);
+/// bank->init();
+///
+/// auto* motor = bank->getOutput(0);
+/// motor->writeState(0.5F);
+/// bank->flush();
+/// \endcode
+template<typename Bus>
+class PCA9685Bank : public IInitializable {
+  public:
+    static constexpr std::uint8_t CHANNEL_COUNT = 16;
+    static constexpr std::uint16_t MAX_DUTY = 4095;
+
+    static constexpr std::uint8_t REG_MODE1 = 0x00;
+    static constexpr std::uint8_t REG_LED0_ON_L = 0x06;
+    static constexpr std::uint8_t MODE1_AUTO_INCREMENT = 0x20;
+
+    PCA9685Bank(Bus& bus, const std::uint8_t address) : bus_(bus), address_(address)
+    {
+    }
+
+    /// Enable the register auto-increment, the rest of the chip setup (frequency, wakeup) is left to the caller.
+    void init() override
+    {
+        this->bus_.beginTransmission(this->address_);
+        this->bus_.write(REG_MODE1);
+        if (this->bus_.endTransmission(false) != 0
+            || this->bus_.requestFrom(this->address_, static_cast<std::uint8_t>(1)) != 1) {
+            LOG_E("pca9685.bank", "Failed to read MODE1 of 0x%02x", this->address_);
+            return;
+        }
+        const auto mode = static_cast<std::uint8_t>(this->bus_.read());
+
+        this->bus_.beginTransmission(this->address_);
+        this->bus_.write(REG_MODE1);
+        this->bus_.write(static_cast<std::uint8_t>(mode | MODE1_AUTO_INCREMENT));
+        if (this->bus_.endTransmission() != 0) {
+            LOG_E("pca9685.bank", "Failed to enable auto-increment on 0x%02x", this->address_);
+        }
+    }
+
+    /// Stage the duty cycle of the channel, it is written on the next flush().
+    void setChannel(const std::uint8_t channel, std::uint16_t duty)
+    {
+        if (channel >= CHANNEL_COUNT) {
+            return;
+        }
+        if (duty > MAX_DUTY) {
+            duty = MAX_DUTY;
+        }
+        if (this->duties_[channel] == duty && (this->written_ & (1U << channel)) != 0) {
+            return;
+        }
+
+        this->duties_[channel] = duty;
+        this->dirty_ |= static_cast<std::uint16_t>(1U << channel);
+    }
+
+    /// Write the staged channels, from the first to the last changed one, in a single transaction.
+    /// Writing all 16 channels takes 65 bytes, so the bus buffer must fit it (ESP32 Wire buffer is 128 bytes).
+    ///
+    /// \return `false` if the transaction failed. The channels stay staged, and are retried on the next flush.
+    auto flush() -> bool
+    {
+        if (this->dirty_ == 0) {
+            return true;
+        }
+
+        std::uint8_t first = 0;
+        while ((this->dirty_ & (1U << first)) == 0) {
+            first++;
+        }
+        std::uint8_t last = CHANNEL_COUNT - 1;
+        while ((this->dirty_ & (1U << last)) == 0) {
+            last--;
+        }
+
+        this->bus_.beginTransmission(this->address_);
+        this->bus_.write(static_cast<std::uint8_t>(REG_LED0_ON_L + first * 4));
+        for (auto channel = first; channel <= last; channel++) {
+            std::array<std::uint8_t, 4> registers = encodeDuty(this->duties_[channel]);
+            this->bus_.write(registers.data(), registers.size());
+        }
+        if (this->bus_.endTransmission() != 0) {
+            LOG_E("pca9685.bank", "Failed to write channels %u-%u of 0x%02x", first, last, this->address_);
+            return false;
+        }
+
+        this->written_ |= this->dirty_;
+        this->dirty_ = 0;
+        return true;
+    }
+
+    /// Staged duty cycle of the channel.
+    [[nodiscard]] auto getChannel(const std::uint8_t channel) const -> std::uint16_t
+    {
+        return this->duties_[channel];
+    }
+
+    /// Whether there are staged channels, that were not written yet.
+    [[nodiscard]] auto isDirty() const -> bool
+    {
+        return this->dirty_ != 0;
+    }
+
+    /// Create the output, that stages its values into the given channel.
+    [[nodiscard]] auto getOutput(std::uint8_t channel) -> PCA9685BankOutput<Bus>*
+    {
+        return new PCA9685BankOutput<Bus>(*this, channel);
+    }
+
+    /// LEDn_ON_L, LEDn_ON_H, LEDn_OFF_L, LEDn_OFF_H values for the duty cycle.
+    static auto encodeDuty(const std::uint16_t duty) -> std::array<std::uint8_t, 4>
+    {
+        // Use the dedicated full-on/full-off bits for the edge values, so the output has no glitches
+        if (duty == 0) {
+            return { 0x00, 0x00, 0x00, 0x10 };
+        }
+        if (duty >= MAX_DUTY) {
+            return { 0x00, 0x10, 0x00, 0x00 };
+        }
+        return { 0x00, 0x00, static_cast<std::uint8_t>(duty & 0xFF), static_cast<std::uint8_t>(duty >> 8) };
+    }
+
+  private:
+    Bus& bus_;
+    std::uint8_t address_;
+
+    std::array<std::uint16_t, CHANNEL_COUNT> duties_{};
+    std::uint16_t dirty_ = 0;
+    /// Channels, that were written at least once. The initial register values are unknown, so the first write of
+    /// every channel goes through.
+    std::uint16_t written_ = 0;
+};
+
+/// Single channel of the PCA9685Bank, the value is written on the next flush of the bank.
+template<typename Bus>
+class PCA9685BankOutput : public IFloatOutput {
+  public:
+    PCA9685BankOutput(PCA9685Bank<Bus>& bank, const std::uint8_t channel) : bank_(bank), channel_(channel)
+    {
+    }
+
+    void init() override
+    {
+        //
+    }
+
+    void writeState(const ValueType value) override
+    {
+        // Out of range casts are undefined: the negative values and NaN are off, the ones above 1 are full on
+        const auto clamped = value > 0.0F ? std::min(value, 1.0F) : 0.0F;
+        this->bank_.setChannel(this->channel_, static_cast<std::uint16_t>(clamped * PCA9685Bank<Bus>::MAX_DUTY));
+    }
+
+    /// The bank only sends the changed channels.
+    [[nodiscard]] auto skipsUnchangedWrites() const -> bool override
+    {
+        return true;
+    }
+
+  private:
+    PCA9685Bank<Bus>& bank_;
+    std::uint8_t channel_;
+};
+} // namespace SenseShift::Output
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace SenseShift::Math {
+/// Fixed-point format of the analog values, for the targets without a hardware FPU (ESP32-C3/S2, AVR).
+///
+/// The values are plain integers, scaled by 2^FractionBits: 0 is 0.0, and ONE is 1.0. Being arithmetic types, they
+/// work with the existing sensors, filters and calibrators as-is (e.g. `Sensor<Q15::ValueType>`).
+///
+/// \tparam FractionBits Number of the fractional bits.
+/// \tparam Storage Integer type of the values. Must fit ONE squared, so the products of two values do not overflow.
+template<std::uint8_t FractionBits, typename Storage>
+struct FixedPointFormat {
+    static_assert(std::is_integral_v<Storage> && std::is_signed_v<Storage>, "Storage must be a signed integer");
+    static_assert(FractionBits * 2 < sizeof(Storage) * 8 - 1, "Storage must fit the product of two values");
+
+    using ValueType = Storage;
+
+    static constexpr std::uint8_t FRACTION_BITS = FractionBits;
+    static constexpr ValueType ONE = static_cast<ValueType>(1) << FractionBits;
+    static constexpr ValueType HALF = ONE / 2;
+
+    /// Convert the float to fixed point, rounding to the nearest. Intended for the constants (e.g. thresholds).
+    static constexpr auto fromFloat(const float value) -> ValueType
+    {
+        const auto scaled = value * static_cast<float>(ONE);
+        return static_cast<ValueType>(scaled >= 0.0F ? scaled + 0.5F : scaled - 0.5F);
+    }
+
+    static constexpr auto toFloat(const ValueType value) -> float
+    {
+        return static_cast<float>(value) * (1.0F / static_cast<float>(ONE));
+    }
+
+    /// Product of two values, rounded to the nearest.
+    static constexpr auto multiply(const ValueType left, const ValueType right) -> ValueType
+    {
+        return (left * right + HALF) >> FractionBits;
+    }
+
+    /// Convert the raw integer reading (e.g. ADC) from the range 0 to \p RawMax, without the division.
+    ///
+    /// \param raw The reading, must not exceed \p RawMax.
+    template<std::uint32_t RawMax>
+    static constexpr auto fromRaw(const std::uint32_t raw) -> ValueType
+    {
+        static_assert(RawMax > 0 && RawMax < (1U << 16), "Raw readings must fit 16 bits");
+        static_assert(FractionBits <= 15, "Scaled raw readings must fit 32 bits");
+
+        // ONE / RawMax, with 16 extra bits of precision. Up to 2^31 / RawMax, so the product fits 32 bits
+        constexpr auto scale = static_cast<std::uint32_t>((static_cast<std::uint64_t>(ONE) << 16) / RawMax);
+        return static_cast<ValueType>((raw * scale + (1U << 15)) >> 16);
+    }
+};
+
+/// Analog values with 15 fractional bits in 32 bits: 0 to 32768 for 0.0 to 1.0, the rest is headroom for the filters.
+using Q15 = FixedPointFormat<15, std::int32_t>;
+} // namespace SenseShift::Math
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+
 #include <senseshift/body/hands/input/gesture.hpp>
+#include <senseshift/body/hands/input/gesture_engine.hpp>
 #include <senseshift/body/hands/input/total_curl.hpp>
 #include <senseshift/input/calibration.hpp>
 #include <senseshift/input/filter.hpp>
 #include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor/fixed_point.hpp>
+#include <senseshift/input/sensor/oversampling.hpp>
+#include <senseshift/math/fixed_point.hpp>
 #include <senseshift/opengloves/constants.hpp>
 #include <senseshift/opengloves/opengloves.hpp>
 
@@ -16,6 +23,11 @@
 #include <senseshift/opengloves/transport/stream.hpp>
 #endif
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <senseshift/arduino/input/preferences_calibration_storage.hpp>
+#include <senseshift/arduino/input/sensor/interrupt_button.hpp>
+#endif
+
 #pragma region Communication
 
 #ifndef OPENGLOVES_COMMUNICATION
@@ -38,17 +50,81 @@
 
 #pragma region Calibration
 
+// Read, filter and calibrate the finger sensors in fixed point (Q15), for the targets without a hardware FPU
+#ifndef FINGER_FIXED_POINT
+#define FINGER_FIXED_POINT false
+#endif
+
+#if defined(FINGER_FIXED_POINT) && FINGER_FIXED_POINT == true
+#ifndef CALIBRATION_CURL
+#define CALIBRATION_CURL                                                                        \
+    new ::SenseShift::Input::Calibration::MinMaxCalibrator<::SenseShift::Math::Q15::ValueType>( \
+      0,                                                                                        \
+      ::SenseShift::Math::Q15::ONE                                                              \
+    )
+#endif
+#ifndef CALIBRATION_SPLAY
+#define CALIBRATION_SPLAY                                                                                    \
+    new ::SenseShift::Input::Calibration::CenterPointDeviationCalibrator<::SenseShift::Math::Q15::ValueType>( \
+      ::SenseShift::Math::Q15::fromFloat(0.66F),                                                             \
+      ::SenseShift::Math::Q15::fromFloat(0.005F),                                                            \
+      0,                                                                                                     \
+      ::SenseShift::Math::Q15::ONE                                                                           \
+    )
+#endif
+#else
 #ifndef CALIBRATION_CURL
 #define CALIBRATION_CURL new ::SenseShift::Input::Calibration::MinMaxCalibrator<float>()
 #endif
 #ifndef CALIBRATION_SPLAY
 #define CALIBRATION_SPLAY new ::SenseShift::Input::Calibration::CenterPointDeviationCalibrator<float>(0.66F, 0.005F)
 #endif
+#endif
 
 #ifndef CALIBRATION_DURATION
 #define CALIBRATION_DURATION 2000 // duration in milliseconds
 #endif
 
+// Save the calibration to the flash, and restore it on boot (ESP32 only). The min-max calibration only widens the
+// ranges, so a bad one is kept until CALIBRATION_RESET_COMMAND is sent, or the calibration button is pressed.
+#ifndef CALIBRATION_PERSIST
+#define CALIBRATION_PERSIST false
+#endif
+
+#define SS_CALIBRATION_STRINGIFY_(X) #X
+#define SS_CALIBRATION_STRINGIFY(X) SS_CALIBRATION_STRINGIFY_(X)
+
+// Channel configuration the calibration is saved with: a saved one is discarded if it changes (e.g. another pin)
+#ifndef CALIBRATION_CONFIG
+#define CALIBRATION_CONFIG                                   \
+    SS_CALIBRATION_STRINGIFY(FINGER_FIXED_POINT)             \
+    "|" SS_CALIBRATION_STRINGIFY(PIN_FINGER_THUMB)           \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_THUMB_INVERT)        \
+    "," SS_CALIBRATION_STRINGIFY(PIN_FINGER_THUMB_SPLAY)     \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_THUMB_SPLAY_INVERT)  \
+    "|" SS_CALIBRATION_STRINGIFY(PIN_FINGER_INDEX)           \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_INDEX_INVERT)        \
+    "," SS_CALIBRATION_STRINGIFY(PIN_FINGER_INDEX_SPLAY)     \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_INDEX_SPLAY_INVERT)  \
+    "|" SS_CALIBRATION_STRINGIFY(PIN_FINGER_MIDDLE)          \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_MIDDLE_INVERT)       \
+    "," SS_CALIBRATION_STRINGIFY(PIN_FINGER_MIDDLE_SPLAY)    \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_MIDDLE_SPLAY_INVERT) \
+    "|" SS_CALIBRATION_STRINGIFY(PIN_FINGER_RING)            \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_RING_INVERT)         \
+    "," SS_CALIBRATION_STRINGIFY(PIN_FINGER_RING_SPLAY)      \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_RING_SPLAY_INVERT)   \
+    "|" SS_CALIBRATION_STRINGIFY(PIN_FINGER_PINKY)           \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_PINKY_INVERT)        \
+    "," SS_CALIBRATION_STRINGIFY(PIN_FINGER_PINKY_SPLAY)     \
+    "," SS_CALIBRATION_STRINGIFY(FINGER_PINKY_SPLAY_INVERT)
+#endif
+
+// Command, that forgets the calibration (the saved one included), and starts calibrating anew
+#ifndef CALIBRATION_RESET_COMMAND
+#define CALIBRATION_RESET_COMMAND "SS_CALIBRATION_RESET"
+#endif
+
 #pragma endregion
 
 #pragma region Fingers
@@ -83,14 +159,117 @@
 #define FINGER_PINKY_ENABLED false
 #endif
 
-#define DEFINE_FINGER(NAME, CURL_PIN, CURL_INVERT, CURL_CALIB)                                                        \
-    auto* NAME##_sensor =                                                                                             \
-      new ::SenseShift::Input::SimpleSensorDecorator(new ::SenseShift::Arduino::Input::AnalogSimpleSensor(CURL_PIN)); \
-    NAME##_sensor->addFilters({ new ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<float>(0.8F) });      \
-    if (CURL_INVERT) {                                                                                                \
-        NAME##_sensor->addFilter({ new ::SenseShift::Input::Filter::AnalogInvertFilter() });                          \
-    }                                                                                                                 \
+// Samples per finger sensor read (1 to disable), and how many of the lowest and the highest ones are dropped
+#ifndef FINGER_OVERSAMPLING
+#define FINGER_OVERSAMPLING 1
+#endif
+#ifndef FINGER_OVERSAMPLING_TRIM
+#define FINGER_OVERSAMPLING_TRIM (FINGER_OVERSAMPLING / 4)
+#endif
+
+// Smoothing across the ticks (1.0 to disable). Oversampling lowers the noise without the added latency.
+#ifndef FINGER_EMA_ALPHA
+#if FINGER_OVERSAMPLING > 1
+#define FINGER_EMA_ALPHA 1.0F
+#else
+#define FINGER_EMA_ALPHA 0.8F
+#endif
+#endif
+
+// Smoothing filter of the finger sensors: the moving average above, One-Euro (less lag in motion, less jitter at
+// rest), or alpha-beta (no lag at constant speed, and may predict ahead, to compensate the transport delay)
+#define FINGER_FILTER_EMA 0
+#define FINGER_FILTER_ONE_EURO 1
+#define FINGER_FILTER_ALPHA_BETA 2
+#ifndef FINGER_FILTER
+#define FINGER_FILTER FINGER_FILTER_EMA
+#endif
+
+#ifndef FINGER_ONE_EURO_MIN_CUTOFF
+#define FINGER_ONE_EURO_MIN_CUTOFF 1.0F
+#endif
+#ifndef FINGER_ONE_EURO_BETA
+#define FINGER_ONE_EURO_BETA 20.0F
+#endif
+
+#ifndef FINGER_ALPHA_BETA_ALPHA
+#define FINGER_ALPHA_BETA_ALPHA 0.3F
+#endif
+#ifndef FINGER_ALPHA_BETA_BETA
+#define FINGER_ALPHA_BETA_BETA 0.05F
+#endif
+// How far ahead the alpha-beta filter predicts, in ms
+#ifndef FINGER_PREDICTION_MS
+#define FINGER_PREDICTION_MS 0
+#endif
+
+#if FINGER_FILTER == FINGER_FILTER_ONE_EURO
+#define FINGER_SMOOTHING_FILTER                        \
+    ::SenseShift::Input::Filter::OneEuroFilter<float>( \
+      static_cast<float>(UPDATE_RATE),                 \
+      FINGER_ONE_EURO_MIN_CUTOFF,                      \
+      FINGER_ONE_EURO_BETA                             \
+    )
+#elif FINGER_FILTER == FINGER_FILTER_ALPHA_BETA
+#define FINGER_SMOOTHING_FILTER                                          \
+    ::SenseShift::Input::Filter::AlphaBetaFilter<float>(                 \
+      FINGER_ALPHA_BETA_ALPHA,                                           \
+      FINGER_ALPHA_BETA_BETA,                                            \
+      static_cast<float>(FINGER_PREDICTION_MS) * (UPDATE_RATE) / 1000.0F \
+    ),                                                                   \
+    ::SenseShift::Input::Filter::ClampFilter<float>(0.0F, 1.0F)
+#else
+#define FINGER_SMOOTHING_FILTER ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<float>(FINGER_EMA_ALPHA)
+#endif
+
+#if FINGER_OVERSAMPLING > 1
+#define FINGER_ANALOG_SOURCE(PIN)                                       \
+    new ::SenseShift::Input::OversamplingSensor(                        \
+      new ::SenseShift::Arduino::Input::AnalogSimpleSensor(PIN),        \
+      FINGER_OVERSAMPLING,                                              \
+      FINGER_OVERSAMPLING_TRIM                                          \
+    )
+#else
+#define FINGER_ANALOG_SOURCE(PIN) new ::SenseShift::Arduino::Input::AnalogSimpleSensor(PIN)
+#endif
+
+#if defined(FINGER_FIXED_POINT) && FINGER_FIXED_POINT == true
+#if FINGER_OVERSAMPLING > 1
+#error "FINGER_OVERSAMPLING is not supported with FINGER_FIXED_POINT"
+#endif
+#if FINGER_FILTER != FINGER_FILTER_EMA
+#error "Only FINGER_FILTER_EMA is supported with FINGER_FIXED_POINT"
+#endif
+
+#define DEFINE_FINGER(NAME, CURL_PIN, CURL_INVERT, CURL_CALIB)                                           \
+    auto* NAME##_fixed = new ::SenseShift::Input::StaticFilteredSensorDecorator(                         \
+      new ::SenseShift::Arduino::Input::AnalogFixedPointSimpleSensor<::SenseShift::Math::Q15>(CURL_PIN), \
+      ::SenseShift::Input::Filter::StaticFilterChain(                                                    \
+        ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<::SenseShift::Math::Q15::ValueType>( \
+          FINGER_EMA_ALPHA                                                                               \
+        ),                                                                                               \
+        std::conditional_t<                                                                              \
+          (CURL_INVERT),                                                                                 \
+          ::SenseShift::Input::Filter::FixedPointAnalogInvertFilter<::SenseShift::Math::Q15>,            \
+          ::SenseShift::Input::Filter::IdentityFilter<::SenseShift::Math::Q15::ValueType>>()             \
+      )                                                                                                  \
+    );                                                                                                   \
+    auto* NAME##_sensor =                                                                                \
+      new ::SenseShift::Input::FixedPointSensorAdapter<::SenseShift::Math::Q15>(NAME##_fixed, (CURL_CALIB));
+#else
+#define DEFINE_FINGER(NAME, CURL_PIN, CURL_INVERT, CURL_CALIB)                    \
+    auto* NAME##_sensor = new ::SenseShift::Input::StaticFilteredSensorDecorator( \
+      FINGER_ANALOG_SOURCE(CURL_PIN),                                             \
+      ::SenseShift::Input::Filter::StaticFilterChain(                             \
+        FINGER_SMOOTHING_FILTER,                                                  \
+        std::conditional_t<                                                       \
+          (CURL_INVERT),                                                          \
+          ::SenseShift::Input::Filter::AnalogInvertFilter,                        \
+          ::SenseShift::Input::Filter::IdentityFilter<float>>()                   \
+      )                                                                           \
+    );                                                                            \
     NAME##_sensor->setCalibrator((CURL_CALIB));
+#endif
 
 #ifdef PIN_FINGER_THUMB_SPLAY
 #define FINGER_THUMB_SPLAY (FINGER_THUMB_ENABLED && (PIN_FINGER_THUMB_SPLAY != -1))
@@ -136,14 +315,18 @@
 #define JOYSTICK_ENABLED false
 #endif
 
-#define DEFINE_JOYSTICK_AXIS(NAME, PIN, INVERT, DEADZONE)                                                        \
-    auto NAME##_sensor =                                                                                         \
-      new ::SenseShift::Input::SimpleSensorDecorator(new ::SenseShift::Arduino::Input::AnalogSimpleSensor(PIN)); \
-    NAME##_sensor->addFilters({ new ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<float>(0.7F),    \
-                                new ::SenseShift::Input::Filter::CenterDeadzoneFilter(DEADZONE) });              \
-    if (INVERT) {                                                                                                \
-        NAME##_sensor->addFilter({ new ::SenseShift::Input::Filter::AnalogInvertFilter() });                     \
-    }
+#define DEFINE_JOYSTICK_AXIS(NAME, PIN, INVERT, DEADZONE)                         \
+    auto* NAME##_sensor = new ::SenseShift::Input::StaticFilteredSensorDecorator( \
+      new ::SenseShift::Arduino::Input::AnalogSimpleSensor(PIN),                  \
+      ::SenseShift::Input::Filter::StaticFilterChain(                             \
+        ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<float>(0.7F), \
+        ::SenseShift::Input::Filter::CenterDeadzoneFilter(DEADZONE),              \
+        std::conditional_t<                                                       \
+          (INVERT),                                                               \
+          ::SenseShift::Input::Filter::AnalogInvertFilter,                        \
+          ::SenseShift::Input::Filter::IdentityFilter<float>>()                   \
+      )                                                                           \
+    );
 #pragma endregion
 
 #pragma region Buttons
@@ -196,10 +379,41 @@
 #define BUTTON_PINCH_ENABLED false
 #endif
 
+// Record the button edges from the GPIO interrupts, instead of polling the pins on every tick
+#ifndef BUTTON_INTERRUPT
+#ifdef ARDUINO_ARCH_ESP32
+#define BUTTON_INTERRUPT true
+#else
+#define BUTTON_INTERRUPT false
+#endif
+#endif
+
+#ifndef BUTTON_DEBOUNCE_MS
+#define BUTTON_DEBOUNCE_MS 20
+#endif
+#ifndef BUTTON_DOUBLE_CLICK_MS
+#define BUTTON_DOUBLE_CLICK_MS 300
+#endif
+#ifndef BUTTON_LONG_PRESS_MS
+#define BUTTON_LONG_PRESS_MS 800
+#endif
+
+#if defined(BUTTON_INTERRUPT) && BUTTON_INTERRUPT == true
+#define BUTTON_CLASS(PIN, MODE, INVERT)                          \
+    ::SenseShift::Arduino::Input::InterruptButtonSensor(         \
+      PIN,                                                       \
+      MODE,                                                      \
+      (INVERT ? HIGH : LOW),                                     \
+      ::SenseShift::Input::ButtonTiming{ BUTTON_DEBOUNCE_MS,     \
+                                         BUTTON_DOUBLE_CLICK_MS, \
+                                         BUTTON_LONG_PRESS_MS }  \
+    );
+#else
 #define BUTTON_CLASS(PIN, MODE, INVERT)                                                       \
     ::SenseShift::Input::SimpleSensorDecorator(                                               \
       new ::SenseShift::Arduino::Input::DigitalSimpleSensor(PIN, MODE, (INVERT ? HIGH : LOW)) \
     );
+#endif
 
 #pragma endregion
 
@@ -217,6 +431,24 @@
 #define GESTURE_PINCH_THRESHOLD (0.5F)
 #endif
 
+// Evaluate all the gestures in a single pass over the finger curls, instead of a sensor per gesture
+#ifndef GESTURE_ENGINE
+#define GESTURE_ENGINE false
+#endif
+
+// The gestures read the curl sensors, not the sensor table: with the curls calibrated by the table, they would see
+// the uncalibrated values
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true                                         \
+  && ((GESTURE_TRIGGER_ENABLED && FINGER_INDEX_ENABLED)                                                               \
+      || (GESTURE_GRAB_ENABLED && FINGER_INDEX_ENABLED && FINGER_MIDDLE_ENABLED && FINGER_RING_ENABLED                 \
+          && FINGER_PINKY_ENABLED)                                                                                    \
+      || (GESTURE_PINCH_ENABLED && FINGER_THUMB_ENABLED && FINGER_INDEX_ENABLED))
+static_assert(
+  !std::is_same_v<decltype(CALIBRATION_CURL), std::nullptr_t>,
+  "The gestures need CALIBRATION_CURL with SS_OG_SENSOR_TABLE_ENABLED: set it, or disable the gestures"
+);
+#endif
+
 #pragma endregion
 
 #ifdef PIN_FFB_THUMB
@@ -260,6 +492,31 @@
 #define UPDATE_RATE 90
 #endif
 
+// Only send the frames, that changed, so the update rate can be raised without saturating the transport
+#ifndef SEND_ON_CHANGE_ENABLED
+#define SEND_ON_CHANGE_ENABLED false
+#endif
+
+// Min change of an analog value to send, in the steps of the encoded value (1 sends any change of it)
+#ifndef SEND_ON_CHANGE_THRESHOLD
+#define SEND_ON_CHANGE_THRESHOLD 1
+#endif
+
+// Max value of the encoded analog values
+#ifndef SEND_ON_CHANGE_ANALOG_MAX
+#define SEND_ON_CHANGE_ANALOG_MAX 4095
+#endif
+
+// Max time between two sent frames, in ms
+#ifndef SEND_ON_CHANGE_KEEPALIVE
+#define SEND_ON_CHANGE_KEEPALIVE 250
+#endif
+
+// Command, that makes the tracking report its stage timings (with SS_PROFILING_ENABLED)
+#ifndef SS_PROFILING_COMMAND
+#define SS_PROFILING_COMMAND "SS_PROFILE"
+#endif
+
 namespace SenseShift::OpenGloves::AutoConfig {
 
 auto createInput() -> InputSensors
@@ -374,13 +631,16 @@ auto createInput() -> InputSensors
 #endif
 
 #if GESTURE_TRIGGER_ENABLED && FINGER_INDEX_ENABLED
+#if !GESTURE_ENGINE
     auto* trigger = new Body::Hands::Input::TriggerGesture(index_curl_sensor, GESTURE_TRIGGER_THRESHOLD);
     input_sensors.trigger.press = trigger;
+#endif
 #elif BUTTON_TRIGGER_ENABLED
     auto trigger = new BUTTON_CLASS(PIN_BUTTON_TRIGGER, INPUT_PULLUP, BUTTON_TRIGGER_INVERT);
 #endif
 
 #if GESTURE_GRAB_ENABLED && FINGER_INDEX_ENABLED && FINGER_MIDDLE_ENABLED && FINGER_RING_ENABLED && FINGER_PINKY_ENABLED
+#if !GESTURE_ENGINE
     auto* grab = new Body::Hands::Input::GrabGesture(
       Body::Hands::Input::GrabGesture::Fingers{ .index = index_curl_sensor,
                                                 .middle = middle_curl_sensor,
@@ -389,20 +649,59 @@ auto createInput() -> InputSensors
       GESTURE_GRAB_THRESHOLD
     );
     input_sensors.grab.press = grab;
+#endif
 #elif BUTTON_GRAB_ENABLED
     auto* grab = new BUTTON_CLASS(PIN_BUTTON_GRAB, INPUT_PULLUP, BUTTON_GRAB_INVERT);
 #endif
 
 #if GESTURE_PINCH_ENABLED && FINGER_THUMB_ENABLED && FINGER_INDEX_ENABLED
+#if !GESTURE_ENGINE
     auto* pinch = new Body::Hands::Input::PinchGesture(
       Body::Hands::Input::PinchGesture::Fingers{ .thumb = thumb_curl_sensor, .index = index_curl_sensor },
       GESTURE_PINCH_THRESHOLD
     );
     input_sensors.pinch.press = pinch;
+#endif
 #elif BUTTON_PINCH_ENABLED
     auto* pinch = new BUTTON_CLASS(PIN_BUTTON_PINCH, INPUT_PULLUP, BUTTON_PINCH_INVERT);
 #endif
 
+#if GESTURE_ENGINE
+    Body::Hands::Input::HandFingers gesture_fingers{};
+#if FINGER_THUMB_ENABLED
+    gesture_fingers.thumb = thumb_curl_sensor;
+#endif
+#if FINGER_INDEX_ENABLED
+    gesture_fingers.index = index_curl_sensor;
+#endif
+#if FINGER_MIDDLE_ENABLED
+    gesture_fingers.middle = middle_curl_sensor;
+#endif
+#if FINGER_RING_ENABLED
+    gesture_fingers.ring = ring_curl_sensor;
+#endif
+#if FINGER_PINKY_ENABLED
+    gesture_fingers.pinky = pinky_curl_sensor;
+#endif
+
+    auto* gestures = new Body::Hands::Input::HandGestureEngine<3>(
+      gesture_fingers,
+      Body::Hands::Input::defaultGestures(GESTURE_TRIGGER_THRESHOLD, GESTURE_GRAB_THRESHOLD, GESTURE_PINCH_THRESHOLD)
+    );
+
+    InputSensors::GestureBits gesture_bits{};
+#if GESTURE_TRIGGER_ENABLED && FINGER_INDEX_ENABLED
+    gesture_bits.trigger = static_cast<std::int8_t>(Body::Hands::Input::HandGesture::Trigger);
+#endif
+#if GESTURE_GRAB_ENABLED && FINGER_INDEX_ENABLED && FINGER_MIDDLE_ENABLED && FINGER_RING_ENABLED && FINGER_PINKY_ENABLED
+    gesture_bits.grab = static_cast<std::int8_t>(Body::Hands::Input::HandGesture::Grab);
+#endif
+#if GESTURE_PINCH_ENABLED && FINGER_THUMB_ENABLED && FINGER_INDEX_ENABLED
+    gesture_bits.pinch = static_cast<std::int8_t>(Body::Hands::Input::HandGesture::Pinch);
+#endif
+    input_sensors.setGestures(gestures, gesture_bits);
+#endif
+
     return input_sensors;
 }
 
@@ -438,6 +737,21 @@ auto createFfbOutputs() -> OutputWriters
     return output_writers;
 }
 
+/**
+ * Setup the storage of the calibration, if it is persisted.
+ */
+auto createCalibrationStore() -> CalibrationStore*
+{
+#if CALIBRATION_PERSIST
+    return new CalibrationStore(
+      new ::SenseShift::Arduino::Input::PreferencesCalibrationStorage(),
+      ::SenseShift::Input::Calibration::CalibrationBlob::configHash(CALIBRATION_CONFIG)
+    );
+#else
+    return nullptr;
+#endif
+}
+
 /**
  * Setup the transport for the OpenGloves interface.
  */
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <senseshift/input/sensor_table.hpp>
+
+namespace SenseShift::OpenGloves {
+/// Number of the analog fields of the input peripheral: finger joint curls, splays, joystick axes and analog button
+/// values.
+///
+/// \tparam Peripheral og::InputPeripheral (of the sensors, or of the data), or a type of the same shape.
+template<typename Peripheral>
+constexpr auto analogChannelCount() -> std::size_t
+{
+    using Fingers = std::remove_reference_t<decltype(std::declval<Peripheral&>().curl.fingers)>;
+    using Joints = std::remove_reference_t<decltype(std::declval<Peripheral&>().curl.fingers[0].curl)>;
+    using Splays = std::remove_reference_t<decltype(std::declval<Peripheral&>().splay.fingers)>;
+    using AnalogButtons = std::remove_reference_t<decltype(std::declval<Peripheral&>().analog_buttons)>;
+
+    return std::tuple_size_v<Fingers> * std::tuple_size_v<Joints> + std::tuple_size_v<Splays> + 2
+           + std::tuple_size_v<AnalogButtons>;
+}
+
+/// Visit the analog fields of the input peripheral, in the sensor table channel order.
+///
+/// The same order is used for the sensor pointers and for the data, so the Nth visited sensor fills the Nth visited
+/// data field.
+///
+/// \param fn Called as `fn(channel, field)` for every field, in the channel order.
+template<typename Peripheral, typename Fn>
+void forEachAnalogChannel(Peripheral& peripheral, Fn&& fn)
+{
+    std::size_t channel = 0;
+
+    for (auto& finger : peripheral.curl.fingers) {
+        for (auto& joint : finger.curl) {
+            fn(channel++, joint);
+        }
+    }
+
+    for (auto& splay : peripheral.splay.fingers) {
+        fn(channel++, splay);
+    }
+
+    fn(channel++, peripheral.joystick.x);
+    fn(channel++, peripheral.joystick.y);
+
+    for (auto& analog_button : peripheral.analog_buttons) {
+        fn(channel++, analog_button.value);
+    }
+}
+
+/// Whether the channel is a finger joint curl.
+template<typename Peripheral>
+constexpr auto isCurlChannel(const std::size_t channel) -> bool
+{
+    using Fingers = std::remove_reference_t<decltype(std::declval<Peripheral&>().curl.fingers)>;
+    using Joints = std::remove_reference_t<decltype(std::declval<Peripheral&>().curl.fingers[0].curl)>;
+
+    return channel < std::tuple_size_v<Fingers> * std::tuple_size_v<Joints>;
+}
+
+/// Sensor table, holding every analog sensor of the input peripheral.
+template<typename Peripheral>
+using AnalogSensorTable = ::SenseShift::Input::SensorTable<analogChannelCount<Peripheral>()>;
+
+/// Bind the analog sensors of the peripheral to the table channels. The curl sensors without a calibrator of their own
+/// are calibrated by the table.
+template<typename Peripheral, typename Table>
+void bindAnalogChannels(Peripheral& sensors, Table& table)
+{
+    forEachAnalogChannel(sensors, [&table](const std::size_t channel, auto* sensor) {
+        const bool calibrate =
+          sensor != nullptr && isCurlChannel<Peripheral>(channel) && sensor->getCalibrator() == nullptr;
+        table.bind(channel, sensor, calibrate);
+    });
+}
+
+/// Fill the analog fields of the data from the table, in a single linear pass.
+///
+/// \param raw Whether to use the raw values, instead of the calibrated ones.
+template<typename Data, typename Table>
+void collectAnalogChannels(const Table& table, Data& data, const bool raw)
+{
+    static_assert(analogChannelCount<Data>() == Table::CHANNEL_COUNT, "Table does not match the data");
+
+    const auto& values = raw ? table.getRawValues() : table.getValues();
+    forEachAnalogChannel(data, [&values](const std::size_t channel, float& field) { field = values[channel]; });
+}
+} // namespace SenseShift::OpenGloves
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace SenseShift::OpenGloves {
+/// Incremental, non-blocking splitter of a byte stream into newline-terminated frames.
+///
+/// Bytes are accepted as they arrive, in any chunks. Only the newest complete frame is kept: if the host sends
+/// commands faster than they are consumed, the older ones are dropped, as every command carries the full state.
+/// Lines longer than the buffer are discarded up to the next newline.
+///
+/// \tparam N The max length of a frame, including the terminating NUL.
+///
+/// \example
+/// \code
+/// LineFramer<256> framer;
+/// framer.feed(Serial);
+///
+/// char command[256];
+/// if (const auto length = framer.read(command, sizeof(command)); length > 0) {
+///     handle(command, length);
+/// }
+/// \endcode
+template<std::size_t N>
+class LineFramer {
+    static_assert(N > 1, "LineFramer must fit at least one character and the terminator");
+
+  public:
+    static constexpr char DELIMITER = '\n';
+
+    /// Accept a single byte.
+    void push(const char byte)
+    {
+        if (byte == DELIMITER) {
+            this->completeLine();
+            return;
+        }
+
+        if (this->overflow_) {
+            return;
+        }
+        if (this->pending_length_ >= N - 1) {
+            // Line does not fit, skip it entirely instead of returning a truncated command
+            this->overflow_ = true;
+            this->overflow_count_++;
+            return;
+        }
+
+        this->buffers_[this->pending_index_][this->pending_length_++] = byte;
+    }
+
+    /// Accept the given bytes.
+    void push(const char* data, const std::size_t length)
+    {
+        for (std::size_t i = 0; i < length; i++) {
+            this->push(data[i]);
+        }
+    }
+
+    /// Accept all the bytes, that are currently available in the source. Never waits for more.
+    ///
+    /// \tparam Source Stream-like source, must provide `available()` and `read()`.
+    /// \return Number of the accepted bytes.
+    template<typename Source>
+    auto feed(Source& source) -> std::size_t
+    {
+        std::size_t accepted = 0;
+        while (source.available() > 0) {
+            const int byte = source.read();
+            if (byte < 0) {
+                break;
+            }
+
+            this->push(static_cast<char>(byte));
+            accepted++;
+        }
+        return accepted;
+    }
+
+    /// Whether there is a complete frame, that was not read yet.
+    [[nodiscard]] auto hasFrame() const -> bool
+    {
+        return this->ready_;
+    }
+
+    /// Take the newest complete frame.
+    ///
+    /// \param buffer Destination, the frame is NUL-terminated and truncated to fit.
+    /// \param length Size of the destination.
+    /// \return Length of the frame, without the delimiter and the terminator, or 0 if there is no complete frame.
+    auto read(char* buffer, const std::size_t length) -> std::size_t
+    {
+        if (!this->ready_ || length == 0) {
+            return 0;
+        }
+
+        const auto size = this->frame_length_ < length - 1 ? this->frame_length_ : length - 1;
+        std::memcpy(buffer, this->buffers_[this->pending_index_ ^ 1].data(), size);
+        buffer[size] = '\0';
+
+        this->ready_ = false;
+        return size;
+    }
+
+    /// Number of the complete frames, that were replaced by the newer ones before being read.
+    [[nodiscard]] auto getDroppedCount() const -> std::uint32_t
+    {
+        return this->dropped_count_;
+    }
+
+    /// Number of the lines, that were discarded as too long.
+    [[nodiscard]] auto getOverflowCount() const -> std::uint32_t
+    {
+        return this->overflow_count_;
+    }
+
+  private:
+    /// The line, that is being received, and the newest complete one. Swapped by index, so no bytes are copied.
+    std::array<std::array<char, N>, 2> buffers_{};
+    std::uint8_t pending_index_ = 0;
+
+    std::size_t pending_length_ = 0;
+    bool overflow_ = false;
+
+    std::size_t frame_length_ = 0;
+    bool ready_ = false;
+
+    std::uint32_t dropped_count_ = 0;
+    std::uint32_t overflow_count_ = 0;
+
+    void completeLine()
+    {
+        const auto length = this->pending_length_;
+        const auto overflow = this->overflow_;
+        this->pending_length_ = 0;
+        this->overflow_ = false;
+
+        // Skip the empty lines (e.g. the ones between "\n\n"), and the discarded ones
+        if (length == 0 || overflow) {
+            return;
+        }
+
+        if (this->ready_) {
+            this->dropped_count_++;
+        }
+
+        this->pending_index_ ^= 1;
+        this->frame_length_ = length;
+        this->ready_ = true;
+    }
+};
+
+/// Whether the frame is the given command. The trailing CR of the CRLF line endings is ignored.
+inline auto isCommand(const char* frame, std::size_t length, const char* command) -> bool
+{
+    if (length > 0 && frame[length - 1] == '\r') {
+        length--;
+    }
+
+    return length == std::strlen(command) && std::strncmp(frame, command, length) == 0;
+}
+} // namespace SenseShift::OpenGloves
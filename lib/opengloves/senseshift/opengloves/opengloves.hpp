@@ -1,14 +1,27 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <set>
+#include <tuple>
 #include <variant>
 #include <vector>
 
 #include <opengloves.hpp>
 
+#ifndef SS_OG_SENSOR_TABLE_ENABLED
+#define SS_OG_SENSOR_TABLE_ENABLED false
+#endif
+
+#include <senseshift/body/hands/input/gesture_engine.hpp>
+#include <senseshift/body/hands/input/total_curl.hpp>
 #include <senseshift/core/component.hpp>
+#include <senseshift/input/calibration_store.hpp>
 #include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor_graph.hpp>
+#include <senseshift/opengloves/input_table.hpp>
+#include <senseshift/opengloves/transport.hpp>
 #include <senseshift/output/output.hpp>
 
 #define SS_OG_COLLECT_DATA(FN)                                     \
@@ -59,29 +72,64 @@
         }                                                          \
     }                                                              \
                                                                    \
+    this->collectGestureData(data);                                \
     return data;
 
 namespace SenseShift::OpenGloves {
 namespace og = ::opengloves;
 
-class ITransport : public IInitializable {
-  public:
-    virtual auto send(const char* buffer, size_t length) -> size_t = 0;
-    virtual auto hasData() -> bool = 0;
-    virtual auto read(char* buffer, size_t length) -> size_t = 0;
-};
-
 using FloatSensor = ::SenseShift::Input::FloatSensor;
 using BinarySensor = ::SenseShift::Input::BinarySensor;
+using CalibrationStore = ::SenseShift::Input::Calibration::CalibrationStore;
+using GestureSensor = ::SenseShift::Body::Hands::Input::GestureSensor;
+
+/// Bind the sensors of the multi-joint finger: the joints go to `curl_joint1` and onwards, and `curl_total` gets their
+/// weighted average (see Body::Hands::Input::TotalCurl).
+///
+/// \return The total curl sensor.
+///
+/// \example
+/// \code
+/// bindFingerJoints(
+///   input_sensors.curl.index,
+///   std::array<CurlJoint, 2>{ { { index_mcp_sensor, 0.6F }, { index_pip_sensor, 0.4F } } }
+/// );
+/// \endcode
+template<typename Finger, std::size_t JointCount>
+auto bindFingerJoints(Finger& finger, const std::array<::SenseShift::Body::Hands::Input::CurlJoint, JointCount>& joints)
+  -> ::SenseShift::Body::Hands::Input::TotalCurl<JointCount>*
+{
+    static_assert(JointCount < std::tuple_size_v<decltype(finger.curl)>, "Finger has no fields for that many joints");
 
+    for (std::size_t i = 0; i < JointCount; i++) {
+        finger.curl[i + 1] = joints[i].sensor;
+    }
+
+    auto* total = new ::SenseShift::Body::Hands::Input::TotalCurl<JointCount>(joints);
+    finger.curl_total = total;
+    return total;
+}
+
+/// Input sensors of the glove.
+///
+/// With SS_OG_SENSOR_TABLE_ENABLED, the analog sensors are mirrored into a flat AnalogSensorTable, and the data is
+/// collected from contiguous arrays instead of null-checking and calling every sensor. The binary sensors are always
+/// read directly.
+///
+/// The sensors are ticked through a SensorGraph, so the derived ones (e.g. gestures) are ticked after their sources,
+/// and only when the sources changed.
 class InputSensors : public og::InputPeripheral<FloatSensor*, BinarySensor*> {
   public:
     void init()
     {
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+        bindAnalogChannels(*this, this->table_);
+#endif
+
         for (auto& finger_curl : this->curl.fingers) {
             for (auto& joint_sensor : finger_curl.curl) {
                 if (joint_sensor != nullptr) {
-                    joint_sensor->init();
+                    this->addSensor(joint_sensor);
                     this->calibrated_inputs_.insert(joint_sensor);
                 }
             }
@@ -89,51 +137,62 @@ class InputSensors : public og::InputPeripheral<FloatSensor*, BinarySensor*> {
 
         for (auto& finger_splay : this->splay.fingers) {
             if (finger_splay != nullptr) {
-                finger_splay->init();
+                this->addSensor(finger_splay);
                 this->calibrated_inputs_.insert(finger_splay);
             }
         }
 
-        SS_INIT_NOT_NULL(this->joystick.x);
-        SS_INIT_NOT_NULL(this->joystick.y);
-        SS_INIT_NOT_NULL(this->joystick.press);
+        this->addSensor(this->gestures_);
+        this->addSensor(this->joystick.x);
+        this->addSensor(this->joystick.y);
+        this->addSensor(this->joystick.press);
 
         for (auto& button : this->buttons) {
-            SS_INIT_NOT_NULL(button.press);
+            this->addSensor(button.press);
         }
 
         for (auto& analog_button : this->analog_buttons) {
-            SS_INIT_NOT_NULL(analog_button.press);
-            SS_INIT_NOT_NULL(analog_button.value);
+            this->addSensor(analog_button.press);
+            this->addSensor(analog_button.value);
         }
+
+        this->graph_.init();
     }
 
+    /// Tick the sensors once each, in the order of their dependencies: the gestures go after their fingers.
     void tick()
     {
-        for (auto& finger_curl : this->curl.fingers) {
-            for (auto& joint_sensor : finger_curl.curl) {
-                SS_TICK_NOT_NULL(joint_sensor);
-            }
-        }
-
-        for (auto& finger_splay : this->splay.fingers) {
-            SS_TICK_NOT_NULL(finger_splay);
-        }
-
-        SS_TICK_NOT_NULL(this->joystick.x);
-        SS_TICK_NOT_NULL(this->joystick.y);
-        SS_TICK_NOT_NULL(this->joystick.press);
+        this->graph_.tick();
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+        // Ticked by the graph, so the derived sensors (e.g. total curl) come after their sources
+        this->table_.collect();
+#endif
+    }
 
-        for (auto& button : this->buttons) {
-            SS_TICK_NOT_NULL(button.press);
-        }
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+    auto collectData() -> og::InputPeripheralData
+    {
+        og::InputPeripheralData data{};
+        collectAnalogChannels(this->table_, data, false);
+        this->collectBinaryData(data, &BinarySensor::getValue);
+        this->collectGestureData(data);
+        return data;
+    }
 
-        for (auto& analog_button : this->analog_buttons) {
-            SS_TICK_NOT_NULL(analog_button.press);
-            SS_TICK_NOT_NULL(analog_button.value);
-        }
+    auto collectRawData() -> og::InputPeripheralData
+    {
+        og::InputPeripheralData data{};
+        collectAnalogChannels(this->table_, data, true);
+        this->collectBinaryData(data, &BinarySensor::getRawValue);
+        this->collectGestureData(data);
+        return data;
     }
 
+    [[nodiscard]] auto getSensorTable() -> AnalogSensorTable<og::InputPeripheralData>&
+    {
+        return this->table_;
+    }
+#else
     auto collectData() -> og::InputPeripheralData
     {
         SS_OG_COLLECT_DATA(getValue);
@@ -143,12 +202,31 @@ class InputSensors : public og::InputPeripheral<FloatSensor*, BinarySensor*> {
     {
         SS_OG_COLLECT_DATA(getRawValue);
     }
+#endif
+
+    /// Bits of the gesture buttons in the gesture mask, -1 for the ones not read from it.
+    struct GestureBits {
+        std::int8_t trigger = -1;
+        std::int8_t grab = -1;
+        std::int8_t pinch = -1;
+    };
+
+    /// Read the gesture buttons from the packed bitfield (e.g. Body::Hands::Input::HandGestureEngine), instead of the
+    /// gesture sensors. Must be called before init().
+    void setGestures(GestureSensor* gestures, const GestureBits& bits)
+    {
+        this->gestures_ = gestures;
+        this->gesture_bits_ = bits;
+    }
 
     void resetCalibration()
     {
         for (const auto& calibrated_input : this->calibrated_inputs_) {
             calibrated_input->resetCalibration();
         }
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+        this->table_.resetCalibration();
+#endif
     }
 
     void startCalibration()
@@ -156,6 +234,9 @@ class InputSensors : public og::InputPeripheral<FloatSensor*, BinarySensor*> {
         for (const auto& calibrated_input : this->calibrated_inputs_) {
             calibrated_input->startCalibration();
         }
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+        this->table_.startCalibration();
+#endif
     }
 
     void stopCalibration()
@@ -163,10 +244,129 @@ class InputSensors : public og::InputPeripheral<FloatSensor*, BinarySensor*> {
         for (const auto& calibrated_input : this->calibrated_inputs_) {
             calibrated_input->stopCalibration();
         }
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+        this->table_.stopCalibration();
+#endif
+    }
+
+    /// Replace the contents of the store with the learned ranges of all the calibrated inputs. Does not write it.
+    ///
+    /// The ranges are keyed by the analog channel (see forEachAnalogChannel), so they survive the changes of the
+    /// other inputs.
+    void saveCalibration(CalibrationStore& store)
+    {
+        store.getBlob().clear();
+
+        forEachAnalogChannel(*this, [this, &store](const std::size_t channel, FloatSensor* sensor) {
+            if (sensor == nullptr) {
+                return;
+            }
+
+            const auto index = static_cast<std::uint8_t>(channel);
+            auto* calibrator = sensor->getCalibrator();
+            if (calibrator != nullptr) {
+                store.collect(index, *calibrator);
+                return;
+            }
+
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+            ::SenseShift::Input::Calibration::CalibrationRange<float> range{};
+            if (this->table_.getCalibrationRange(channel, range)) {
+                store.getBlob().set(index, range);
+            }
+#endif
+        });
+    }
+
+    /// Restore the learned ranges of the calibrated inputs from the (loaded) store.
+    ///
+    /// \return Number of the restored inputs.
+    auto restoreCalibration(const CalibrationStore& store) -> std::size_t
+    {
+        std::size_t restored = 0;
+
+        forEachAnalogChannel(*this, [this, &store, &restored](const std::size_t channel, FloatSensor* sensor) {
+            if (sensor == nullptr) {
+                return;
+            }
+
+            const auto index = static_cast<std::uint8_t>(channel);
+            auto* calibrator = sensor->getCalibrator();
+            if (calibrator != nullptr) {
+                restored += store.restore(index, *calibrator) ? 1 : 0;
+                return;
+            }
+
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+            ::SenseShift::Input::Calibration::CalibrationRange<float> range{};
+            if (store.getBlob().get(index, range) && this->table_.setCalibrationRange(channel, range)) {
+                restored++;
+            }
+#endif
+        });
+
+        return restored;
     }
 
   private:
     std::set<FloatSensor*> calibrated_inputs_{};
+    ::SenseShift::Input::SensorGraph graph_{};
+
+    GestureSensor* gestures_ = nullptr;
+    GestureBits gesture_bits_{};
+
+#if defined(SS_OG_SENSOR_TABLE_ENABLED) && SS_OG_SENSOR_TABLE_ENABLED == true
+    AnalogSensorTable<og::InputPeripheralData> table_{};
+
+    template<typename Getter>
+    void collectBinaryData(og::InputPeripheralData& data, Getter getter)
+    {
+        if (this->joystick.press != nullptr) {
+            data.joystick.press = (this->joystick.press->*getter)();
+        }
+
+        for (auto i = 0; i < this->buttons.size(); i++) {
+            auto* button = this->buttons[i].press;
+            if (button != nullptr) {
+                data.buttons[i].press = (button->*getter)();
+            }
+        }
+
+        for (auto i = 0; i < this->analog_buttons.size(); i++) {
+            auto* button = this->analog_buttons[i].press;
+            if (button != nullptr) {
+                data.analog_buttons[i].press = (button->*getter)();
+            }
+        }
+    }
+#endif
+
+    void collectGestureData(og::InputPeripheralData& data)
+    {
+        if (this->gestures_ == nullptr) {
+            return;
+        }
+
+        const auto mask = this->gestures_->getValue();
+        const auto isSet = [mask](const std::int8_t bit) { return ((mask >> bit) & 1U) != 0; };
+
+        if (this->gesture_bits_.trigger >= 0) {
+            data.trigger.press = isSet(this->gesture_bits_.trigger);
+        }
+        if (this->gesture_bits_.grab >= 0) {
+            data.grab.press = isSet(this->gesture_bits_.grab);
+        }
+        if (this->gesture_bits_.pinch >= 0) {
+            data.pinch.press = isSet(this->gesture_bits_.pinch);
+        }
+    }
+
+    void addSensor(::SenseShift::Input::ISensorNode* sensor)
+    {
+        if (sensor != nullptr) {
+            this->graph_.add(sensor);
+        }
+    }
 };
 
 using FloatOutput = ::SenseShift::Output::IFloatOutput;
@@ -3,7 +3,10 @@
 #include <Arduino.h>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -11,8 +14,10 @@
 
 #include "senseshift/opengloves/opengloves.hpp"
 #include <senseshift/opengloves/opengloves_plotter.hpp>
+#include <senseshift/opengloves/send_on_change.hpp>
 
 #include <senseshift/core/component.hpp>
+#include <senseshift/core/profiling.hpp>
 
 namespace SenseShift::OpenGloves {
 template<typename T>
@@ -21,23 +26,55 @@ class OpenGlovesTrackingComponent {
     // Plotter calibrated_plotter_ = Plotter(&Serial, "Cal");
 
   public:
+    enum Stage : std::size_t {
+        STAGE_TICK,
+        STAGE_COLLECT,
+        STAGE_ENCODE,
+        STAGE_SEND,
+        STAGE_COUNT,
+    };
+    static constexpr std::array<const char*, STAGE_COUNT> STAGE_NAMES = { "tick", "collect", "encode", "send" };
+
+    using TickStageTimer = ::SenseShift::ProfilingStageTimer<STAGE_COUNT>;
+
     class Config {
         friend class OpenGlovesTrackingComponent;
         size_t calibration_duration_ms_;
         bool always_calibrate_;
+        std::optional<SendOnChangeConfig> send_on_change_;
 
       public:
         /// \param updateRate The rate at which the sensors should be updated in Hz.
         /// \param calibrationDuration The duration in milliseconds that the calibration button should be held for.
-        Config(size_t calibration_duration_ms, bool always_calibrate) :
-          calibration_duration_ms_(calibration_duration_ms), always_calibrate_(always_calibrate)
+        /// \param sendOnChange Only send the frames, that changed, or are due to keepalive. Every frame is sent if
+        /// empty.
+        Config(
+          size_t calibration_duration_ms,
+          bool always_calibrate,
+          std::optional<SendOnChangeConfig> send_on_change = std::nullopt
+        ) :
+          calibration_duration_ms_(calibration_duration_ms),
+          always_calibrate_(always_calibrate),
+          send_on_change_(send_on_change)
         {
         }
     };
 
-    OpenGlovesTrackingComponent(const Config& config, InputSensors& input_sensors, ITransport* communication) :
-      config_(config), input_sensors_(std::move(input_sensors)), communication_(communication)
+    /// \param calibration_store Where to persist the calibration across reboots. Nothing is persisted, if null.
+    OpenGlovesTrackingComponent(
+      const Config& config,
+      InputSensors& input_sensors,
+      ITransport* communication,
+      CalibrationStore* calibration_store = nullptr
+    ) :
+      config_(config),
+      input_sensors_(std::move(input_sensors)),
+      communication_(communication),
+      calibration_store_(calibration_store)
     {
+        if (config.send_on_change_.has_value()) {
+            this->send_gate_.emplace(config.send_on_change_.value());
+        }
     }
 
     void init()
@@ -45,23 +82,29 @@ class OpenGlovesTrackingComponent {
         this->communication_->init();
         this->input_sensors_.init();
 
+        bool restored = false;
+        if (this->calibration_store_ != nullptr && this->calibration_store_->load()) {
+            const auto count = this->input_sensors_.restoreCalibration(*this->calibration_store_);
+            log_i("Restored calibration of %u inputs", static_cast<unsigned>(count));
+            restored = count > 0;
+        }
+
         // If the calibration button is not present, start calibration immediately.
+        // The restored ranges are kept, so the tracking is usable right away, and only gets refined.
         if (this->config_.always_calibrate_ || this->input_sensors_.button_calibrate.press == nullptr) {
-            this->startCalibration();
+            this->startCalibration(!restored);
         }
     }
 
     void tick()
     {
-        // const auto start = micros();
+        this->stage_timer_.start();
 
-        // auto now = micros();
         this->input_sensors_.tick();
-        // const auto tickTime = micros() - now;
+        this->stage_timer_.lap(STAGE_TICK);
 
-        // now = micros();
         const auto data = this->input_sensors_.collectData();
-        // const auto collectTime = micros() - now;
+        this->stage_timer_.lap(STAGE_COLLECT);
 
         // const auto raw_data = this->input_sensors_.collectRawData();
         // this->raw_plotter_.plot(raw_data);
@@ -71,13 +114,30 @@ class OpenGlovesTrackingComponent {
             this->startCalibration();
         }
 
-        // now = micros();
-        const auto length = T::encodeInput(data, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
-        // const auto encodeTime = micros() - now;
+        if (this->calibration_reset_requested_.exchange(false)) {
+            this->resetCalibration();
+        }
 
-        // now = micros();
-        this->communication_->send(buffer.data(), length);
-        // const auto sendTime = micros() - now;
+        // The report must not be replaced by the input frame, so it is sent reliably, right before it
+        bool report_sent = false;
+        if (this->report_requested_.load()) {
+            const auto length = this->stage_timer_.format(this->buffer.data(), this->buffer.size(), STAGE_NAMES);
+            report_sent = length > 0 && this->communication_->sendReliable(this->buffer.data(), length) > 0;
+            if (report_sent || length == 0) {
+                this->report_requested_ = false;
+            }
+        }
+
+        if (report_sent || !this->send_gate_.has_value() || this->send_gate_->shouldSend(data, millis())) {
+            const auto length = T::encodeInput(data, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+            this->stage_timer_.lap(STAGE_ENCODE);
+
+            this->communication_->send(buffer.data(), length);
+            this->stage_timer_.lap(STAGE_SEND);
+            this->frames_sent_++;
+        } else {
+            this->frames_skipped_++;
+        }
 
         if (!this->config_.always_calibrate_ && this->calibration_start_time_ != 0) {
             const auto calibration_elapsed = millis() - this->calibration_start_time_;
@@ -88,24 +148,54 @@ class OpenGlovesTrackingComponent {
             }
         }
 
-        // const auto total = micros() - start;
-        // log_i(
-        //   "total: %d, tick: %d, collect: %d, encode: %d, send: %d, c/s: %.2f",
-        //   total,
-        //   tickTime,
-        //   collectTime,
-        //   encodeTime,
-        //   sendTime,
-        //   1000000.0 / total
-        // );
+        // Continuous calibration never stops, so its ranges are saved periodically instead (only if they changed).
+        if (this->config_.always_calibrate_ && this->calibration_store_ != nullptr
+            && millis() - this->calibration_saved_time_ >= CALIBRATION_SAVE_INTERVAL_MS) {
+            this->saveCalibration();
+            this->calibration_saved_time_ = millis();
+        }
+    }
+
+    /// Number of the input frames, that were sent.
+    [[nodiscard]] auto getFramesSent() const -> std::uint32_t
+    {
+        return this->frames_sent_;
+    }
+
+    /// Number of the input frames, that were not sent, as nothing changed.
+    [[nodiscard]] auto getFramesSkipped() const -> std::uint32_t
+    {
+        return this->frames_skipped_;
+    }
+
+    /// Per-stage timings of the tick. Records nothing, unless SS_PROFILING_ENABLED is set.
+    [[nodiscard]] auto getStageTimer() const -> const TickStageTimer&
+    {
+        return this->stage_timer_;
+    }
+
+    /// Send the stage timings report right before the next input frame. Can be called from any task.
+    void requestStageReport()
+    {
+        this->report_requested_ = true;
+    }
+
+    /// Forget the calibration, the stored one included, and start calibrating anew on the next tick. Can be called
+    /// from any task.
+    void requestCalibrationReset()
+    {
+        this->calibration_reset_requested_ = true;
     }
 
   protected:
-    void startCalibration()
+    /// \param reset Whether to forget the current ranges first.
+    void startCalibration(const bool reset = true)
     {
         if (this->calibration_start_time_ == 0) {
             log_i("Starting calibration");
-            this->input_sensors_.resetCalibration();
+            if (reset) {
+                this->input_sensors_.resetCalibration();
+            }
             this->input_sensors_.startCalibration();
         }
 
@@ -117,21 +207,65 @@ class OpenGlovesTrackingComponent {
         log_i("Stopping calibration");
         this->input_sensors_.stopCalibration();
         this->calibration_start_time_ = 0;
+
+        if (this->calibration_store_ != nullptr) {
+            this->saveCalibration();
+        }
+    }
+
+    void resetCalibration()
+    {
+        log_i("Resetting calibration");
+
+        if (this->calibration_store_ != nullptr) {
+            this->calibration_store_->getBlob().clear();
+            if (!this->calibration_store_->save()) {
+                log_e("Failed to clear the saved calibration");
+            }
+        }
+
+        // Restarted, so the current ranges are dropped even if it is already calibrating
+        this->calibration_start_time_ = 0;
+        this->startCalibration(true);
+    }
+
+    void saveCalibration()
+    {
+        this->input_sensors_.saveCalibration(*this->calibration_store_);
+        if (!this->calibration_store_->save()) {
+            log_e("Failed to save calibration");
+        }
     }
 
   private:
+    /// How often the continuous calibration is saved, in milliseconds.
+    static constexpr unsigned long CALIBRATION_SAVE_INTERVAL_MS = 60000;
+
     std::array<char, 256> buffer = {};
 
     unsigned long long calibration_start_time_ = 0;
+    unsigned long calibration_saved_time_ = 0;
 
     Config config_;
     InputSensors input_sensors_;
     ITransport* communication_;
+    CalibrationStore* calibration_store_;
+
+    std::optional<SendOnChangeGate<og::InputPeripheralData>> send_gate_;
+    std::uint32_t frames_sent_ = 0;
+    std::uint32_t frames_skipped_ = 0;
+
+    TickStageTimer stage_timer_{};
+    std::atomic<bool> report_requested_{ false };
+    std::atomic<bool> calibration_reset_requested_{ false };
 };
 
 template<typename T>
 class OpenGlovesForceFeedbackComponent {
   public:
+    /// Handles the incoming non-FFB commands, returns `true` if the command was consumed.
+    using CommandHandler = std::function<bool(const char* command, size_t length)>;
+
     OpenGlovesForceFeedbackComponent(
       OutputWriters& output_writers, ::SenseShift::OpenGloves::ITransport* communication
     ) :
@@ -146,10 +280,20 @@ class OpenGlovesForceFeedbackComponent {
         this->output_writers_.init();
     }
 
+    /// Set the handler, that gets every incoming command before it is decoded as force feedback.
+    void setCommandHandler(CommandHandler handler)
+    {
+        this->command_handler_ = std::move(handler);
+    }
+
     void tick()
     {
         if (this->communication_->hasData()) {
             const auto length = this->communication_->read(this->buffer.data(), this->buffer.size());
+            if (this->command_handler_ && this->command_handler_(this->buffer.data(), length)) {
+                return;
+            }
+
             const auto output = T::decodeOutput(reinterpret_cast<const uint8_t*>(this->buffer.data()), length);
             this->output_writers_.apply(output);
         }
@@ -160,5 +304,6 @@ class OpenGlovesForceFeedbackComponent {
 
     OutputWriters output_writers_;
     ::SenseShift::OpenGloves::ITransport* communication_;
+    CommandHandler command_handler_{};
 };
 } // namespace SenseShift::OpenGloves
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <senseshift/opengloves/transport.hpp>
+
+namespace SenseShift::OpenGloves {
+/// Outgoing frame, copied into the TX queue.
+template<std::size_t N>
+struct TransportFrame {
+    std::array<char, N> data;
+    std::size_t length;
+};
+
+/// Transport decorator, that moves the writes onto a dedicated writer.
+///
+/// Only the newest unsent frame is kept: tracking frames carry the full state, so the older ones are useless to the
+/// driver, and are dropped instead of delaying the newer ones. The sender never waits for the radio. A reliable frame
+/// (see sendReliable()) has its own slot, and is written right before the next regular one.
+/// Reads are passed to the wrapped transport as-is.
+///
+/// \tparam Worker Mailbox worker, handling TransportFrame values (e.g. FreeRTOS::MailboxTask or ThreadMailboxWorker).
+///
+/// \example
+/// \code
+/// auto* transport = new QueuedTransport<FreeRTOS::MailboxTask<TransportFrame<256>>>(
+///   new StreamTransport(Serial),
+///   FreeRTOS::TaskConfig{ .name = "OG_TX", .stackDepth = 4096, .priority = 2 }
+/// );
+/// \endcode
+template<typename Worker>
+class QueuedTransport : public ITransport {
+  public:
+    using Frame = typename Worker::ValueType;
+
+    /// \param transport The wrapped transport, only used from the writer for sending.
+    /// \param workerArgs Arguments of the worker, after the handler (e.g. the task config).
+    template<typename... Args>
+    explicit QueuedTransport(ITransport* transport, Args&&... workerArgs) :
+      transport_(transport),
+      worker_([this](const Frame& frame) -> void { this->write(frame); }, std::forward<Args>(workerArgs)...)
+    {
+    }
+
+    /// Initialize the wrapped transport, and start the writer. Safe to call from multiple components.
+    void init() override
+    {
+        this->transport_->init();
+
+        if (!this->started_.exchange(true)) {
+            this->worker_.begin();
+        }
+    }
+
+    /// Queue the frame for sending, replacing the unsent one. Must be called from a single task.
+    ///
+    /// \return Number of the queued bytes.
+    auto send(const char* buffer, size_t length) -> size_t override
+    {
+        Frame frame;
+        frame.length = std::min(length, frame.data.size());
+        std::memcpy(frame.data.data(), buffer, frame.length);
+
+        this->worker_.publish(frame);
+        return frame.length;
+    }
+
+    /// Put the frame into the reliable slot, it is written right before the next regular frame, so it must be followed
+    /// by send(). Must be called from the same task as send().
+    ///
+    /// \return Number of the queued bytes, 0 if the previous reliable frame is not written yet.
+    auto sendReliable(const char* buffer, size_t length) -> size_t override
+    {
+        if (this->reliable_pending_.load(std::memory_order_acquire)) {
+            return 0;
+        }
+
+        this->reliable_.length = std::min(length, this->reliable_.data.size());
+        std::memcpy(this->reliable_.data.data(), buffer, this->reliable_.length);
+
+        this->reliable_pending_.store(true, std::memory_order_release);
+        return this->reliable_.length;
+    }
+
+    auto hasData() -> bool override
+    {
+        return this->transport_->hasData();
+    }
+
+    auto read(char* buffer, size_t length) -> size_t override
+    {
+        return this->transport_->read(buffer, length);
+    }
+
+    /// Number of the frames, that were superseded by the newer ones before being sent.
+    [[nodiscard]] auto getDroppedCount() const -> std::uint32_t
+    {
+        return this->worker_.getMailbox().getOverwrittenCount();
+    }
+
+    [[nodiscard]] auto getWorker() -> Worker&
+    {
+        return this->worker_;
+    }
+
+  private:
+    ITransport* transport_;
+    Worker worker_;
+    std::atomic<bool> started_{ false };
+
+    /// Only written by the sender while not pending, and only read by the writer while pending.
+    Frame reliable_{};
+    std::atomic<bool> reliable_pending_{ false };
+
+    void write(const Frame& frame)
+    {
+        if (this->reliable_pending_.load(std::memory_order_acquire)) {
+            this->transport_->send(this->reliable_.data.data(), this->reliable_.length);
+            this->reliable_pending_.store(false, std::memory_order_release);
+        }
+
+        this->transport_->send(frame.data.data(), frame.length);
+    }
+};
+} // namespace SenseShift::OpenGloves
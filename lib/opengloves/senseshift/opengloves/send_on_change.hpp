@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace SenseShift::OpenGloves {
+/// Thresholds of the send-on-change mode, in the steps of the encoded values. The analog values are normalized to
+/// [0, 1], and compared as the encoder sends them: scaled to [0, analog_max], and truncated. So the frames, that would
+/// be encoded the same, are never sent twice, and a threshold of 1 sends any change of the encoded value.
+struct SendOnChangeConfig {
+    /// Max value of the encoded analog values (4095 for the 12-bit encoding).
+    std::uint16_t analog_max = 4095;
+    /// Min change of a finger joint curl, that is sent.
+    std::uint16_t curl_threshold = 1;
+    /// Min change of a finger splay, that is sent.
+    std::uint16_t splay_threshold = 1;
+    /// Min change of a joystick axis, that is sent.
+    std::uint16_t joystick_threshold = 1;
+    /// Min change of an analog button value (e.g. trigger), that is sent.
+    std::uint16_t analog_button_threshold = 1;
+    /// Max time between two sent frames, in milliseconds, even if nothing changes.
+    std::uint32_t keepalive_ms = 1000;
+};
+
+/// Whether any encoded field of the input data changed by at least its threshold. Digital buttons are compared exactly.
+///
+/// \tparam Data og::InputPeripheralData, or a type of the same shape.
+template<typename Data>
+auto hasSignificantChange(const Data& previous, const Data& current, const SendOnChangeConfig& config) -> bool
+{
+    const auto scale = static_cast<float>(config.analog_max);
+    const auto differs = [scale](const float a, const float b, const std::uint16_t threshold) -> bool {
+        const auto encoded_a = static_cast<std::int32_t>(a * scale);
+        const auto encoded_b = static_cast<std::int32_t>(b * scale);
+        return std::abs(encoded_a - encoded_b) >= threshold;
+    };
+
+    for (std::size_t i = 0; i < current.curl.fingers.size(); i++) {
+        const auto& previous_curl = previous.curl.fingers[i].curl;
+        const auto& current_curl = current.curl.fingers[i].curl;
+        for (std::size_t j = 0; j < current_curl.size(); j++) {
+            if (differs(previous_curl[j], current_curl[j], config.curl_threshold)) {
+                return true;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < current.splay.fingers.size(); i++) {
+        if (differs(previous.splay.fingers[i], current.splay.fingers[i], config.splay_threshold)) {
+            return true;
+        }
+    }
+
+    if (differs(previous.joystick.x, current.joystick.x, config.joystick_threshold)
+        || differs(previous.joystick.y, current.joystick.y, config.joystick_threshold)
+        || previous.joystick.press != current.joystick.press) {
+        return true;
+    }
+
+    for (std::size_t i = 0; i < current.buttons.size(); i++) {
+        if (previous.buttons[i].press != current.buttons[i].press) {
+            return true;
+        }
+    }
+
+    for (std::size_t i = 0; i < current.analog_buttons.size(); i++) {
+        if (previous.analog_buttons[i].press != current.analog_buttons[i].press
+            || differs(
+              previous.analog_buttons[i].value,
+              current.analog_buttons[i].value,
+              config.analog_button_threshold
+            )) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Decides which input frames are worth sending: the ones, that differ from the last sent frame, and the keepalive
+/// ones. Small changes are compared against the last *sent* frame, so slow drift is still sent eventually.
+///
+/// \tparam Data og::InputPeripheralData, or a type of the same shape.
+template<typename Data>
+class SendOnChangeGate {
+  public:
+    explicit SendOnChangeGate(const SendOnChangeConfig& config) : config_(config)
+    {
+    }
+
+    /// \param data The frame, that is about to be sent.
+    /// \param now_ms Current time, in milliseconds.
+    /// \return Whether the frame should be sent. If so, it becomes the new reference frame.
+    auto shouldSend(const Data& data, const std::uint32_t now_ms) -> bool
+    {
+        const bool keepalive = (now_ms - this->last_sent_ms_) >= this->config_.keepalive_ms;
+        if (this->has_sent_ && !keepalive && !hasSignificantChange(this->last_sent_, data, this->config_)) {
+            return false;
+        }
+
+        this->last_sent_ = data;
+        this->last_sent_ms_ = now_ms;
+        this->has_sent_ = true;
+        return true;
+    }
+
+    [[nodiscard]] auto getConfig() const -> const SendOnChangeConfig&
+    {
+        return this->config_;
+    }
+
+  private:
+    SendOnChangeConfig config_;
+
+    Data last_sent_{};
+    std::uint32_t last_sent_ms_ = 0;
+    bool has_sent_ = false;
+};
+} // namespace SenseShift::OpenGloves
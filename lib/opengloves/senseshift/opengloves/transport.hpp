@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+#include <senseshift/core/component.hpp>
+
+namespace SenseShift::OpenGloves {
+class ITransport : public IInitializable {
+  public:
+    virtual auto send(const char* buffer, size_t length) -> size_t = 0;
+
+    /// Send the frame, that must not be dropped in favour of the newer ones (e.g. a report), unlike the tracking frames.
+    ///
+    /// \return Number of the sent bytes, 0 if it can not be sent now.
+    virtual auto sendReliable(const char* buffer, size_t length) -> size_t
+    {
+        return this->send(buffer, length);
+    }
+
+    virtual auto hasData() -> bool = 0;
+    virtual auto read(char* buffer, size_t length) -> size_t = 0;
+};
+} // namespace SenseShift::OpenGloves
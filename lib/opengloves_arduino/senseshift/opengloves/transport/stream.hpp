@@ -8,13 +8,14 @@
 #include <Print.h>
 #include <WiFi.h>
 
+#include <senseshift/opengloves/line_framer.hpp>
 #include <senseshift/opengloves/opengloves.hpp>
 
 namespace SenseShift::OpenGloves {
 class IStreamTransport : public ITransport {
   protected:
     Stream* channel;
-    std::array<char, 256> buffer_{};
+    LineFramer<256> framer_{};
 
   public:
     IStreamTransport(Stream* channel) : channel(channel)
@@ -35,21 +36,26 @@ class IStreamTransport : public ITransport {
 
     virtual auto isReady() -> bool = 0;
 
+    /// Whether a complete command was received. Takes the available bytes, but never waits for the rest of the line.
     auto hasData() -> bool override
     {
-        return this->isReady() && this->channel != nullptr && this->channel->available() > 0;
+        this->receive();
+        return this->framer_.hasFrame();
     }
 
+    /// Read the newest complete command, the older unread ones are dropped.
     auto read(char* buffer, size_t length) -> size_t override
     {
-        if (!this->hasData()) {
-            return 0U;
-        }
-
-        size_t bytesRead = this->channel->readBytesUntil('\n', buffer, length);
-        buffer[bytesRead] = '\0';
+        this->receive();
+        return this->framer_.read(buffer, length);
+    }
 
-        return bytesRead;
+  private:
+    void receive()
+    {
+        if (this->isReady() && this->channel != nullptr) {
+            this->framer_.feed(*this->channel);
+        }
     }
 };
 
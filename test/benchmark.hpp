@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/// Average time of a single \p fn call, in nanoseconds.
+///
+/// \param fn Called as `fn(i)`, with the index of the iteration.
+template<typename Fn>
+auto benchmark_ns(std::size_t iterations, Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++) {
+        fn(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
@@ -0,0 +1,134 @@
+// Not known for the native platform
+#define ANALOG_MAX 4095.0F
+
+#include <ArduinoFake.h>
+#include <senseshift/arduino/input/sensor/multiplexer.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <unity.h>
+
+#include <cstdint>
+
+using namespace fakeit;
+using namespace SenseShift::Arduino::Input;
+
+void setUp(void)
+{
+    ArduinoFakeReset();
+
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalWrite)).AlwaysReturn();
+    When(Method(ArduinoFake(), delayMicroseconds)).AlwaysReturn();
+    When(Method(ArduinoFake(), analogRead)).AlwaysReturn(0);
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+void test_multiplexer_init(void)
+{
+    Multiplexer<4> mux({ 2, 3, 4, 5 });
+    mux.init();
+
+    for (const std::uint8_t pin : { 2, 3, 4, 5 }) {
+        Verify(Method(ArduinoFake(), pinMode).Using(pin, OUTPUT)).Once();
+        Verify(Method(ArduinoFake(), digitalWrite).Using(pin, LOW)).Once();
+    }
+    Verify(Method(ArduinoFake(), digitalWrite)).Exactly(4);
+}
+
+void test_multiplexer_writes_changed_pins(void)
+{
+    Multiplexer<4> mux({ 2, 3, 4, 5 });
+    mux.init();
+    ArduinoFake().ClearInvocationHistory();
+
+    mux.selectChannel(0b0101);
+    Verify(Method(ArduinoFake(), digitalWrite).Using(2, HIGH)).Once();
+    Verify(Method(ArduinoFake(), digitalWrite).Using(4, HIGH)).Once();
+    Verify(Method(ArduinoFake(), digitalWrite)).Exactly(2);
+
+    // Already active
+    ArduinoFake().ClearInvocationHistory();
+    mux.selectChannel(0b0101);
+    Verify(Method(ArduinoFake(), digitalWrite)).Never();
+    Verify(Method(ArduinoFake(), delayMicroseconds)).Never();
+
+    ArduinoFake().ClearInvocationHistory();
+    mux.selectChannel(0b1100);
+    Verify(Method(ArduinoFake(), digitalWrite).Using(2, LOW)).Once();
+    Verify(Method(ArduinoFake(), digitalWrite).Using(5, HIGH)).Once();
+    Verify(Method(ArduinoFake(), digitalWrite)).Exactly(2);
+    Verify(Method(ArduinoFake(), delayMicroseconds)).Once();
+
+    // Out of range
+    ArduinoFake().ClearInvocationHistory();
+    mux.selectChannel(16);
+    Verify(Method(ArduinoFake(), digitalWrite)).Never();
+}
+
+void test_scanner_fewer_writes_than_binary_order(void)
+{
+    auto* mux = new Multiplexer<4>({ 2, 3, 4, 5 });
+    auto* scanner = new MultiplexerScanner<4>(mux, new AnalogSimpleSensor(36));
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        scanner->addChannel(channel, new ::SenseShift::Input::FloatSensor());
+    }
+    scanner->init();
+
+    // First pass starts at channel 0, which is already active
+    ArduinoFake().ClearInvocationHistory();
+    scanner->tick();
+    Verify(Method(ArduinoFake(), digitalWrite)).Exactly(15);
+
+    // A single pin per channel, including the wrap-around from the last channel back to channel 0
+    ArduinoFake().ClearInvocationHistory();
+    scanner->tick();
+    Verify(Method(ArduinoFake(), digitalWrite)).Exactly(16);
+
+    Multiplexer<4> binary_mux({ 2, 3, 4, 5 });
+    binary_mux.init();
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        binary_mux.selectChannel(channel);
+    }
+
+    ArduinoFake().ClearInvocationHistory();
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        binary_mux.selectChannel(channel);
+    }
+    Verify(Method(ArduinoFake(), digitalWrite)).Exactly(30);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_multiplexer_init);
+    RUN_TEST(test_multiplexer_writes_changed_pins);
+    RUN_TEST(test_scanner_fewer_writes_than_binary_order);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
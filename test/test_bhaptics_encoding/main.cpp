@@ -1,7 +1,11 @@
+#include <benchmark.hpp>
 #include <senseshift/bh/devices.hpp>
 #include <senseshift/bh/encoding.hpp>
 #include <unity.h>
 
+#include <cstdio>
+#include <map>
+
 using namespace SenseShift::BH;
 using namespace SenseShift::Body::Haptics;
 using namespace SenseShift::Output;
@@ -265,6 +269,294 @@ void test_layout_tactglove(void)
     ASSERT_EQUAL_FLOAT_ROUNDED(3931.0F / 4095.0F, actuatorWrist->intensity, 2);
 }
 
+/// Create a body with an actuator for every distinct (target, position) pair of the layout.
+template<size_t N>
+auto make_body(const std::array<OutputLayout, N>& layout) -> FloatBody*
+{
+    std::map<Target, FloatPlane::ActuatorMap> targets{};
+    for (const auto& [target, position] : layout) {
+        auto& outputs = targets[target];
+        if (outputs.count(position) == 0) {
+            outputs[position] = new TestActuator();
+        }
+    }
+
+    auto body = new FloatBody();
+    for (const auto& [target, outputs] : targets) {
+        body->addTarget(target, new FloatDensePlane(outputs));
+    }
+
+    return body;
+}
+
+/// Create a body with an actuator for every position of the layout on the single target.
+template<size_t N>
+auto make_body(const Target target, const std::array<Position, N>& layout) -> FloatBody*
+{
+    FloatPlane::ActuatorMap outputs{};
+    for (const auto& position : layout) {
+        outputs[position] = new TestActuator();
+    }
+
+    auto body = new FloatBody();
+    body->addTarget(target, new FloatDensePlane(outputs));
+
+    return body;
+}
+
+template<size_t N>
+auto make_packet(std::size_t seed, std::uint8_t maxValue = 0xff) -> std::array<std::uint8_t, N>
+{
+    std::array<std::uint8_t, N> packet{};
+    for (size_t i = 0; i < N; i++) {
+        packet[i] = static_cast<std::uint8_t>((seed * 31 + i * 7) % (maxValue + 1U));
+    }
+
+    return packet;
+}
+
+template<size_t N>
+void assert_bindings_equal(const FloatBody::LayoutBinding<N>& expected, const FloatBody::LayoutBinding<N>& actual)
+{
+    for (size_t i = 0; i < N; i++) {
+        TEST_ASSERT_NOT_NULL(expected.getActuator(i));
+        TEST_ASSERT_NOT_NULL(actual.getActuator(i));
+        TEST_ASSERT_EQUAL_FLOAT(
+          static_cast<TestActuator*>(expected.getActuator(i))->intensity,
+          static_cast<TestActuator*>(actual.getActuator(i))->intensity
+        );
+    }
+}
+
+void test_binding_resolves_actuators(void)
+{
+    auto actuator0 = new TestActuator(), actuator1 = new TestActuator();
+
+    auto body = new FloatBody();
+    body->addTarget(Target::ChestFront, new FloatDensePlane({ { { 0, 0 }, actuator0 }, { { 0, 1 }, actuator1 } }));
+
+    const std::array<OutputLayout, 4> layout = { {
+      { Target::ChestFront, { 0, 1 } },
+      { Target::ChestFront, { 0, 0 } },
+      { Target::ChestFront, { 1, 1 } }, // unknown position
+      { Target::ChestBack, { 0, 0 } },  // unknown target
+    } };
+    const auto binding = body->bindLayout(layout);
+
+    TEST_ASSERT_EQUAL_PTR(actuator1, binding.getActuator(0));
+    TEST_ASSERT_EQUAL_PTR(actuator0, binding.getActuator(1));
+    TEST_ASSERT_NULL(binding.getActuator(2));
+    TEST_ASSERT_NULL(binding.getActuator(3));
+
+    // Unbound indices are skipped
+    Decoder::applyPlain(binding, { 0x32, 0x64, 0x64, 0x64 });
+    ASSERT_EQUAL_FLOAT_ROUNDED(1.0F, actuator0->intensity, 2);
+    ASSERT_EQUAL_FLOAT_ROUNDED(0.5F, actuator1->intensity, 2);
+}
+
+void test_binding_tactsuitx40(void)
+{
+    static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX40_SIZE> bhLayout = { BH_LAYOUT_TACTSUITX40 };
+
+    auto legacyBody = make_body(bhLayout);
+    auto boundBody = make_body(bhLayout);
+    const auto legacyBinding = legacyBody->bindLayout(bhLayout);
+    const auto boundBinding = boundBody->bindLayout(bhLayout);
+
+    for (std::size_t seed = 0; seed < 16; seed++) {
+        const auto packet = make_packet<Decoder::VEST_PAYLOAD_SIZE>(seed);
+
+        Decoder::applyVest(legacyBody, packet, bhLayout);
+        Decoder::applyVest(boundBinding, packet);
+
+        assert_bindings_equal(legacyBinding, boundBinding);
+    }
+}
+
+void test_binding_tactsuitx16(void)
+{
+    static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX16_SIZE> bhLayout = { BH_LAYOUT_TACTSUITX16 };
+    static const std::array<std::uint8_t, BH_LAYOUT_TACTSUITX16_GROUPS_SIZE> layoutGroups =
+      BH_LAYOUT_TACTSUITX16_GROUPS;
+
+    auto legacyBody = make_body(bhLayout);
+    auto boundBody = make_body(bhLayout);
+    const auto legacyBinding = legacyBody->bindLayout(bhLayout);
+    const auto boundBinding = boundBody->bindLayout(bhLayout);
+
+    for (std::size_t seed = 0; seed < 16; seed++) {
+        const auto packet = make_packet<Decoder::VEST_PAYLOAD_SIZE>(seed);
+
+        Decoder::applyVestGrouped(legacyBody, packet, bhLayout, layoutGroups);
+        Decoder::applyVestGrouped(boundBinding, packet, layoutGroups);
+
+        assert_bindings_equal(legacyBinding, boundBinding);
+    }
+}
+
+void test_binding_tactal(void)
+{
+    static const std::array<Position, BH_LAYOUT_TACTAL_SIZE> bhLayout = { BH_LAYOUT_TACTAL };
+
+    auto legacyBody = make_body(Target::FaceFront, bhLayout);
+    auto boundBody = make_body(Target::FaceFront, bhLayout);
+    const auto legacyBinding = legacyBody->bindLayout(Target::FaceFront, bhLayout);
+    const auto boundBinding = boundBody->bindLayout(Target::FaceFront, bhLayout);
+
+    for (std::size_t seed = 0; seed < 16; seed++) {
+        const auto packet = make_packet<BH_LAYOUT_TACTAL_SIZE>(seed, 100);
+
+        Decoder::applyPlain(legacyBody, packet, bhLayout, Effect::Vibro, Target::FaceFront);
+        Decoder::applyPlain(boundBinding, packet);
+
+        assert_bindings_equal(legacyBinding, boundBinding);
+    }
+}
+
+void test_binding_raw_bytes(void)
+{
+    static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX40_SIZE> bhLayout = { BH_LAYOUT_TACTSUITX40 };
+
+    auto body = make_body(bhLayout);
+    const auto binding = body->bindLayout(bhLayout);
+
+    const std::uint8_t full[Decoder::VEST_PAYLOAD_SIZE] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    };
+    Decoder::applyVest(binding, full, sizeof(full));
+    for (size_t i = 0; i < BH_LAYOUT_TACTSUITX40_SIZE; i++) {
+        ASSERT_EQUAL_FLOAT_ROUNDED(1.0F, static_cast<TestActuator*>(binding.getActuator(i))->intensity, 2);
+    }
+
+    // Short packet, the rest of the motors are turned off
+    const std::uint8_t partial[2] = { 0x0f, 0xf0 };
+    Decoder::applyVest(binding, partial, sizeof(partial));
+    ASSERT_EQUAL_FLOAT_ROUNDED(0, static_cast<TestActuator*>(binding.getActuator(0))->intensity, 2);
+    ASSERT_EQUAL_FLOAT_ROUNDED(1.0F, static_cast<TestActuator*>(binding.getActuator(1))->intensity, 2);
+    ASSERT_EQUAL_FLOAT_ROUNDED(1.0F, static_cast<TestActuator*>(binding.getActuator(2))->intensity, 2);
+    ASSERT_EQUAL_FLOAT_ROUNDED(0, static_cast<TestActuator*>(binding.getActuator(3))->intensity, 2);
+    for (size_t i = 4; i < BH_LAYOUT_TACTSUITX40_SIZE; i++) {
+        ASSERT_EQUAL_FLOAT_ROUNDED(0, static_cast<TestActuator*>(binding.getActuator(i))->intensity, 2);
+    }
+}
+
+template<typename Legacy, typename Bound>
+void benchmark_layout(const char* name, Legacy&& legacy, Bound&& bound)
+{
+    constexpr std::size_t iterations = 20000;
+
+    const auto legacy_ns = benchmark_ns(iterations, legacy);
+    const auto bound_ns = benchmark_ns(iterations, bound);
+
+    char message[128];
+    snprintf(
+      message,
+      sizeof(message),
+      "%s: legacy %.0f packets/s, bound %.0f packets/s",
+      name,
+      1e9 / legacy_ns,
+      1e9 / bound_ns
+    );
+    TEST_MESSAGE(message);
+}
+
+template<size_t N>
+void benchmark_plain_layout(const char* name, const Target target, const std::array<Position, N>& layout)
+{
+    auto legacyBody = make_body(target, layout);
+    auto boundBody = make_body(target, layout);
+    const auto legacyBinding = legacyBody->bindLayout(target, layout);
+    const auto boundBinding = boundBody->bindLayout(target, layout);
+
+    benchmark_layout(
+      name,
+      [&](std::size_t i) {
+          Decoder::applyPlain(legacyBody, make_packet<N>(i, 100), layout, Effect::Vibro, target);
+      },
+      [&](std::size_t i) { Decoder::applyPlain(boundBinding, make_packet<N>(i, 100)); }
+    );
+    assert_bindings_equal(legacyBinding, boundBinding);
+}
+
+void test_benchmark_layout_binding(void)
+{
+    static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX40_SIZE> x40Layout = { BH_LAYOUT_TACTSUITX40 };
+    static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX16_SIZE> x16Layout = { BH_LAYOUT_TACTSUITX16 };
+    static const std::array<std::uint8_t, BH_LAYOUT_TACTSUITX16_GROUPS_SIZE> x16Groups = BH_LAYOUT_TACTSUITX16_GROUPS;
+    static const std::array<Position, BH_LAYOUT_TACTAL_SIZE> tactalLayout = { BH_LAYOUT_TACTAL };
+    static const std::array<Position, BH_LAYOUT_TACTVISOR_SIZE> tactvisorLayout = { BH_LAYOUT_TACTVISOR };
+    static const std::array<Position, BH_LAYOUT_TACTOSY2_SIZE> tactosy2Layout = { BH_LAYOUT_TACTOSY2 };
+    static const std::array<Position, BH_LAYOUT_TACTOSYH_SIZE> tactosyhLayout = { BH_LAYOUT_TACTOSYH };
+    static const std::array<Position, BH_LAYOUT_TACTOSYF_SIZE> tactosyfLayout = { BH_LAYOUT_TACTOSYF };
+
+    {
+        auto legacyBody = make_body(x40Layout);
+        auto boundBody = make_body(x40Layout);
+        const auto legacyBinding = legacyBody->bindLayout(x40Layout);
+        const auto boundBinding = boundBody->bindLayout(x40Layout);
+
+        benchmark_layout(
+          "TactSuit X40",
+          [&](std::size_t i) {
+              Decoder::applyVest(legacyBody, make_packet<Decoder::VEST_PAYLOAD_SIZE>(i), x40Layout);
+          },
+          [&](std::size_t i) { Decoder::applyVest(boundBinding, make_packet<Decoder::VEST_PAYLOAD_SIZE>(i)); }
+        );
+        assert_bindings_equal(legacyBinding, boundBinding);
+    }
+
+    {
+        auto legacyBody = make_body(x16Layout);
+        auto boundBody = make_body(x16Layout);
+        const auto legacyBinding = legacyBody->bindLayout(x16Layout);
+        const auto boundBinding = boundBody->bindLayout(x16Layout);
+
+        benchmark_layout(
+          "TactSuit X16",
+          [&](std::size_t i) {
+              Decoder::applyVestGrouped(
+                legacyBody,
+                make_packet<Decoder::VEST_PAYLOAD_SIZE>(i),
+                x16Layout,
+                x16Groups
+              );
+          },
+          [&](std::size_t i) {
+              Decoder::applyVestGrouped(boundBinding, make_packet<Decoder::VEST_PAYLOAD_SIZE>(i), x16Groups);
+          }
+        );
+        assert_bindings_equal(legacyBinding, boundBinding);
+    }
+
+    {
+        auto legacyBody = make_body(TactGloveLeftLayout);
+        auto boundBody = make_body(TactGloveLeftLayout);
+        const auto legacyBinding = legacyBody->bindLayout(TactGloveLeftLayout);
+        const auto boundBinding = boundBody->bindLayout(TactGloveLeftLayout);
+
+        benchmark_layout(
+          "TactGlove",
+          [&](std::size_t i) {
+              Decoder::applyPlain(
+                legacyBody,
+                make_packet<BH_LAYOUT_TACTGLOVE_SIZE>(i, 100),
+                TactGloveLeftLayout,
+                Effect::Vibro
+              );
+          },
+          [&](std::size_t i) { Decoder::applyPlain(boundBinding, make_packet<BH_LAYOUT_TACTGLOVE_SIZE>(i, 100)); }
+        );
+        assert_bindings_equal(legacyBinding, boundBinding);
+    }
+
+    benchmark_plain_layout("Tactal", Target::FaceFront, tactalLayout);
+    benchmark_plain_layout("TactVisor", Target::FaceFront, tactvisorLayout);
+    benchmark_plain_layout("Tactosy2", Target::HandLeftVolar, tactosy2Layout);
+    benchmark_plain_layout("TactosyH", Target::HandLeftVolar, tactosyhLayout);
+    benchmark_plain_layout("TactosyF", Target::HandLeftVolar, tactosyfLayout);
+}
+
 int process(void)
 {
     UNITY_BEGIN();
@@ -274,6 +566,14 @@ int process(void)
     RUN_TEST(test_layout_tactal);
     RUN_TEST(test_layout_tactglove);
 
+    RUN_TEST(test_binding_resolves_actuators);
+    RUN_TEST(test_binding_tactsuitx40);
+    RUN_TEST(test_binding_tactsuitx16);
+    RUN_TEST(test_binding_tactal);
+    RUN_TEST(test_binding_raw_bytes);
+
+    RUN_TEST(test_benchmark_layout_binding);
+
     return UNITY_END();
 }
 
@@ -0,0 +1,259 @@
+#include <benchmark.hpp>
+#include <senseshift/body/hands/input/gesture.hpp>
+#include <senseshift/body/hands/input/gesture_engine.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <unity.h>
+
+#include <array>
+#include <cstdio>
+#include <random>
+
+using namespace SenseShift::Input;
+using namespace SenseShift::Body::Hands::Input;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+constexpr auto TRIGGER = static_cast<std::size_t>(HandGesture::Trigger);
+constexpr auto GRAB = static_cast<std::size_t>(HandGesture::Grab);
+constexpr auto PINCH = static_cast<std::size_t>(HandGesture::Pinch);
+
+struct TestHand {
+    FloatSensor thumb;
+    FloatSensor index;
+    FloatSensor middle;
+    FloatSensor ring;
+    FloatSensor pinky;
+
+    auto fingers() -> HandFingers
+    {
+        return { .thumb = &thumb, .index = &index, .middle = &middle, .ring = &ring, .pinky = &pinky };
+    }
+
+    void set(const std::array<float, 5>& curls)
+    {
+        this->thumb.publishState(curls[0]);
+        this->index.publishState(curls[1]);
+        this->middle.publishState(curls[2]);
+        this->ring.publishState(curls[3]);
+        this->pinky.publishState(curls[4]);
+    }
+};
+
+void test_gesture_engine_default_gestures(void)
+{
+    TestHand hand;
+    HandGestureEngine<3> engine(hand.fingers(), defaultGestures(0.5F, 0.5F, 0.5F));
+    engine.init();
+
+    engine.tick();
+    TEST_ASSERT_EQUAL_UINT32(0, engine.getValue());
+
+    hand.set({ 0.0F, 0.6F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_TRUE(engine.isActive(TRIGGER));
+    TEST_ASSERT_FALSE(engine.isActive(GRAB));
+    TEST_ASSERT_FALSE(engine.isActive(PINCH));
+
+    hand.set({ 0.6F, 0.6F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_EQUAL_UINT32((1U << TRIGGER) | (1U << PINCH), engine.getValue());
+
+    hand.set({ 0.0F, 0.6F, 0.6F, 0.6F, 0.6F });
+    engine.tick();
+    TEST_ASSERT_EQUAL_UINT32((1U << TRIGGER) | (1U << GRAB), engine.getValue());
+}
+
+void test_gesture_engine_hysteresis(void)
+{
+    TestHand hand;
+    HandGestureEngine<1> engine(hand.fingers(), { { { FINGER_MASK_INDEX, 0.7F, 0.5F } } });
+
+    hand.set({ 0.0F, 0.6F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_FALSE(engine.isActive(0));
+
+    hand.set({ 0.0F, 0.7F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_TRUE(engine.isActive(0));
+
+    // Stays active, until below the lower threshold
+    hand.set({ 0.0F, 0.55F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_TRUE(engine.isActive(0));
+
+    hand.set({ 0.0F, 0.45F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_FALSE(engine.isActive(0));
+
+    hand.set({ 0.0F, 0.6F, 0.0F, 0.0F, 0.0F });
+    engine.tick();
+    TEST_ASSERT_FALSE(engine.isActive(0));
+}
+
+void test_gesture_engine_user_defined(void)
+{
+    constexpr auto defaults = defaultGestures(0.5F, 0.5F, 0.5F);
+    constexpr GestureDefinition fist{
+        FINGER_MASK_THUMB | FINGER_MASK_INDEX | FINGER_MASK_MIDDLE | FINGER_MASK_RING | FINGER_MASK_PINKY,
+        0.8F,
+        0.8F,
+    };
+
+    TestHand hand;
+    HandGestureEngine<4> engine(hand.fingers(), { { defaults[0], defaults[1], defaults[2], fist } });
+
+    hand.set({ 0.7F, 0.9F, 0.9F, 0.9F, 0.9F });
+    engine.tick();
+    TEST_ASSERT_EQUAL_UINT32(0b0111, engine.getValue());
+
+    hand.set({ 0.9F, 0.9F, 0.9F, 0.9F, 0.9F });
+    engine.tick();
+    TEST_ASSERT_EQUAL_UINT32(0b1111, engine.getValue());
+}
+
+void test_gesture_engine_missing_finger(void)
+{
+    TestHand hand;
+    auto fingers = hand.fingers();
+    fingers.thumb = nullptr;
+
+    HandGestureEngine<3> engine(fingers, defaultGestures(0.5F, 0.5F, 0.5F));
+    TEST_ASSERT_EQUAL(4, engine.getDependencies().size());
+
+    hand.set({ 1.0F, 1.0F, 1.0F, 1.0F, 1.0F });
+    engine.tick();
+    TEST_ASSERT_EQUAL_UINT32((1U << TRIGGER) | (1U << GRAB), engine.getValue());
+}
+
+void test_gesture_engine_matches_gestures(void)
+{
+    TestHand hand;
+    HandGestureEngine<3> engine(hand.fingers(), defaultGestures(0.5F, 0.5F, 0.5F));
+
+    TriggerGesture trigger(&hand.index, 0.5F);
+    GrabGesture grab({ .index = &hand.index, .middle = &hand.middle, .ring = &hand.ring, .pinky = &hand.pinky }, 0.5F);
+    PinchGesture pinch({ .thumb = &hand.thumb, .index = &hand.index }, 0.5F);
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> curl(0.0F, 1.0F);
+
+    for (auto i = 0; i < 1000; i++) {
+        hand.set({ curl(random), curl(random), curl(random), curl(random), curl(random) });
+
+        engine.tick();
+        trigger.tick();
+        grab.tick();
+        pinch.tick();
+
+        TEST_ASSERT_EQUAL(trigger.getValue(), engine.isActive(TRIGGER));
+        TEST_ASSERT_EQUAL(grab.getValue(), engine.isActive(GRAB));
+        TEST_ASSERT_EQUAL(pinch.getValue(), engine.isActive(PINCH));
+    }
+}
+
+void test_benchmark_gesture_engine(void)
+{
+    constexpr std::size_t iterations = 200000;
+
+    TestHand hand;
+
+    auto* trigger = new TriggerGesture(&hand.index, 0.5F);
+    auto* grab = new GrabGesture(
+      { .index = &hand.index, .middle = &hand.middle, .ring = &hand.ring, .pinky = &hand.pinky },
+      0.5F
+    );
+    auto* pinch = new PinchGesture({ .thumb = &hand.thumb, .index = &hand.index }, 0.5F);
+    auto* engine = new HandGestureEngine<3>(hand.fingers(), defaultGestures(0.5F, 0.5F, 0.5F));
+
+    // Precomputed, so the benchmark measures the gestures only
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> curl(0.0F, 1.0F);
+    std::array<std::array<float, 5>, 256> poses{};
+    for (auto& pose : poses) {
+        for (auto& finger : pose) {
+            finger = curl(random);
+        }
+    }
+
+    // Ticked through the base, as by the SensorGraph
+    const std::array<ISensorNode*, 3> objects{ trigger, grab, pinch };
+    ISensorNode* engine_node = engine;
+
+    std::size_t objects_active = 0;
+    const auto objects_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        hand.set(poses[i & 0xFF]);
+        for (auto* object : objects) {
+            object->tick();
+        }
+        objects_active += trigger->getValue() + grab->getValue() + pinch->getValue();
+    });
+
+    std::size_t engine_active = 0;
+    const auto engine_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        hand.set(poses[i & 0xFF]);
+        engine_node->tick();
+        const auto state = engine->getValue();
+        engine_active += ((state >> TRIGGER) & 1U) + ((state >> GRAB) & 1U) + ((state >> PINCH) & 1U);
+    });
+
+    // Setting the pose alone, to subtract it
+    const auto pose_ns = benchmark_ns(iterations, [&](std::size_t i) { hand.set(poses[i & 0xFF]); });
+
+    char message[160];
+    snprintf(
+      message,
+      sizeof(message),
+      "3 gestures: per-gesture sensors %.2f ns, engine %.2f ns (pose update %.2f ns included)",
+      objects_ns,
+      engine_ns,
+      pose_ns
+    );
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL(objects_active, engine_active);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_gesture_engine_default_gestures);
+    RUN_TEST(test_gesture_engine_hysteresis);
+    RUN_TEST(test_gesture_engine_user_defined);
+    RUN_TEST(test_gesture_engine_missing_finger);
+    RUN_TEST(test_gesture_engine_matches_gestures);
+
+    RUN_TEST(test_benchmark_gesture_engine);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include <senseshift/body/hands/input/total_curl.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor_graph.hpp>
+#include <unity.h>
+
+using namespace SenseShift::Input;
+using namespace SenseShift::Body::Hands::Input;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+void test_total_curl_weighted(void)
+{
+    auto* mcp = new FloatSensor();
+    auto* pip = new FloatSensor();
+    auto* dip = new FloatSensor();
+
+    auto* total = new TotalCurl<3>({ {
+      { mcp, 2.0F },
+      { pip, 1.0F },
+      { dip, 1.0F },
+    } });
+    total->init();
+
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, total->getWeight(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, total->getWeight(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, total->getWeight(2));
+
+    mcp->publishState(1.0F);
+    total->tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, total->getValue());
+
+    pip->publishState(1.0F);
+    dip->publishState(0.5F);
+    total->tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.875F, total->getValue());
+}
+
+void test_total_curl_zero_weights(void)
+{
+    auto* mcp = new FloatSensor(0.2F);
+    auto* pip = new FloatSensor(0.6F);
+
+    auto* total = new TotalCurl<2>({ { { mcp, 0.0F }, { pip, 0.0F } } });
+    total->tick();
+
+    TEST_ASSERT_EQUAL_FLOAT(0.4F, total->getValue());
+}
+
+void test_total_curl_references_joints(void)
+{
+    auto* mcp = new FloatSensor();
+    auto* pip = new FloatSensor();
+
+    auto* total = new TotalCurl<2>({ { { mcp }, { pip } } }, true);
+    total->init();
+
+    TEST_ASSERT_EQUAL_PTR(mcp, total->getJoint(0));
+    TEST_ASSERT_EQUAL_PTR(pip, total->getJoint(1));
+
+    // Updates of the actual joint sensors are seen
+    mcp->publishState(0.5F);
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, total->getValue());
+
+    pip->publishState(0.5F);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, total->getValue());
+}
+
+void test_total_curl_in_graph(void)
+{
+    auto* mcp = new FloatSensor();
+    auto* pip = new FloatSensor();
+    auto* total = new TotalCurl<2>({ { { mcp, 3.0F }, { pip, 1.0F } } });
+
+    SensorGraph graph;
+    graph.add(total);
+    graph.init();
+
+    TEST_ASSERT_EQUAL(3, graph.size());
+
+    mcp->publishState(1.0F);
+    graph.tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, total->getValue());
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_total_curl_weighted);
+    RUN_TEST(test_total_curl_zero_weights);
+    RUN_TEST(test_total_curl_references_joints);
+    RUN_TEST(test_total_curl_in_graph);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,236 @@
+#include <benchmark.hpp>
+#include <senseshift/core/delegate.hpp>
+#include <senseshift/core/helpers.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <unity.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+using namespace SenseShift;
+using namespace SenseShift::Input;
+
+/// Heap allocations made in this test binary.
+static std::size_t allocations = 0;
+
+auto operator new(std::size_t size) -> void*
+{
+    allocations++;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept
+{
+    std::free(pointer);
+}
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+auto free_function(int value) -> int
+{
+    return value * 3;
+}
+
+void test_delegate_call(void)
+{
+    InlineDelegate<int(int)> empty;
+    TEST_ASSERT_FALSE(static_cast<bool>(empty));
+
+    InlineDelegate<int(int)> function = &free_function;
+    TEST_ASSERT_TRUE(static_cast<bool>(function));
+    TEST_ASSERT_EQUAL_INT(6, function(2));
+
+    int offset = 10;
+    InlineDelegate<int(int)> lambda = [&offset](int value) { return value + offset; };
+    TEST_ASSERT_EQUAL_INT(12, lambda(2));
+    offset = 20;
+    TEST_ASSERT_EQUAL_INT(22, lambda(2));
+
+    // Stateful, the same as std::function
+    InlineDelegate<int()> counter = [count = 0]() mutable { return ++count; };
+    TEST_ASSERT_EQUAL_INT(1, counter());
+    TEST_ASSERT_EQUAL_INT(2, counter());
+
+    auto copy = counter;
+    TEST_ASSERT_EQUAL_INT(3, copy());
+    TEST_ASSERT_EQUAL_INT(3, counter());
+}
+
+void test_delegate_lifetime(void)
+{
+    auto shared = std::make_shared<int>(42);
+
+    {
+        InlineDelegate<int()> delegate = [shared]() { return *shared; };
+        TEST_ASSERT_EQUAL_INT(2, shared.use_count());
+
+        auto copy = delegate;
+        TEST_ASSERT_EQUAL_INT(3, shared.use_count());
+
+        auto moved = std::move(delegate);
+        TEST_ASSERT_EQUAL_INT(3, shared.use_count());
+        TEST_ASSERT_FALSE(static_cast<bool>(delegate));
+        TEST_ASSERT_EQUAL_INT(42, moved());
+
+        copy = InlineDelegate<int()>(&std::rand);
+        TEST_ASSERT_EQUAL_INT(2, shared.use_count());
+
+        moved.reset();
+        TEST_ASSERT_EQUAL_INT(1, shared.use_count());
+
+        delegate = [shared]() { return *shared + 1; };
+        TEST_ASSERT_EQUAL_INT(43, delegate());
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, shared.use_count());
+}
+
+void test_static_callback_manager(void)
+{
+    StaticCallbackManager<2, void(int)> manager;
+    int sum = 0;
+
+    TEST_ASSERT_TRUE(manager.add([&sum](int value) { sum += value; }));
+    TEST_ASSERT_TRUE(manager.add([&sum](int value) { sum += value * 10; }));
+    // Full
+    TEST_ASSERT_FALSE(manager.add([&sum](int value) { sum += value * 100; }));
+    TEST_ASSERT_EQUAL_size_t(2, manager.size());
+
+    manager.call(1);
+    TEST_ASSERT_EQUAL_INT(11, sum);
+    manager(2);
+    TEST_ASSERT_EQUAL_INT(33, sum);
+}
+
+void test_sensor_publish_does_not_allocate(void)
+{
+    FloatSensor sensor;
+    float sum = 0.0F;
+    for (auto i = 0; i < 4; i++) {
+        sensor.addValueCallback([&sum](float value) { sum += value; });
+    }
+    sensor.addRawValueCallback([&sum](float value) { sum -= value; });
+
+    const auto before = allocations;
+    for (auto i = 0; i < 100; i++) {
+        sensor.publishState(1.0F);
+    }
+
+    TEST_ASSERT_EQUAL_size_t(before, allocations);
+    TEST_ASSERT_EQUAL_FLOAT(300.0F, sum);
+}
+
+/// Subscriber like the gestures: captures the owner, and a pointer to its state.
+struct TestSubscriber {
+    float* sink;
+    float weight;
+
+    void handle(const float value) const
+    {
+        *this->sink += value * this->weight;
+    }
+};
+
+void test_benchmark_callbacks(void)
+{
+    constexpr std::size_t iterations = 1000000;
+
+    for (const std::size_t subscribers : { 0U, 1U, 4U }) {
+        CallbackManager<void(float)> dynamic;
+        StaticCallbackManager<4, void(float)> fixed;
+
+        float dynamic_sink = 0.0F;
+        float fixed_sink = 0.0F;
+        std::array<TestSubscriber, 4> dynamic_subscribers{};
+        std::array<TestSubscriber, 4> fixed_subscribers{};
+
+        const auto before_dynamic = allocations;
+        for (std::size_t i = 0; i < subscribers; i++) {
+            dynamic_subscribers[i] = { &dynamic_sink, static_cast<float>(i + 1) };
+            dynamic.add([subscriber = &dynamic_subscribers[i]](float value) { subscriber->handle(value); });
+        }
+        const auto dynamic_allocations = allocations - before_dynamic;
+
+        const auto before_fixed = allocations;
+        for (std::size_t i = 0; i < subscribers; i++) {
+            fixed_subscribers[i] = { &fixed_sink, static_cast<float>(i + 1) };
+            fixed.add([subscriber = &fixed_subscribers[i]](float value) { subscriber->handle(value); });
+        }
+        TEST_ASSERT_EQUAL_size_t(before_fixed, allocations);
+
+        const auto dynamic_ns = benchmark_ns(iterations, [&](std::size_t i) {
+            dynamic.call(static_cast<float>(i & 0xFF));
+        });
+        const auto fixed_ns = benchmark_ns(iterations, [&](std::size_t i) {
+            fixed.call(static_cast<float>(i & 0xFF));
+        });
+
+        char message[160];
+        snprintf(
+          message,
+          sizeof(message),
+          "%u subscribers: std::function vector %.2f ns (%u allocations), inline delegates %.2f ns (none)",
+          static_cast<unsigned>(subscribers),
+          dynamic_ns,
+          static_cast<unsigned>(dynamic_allocations),
+          fixed_ns
+        );
+        TEST_MESSAGE(message);
+
+        TEST_ASSERT_EQUAL_FLOAT(dynamic_sink, fixed_sink);
+    }
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_delegate_call);
+    RUN_TEST(test_delegate_lifetime);
+    RUN_TEST(test_static_callback_manager);
+    RUN_TEST(test_sensor_publish_does_not_allocate);
+    RUN_TEST(test_benchmark_callbacks);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include <senseshift/core/mailbox.hpp>
+#include <senseshift/core/mailbox_worker.hpp>
+#include <unity.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using namespace SenseShift;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Frame, that is considered torn if its values are not all the same.
+using TestFrame = std::array<std::uint32_t, 16>;
+
+auto make_frame(std::uint32_t value) -> TestFrame
+{
+    TestFrame frame{};
+    frame.fill(value);
+    return frame;
+}
+
+auto is_frame_torn(const TestFrame& frame) -> bool
+{
+    for (const auto value : frame) {
+        if (value != frame[0]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void test_mailbox_consume_empty(void)
+{
+    LatestValueMailbox<int> mailbox;
+
+    TEST_ASSERT_FALSE(mailbox.hasPending());
+    TEST_ASSERT_NULL(mailbox.consume());
+}
+
+void test_mailbox_consume_once(void)
+{
+    LatestValueMailbox<int> mailbox;
+
+    mailbox.publish(42);
+    TEST_ASSERT_TRUE(mailbox.hasPending());
+
+    const auto* value = mailbox.consume();
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT(42, *value);
+
+    TEST_ASSERT_FALSE(mailbox.hasPending());
+    TEST_ASSERT_NULL(mailbox.consume());
+}
+
+void test_mailbox_merges_stale_values(void)
+{
+    LatestValueMailbox<int> mailbox;
+
+    mailbox.publish(1);
+    mailbox.publish(2);
+    mailbox.publish(3);
+
+    const auto* value = mailbox.consume();
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT(3, *value);
+    TEST_ASSERT_NULL(mailbox.consume());
+
+    TEST_ASSERT_EQUAL_UINT32(3, mailbox.getPublishedCount());
+    TEST_ASSERT_EQUAL_UINT32(2, mailbox.getOverwrittenCount());
+
+    mailbox.publish(4);
+    value = mailbox.consume();
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT(4, *value);
+    TEST_ASSERT_EQUAL_UINT32(2, mailbox.getOverwrittenCount());
+}
+
+void test_mailbox_concurrent(void)
+{
+    constexpr std::uint32_t count = 200000;
+
+    LatestValueMailbox<TestFrame> mailbox;
+    std::atomic<bool> done{ false };
+
+    std::thread producer([&] {
+        for (std::uint32_t i = 1; i <= count; i++) {
+            mailbox.publish(make_frame(i));
+        }
+        done = true;
+    });
+
+    std::uint32_t last = 0;
+    std::uint32_t consumed = 0;
+    while (true) {
+        const bool finished = done;
+        while (const auto* frame = mailbox.consume()) {
+            TEST_ASSERT_FALSE(is_frame_torn(*frame));
+            // Values only go forward
+            TEST_ASSERT_GREATER_THAN_UINT32(last, (*frame)[0]);
+            last = (*frame)[0];
+            consumed++;
+        }
+        if (finished) {
+            break;
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(count, last);
+    TEST_ASSERT_EQUAL_UINT32(count, mailbox.getPublishedCount());
+    TEST_ASSERT_EQUAL_UINT32(count, consumed + mailbox.getOverwrittenCount());
+}
+
+void test_thread_worker(void)
+{
+    constexpr std::uint32_t count = 50000;
+
+    // Unity assertions are not thread-safe, so the results are checked after the worker is stopped
+    std::uint32_t last = 0;
+    std::uint32_t handled = 0;
+    bool torn = false;
+    bool ordered = true;
+
+    auto* worker = new ThreadMailboxWorker<TestFrame>([&](const TestFrame& frame) {
+        torn = torn || is_frame_torn(frame);
+        ordered = ordered && frame[0] > last;
+        last = frame[0];
+        handled++;
+    });
+    worker->begin();
+
+    for (std::uint32_t i = 1; i <= count; i++) {
+        worker->publish(make_frame(i));
+    }
+    worker->stop();
+
+    TEST_ASSERT_FALSE(torn);
+    TEST_ASSERT_TRUE(ordered);
+    // The latest frame is always handled
+    TEST_ASSERT_EQUAL_UINT32(count, last);
+    TEST_ASSERT_EQUAL_UINT32(count, handled + worker->getMailbox().getOverwrittenCount());
+
+    delete worker;
+}
+
+void test_thread_worker_publish_before_begin(void)
+{
+    std::uint32_t last = 0;
+    auto* worker = new ThreadMailboxWorker<TestFrame>([&](const TestFrame& frame) { last = frame[0]; });
+
+    // Handled once the worker starts, same as the FreeRTOS MailboxTask
+    worker->publish(make_frame(7));
+    worker->begin();
+    worker->stop();
+
+    TEST_ASSERT_EQUAL_UINT32(7, last);
+
+    delete worker;
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mailbox_consume_empty);
+    RUN_TEST(test_mailbox_consume_once);
+    RUN_TEST(test_mailbox_merges_stale_values);
+    RUN_TEST(test_mailbox_concurrent);
+    RUN_TEST(test_thread_worker);
+    RUN_TEST(test_thread_worker_publish_before_begin);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
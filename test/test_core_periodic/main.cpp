@@ -0,0 +1,163 @@
+#include <senseshift/core/periodic.hpp>
+#include <senseshift/core/periodic_worker.hpp>
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace SenseShift;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+void test_scheduler_does_not_drift(void)
+{
+    // 90 Hz, which is not a whole number of milliseconds
+    PeriodicScheduler scheduler(11111);
+    scheduler.reset(0);
+
+    PeriodicScheduler::TimePoint now = 0;
+    for (int i = 0; i < 900; i++) {
+        scheduler.tickStarted(now);
+        // Tick duration and wake-up latency vary
+        now += 1000 + (i % 7) * 300;
+        now = scheduler.tickFinished(now) + (i % 3) * 200;
+    }
+
+    // The deadlines do not depend on the tick duration
+    TEST_ASSERT_EQUAL_UINT64(900ULL * 11111, scheduler.getDeadline());
+
+    const auto& stats = scheduler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(900, stats.ticks);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(400, stats.max_lateness);
+}
+
+void test_scheduler_wait_time(void)
+{
+    PeriodicScheduler scheduler(1000);
+    scheduler.reset(500);
+
+    scheduler.tickStarted(500);
+    TEST_ASSERT_EQUAL_UINT64(1500, scheduler.tickFinished(800));
+    TEST_ASSERT_EQUAL_UINT32(700, scheduler.getWaitTime(800));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getWaitTime(1600));
+}
+
+void test_scheduler_counts_early_ticks(void)
+{
+    PeriodicScheduler scheduler(1000);
+    scheduler.reset(0);
+
+    scheduler.tickStarted(0);
+    scheduler.tickFinished(100);
+
+    // Woken up before the deadline
+    scheduler.tickStarted(900);
+    scheduler.tickFinished(1000);
+
+    const auto& stats = scheduler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.ticks);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.early);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.max_lateness);
+}
+
+void test_scheduler_late_tick_runs_immediately(void)
+{
+    PeriodicScheduler scheduler(1000);
+    scheduler.reset(0);
+
+    scheduler.tickStarted(0);
+    // Overrun by less than a period: the next tick is due already
+    TEST_ASSERT_EQUAL_UINT64(1000, scheduler.tickFinished(1300));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getWaitTime(1300));
+
+    scheduler.tickStarted(1300);
+    // The phase is kept
+    TEST_ASSERT_EQUAL_UINT64(2000, scheduler.tickFinished(1400));
+
+    const auto& stats = scheduler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.skipped);
+    TEST_ASSERT_EQUAL_UINT32(300, stats.last_lateness);
+    TEST_ASSERT_EQUAL_UINT32(150, stats.getMeanLateness());
+}
+
+void test_scheduler_skips_missed_periods(void)
+{
+    PeriodicScheduler scheduler(1000);
+    scheduler.reset(0);
+
+    scheduler.tickStarted(0);
+    // Way behind: no burst of the missed ticks
+    TEST_ASSERT_EQUAL_UINT64(4000, scheduler.tickFinished(4500));
+
+    const auto& stats = scheduler.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.skipped);
+}
+
+/// Smoke test only: the timing itself is tested on the PeriodicScheduler, with the given times.
+void test_thread_worker(void)
+{
+    std::atomic<std::uint32_t> ticks{ 0 };
+    auto* worker = new ThreadPeriodicWorker([&ticks] { ticks++; }, std::chrono::milliseconds(1));
+
+    worker->begin();
+    // Generous, the CI machines are noisy
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ticks == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    worker->stop();
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, ticks.load());
+    TEST_ASSERT_EQUAL_UINT32(ticks.load(), worker->getStats().ticks);
+
+    delete worker;
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scheduler_does_not_drift);
+    RUN_TEST(test_scheduler_wait_time);
+    RUN_TEST(test_scheduler_counts_early_ticks);
+    RUN_TEST(test_scheduler_late_tick_runs_immediately);
+    RUN_TEST(test_scheduler_skips_missed_periods);
+    RUN_TEST(test_thread_worker);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include <senseshift/core/profiling.hpp>
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+using namespace SenseShift;
+
+/// Clock, that only moves when the test says so.
+struct TestClock {
+    static inline std::uint32_t micros = 0;
+
+    static auto now() -> std::uint32_t
+    {
+        return micros;
+    }
+};
+
+void setUp(void)
+{
+    TestClock::micros = 0;
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+void test_histogram_buckets(void)
+{
+    // Every value fits into the bucket, that it is mapped to
+    std::size_t previous = 0;
+    for (std::uint32_t value = 0; value < (1U << 21); value++) {
+        const auto bucket = LatencyHistogram::bucketOf(value);
+        TEST_ASSERT_LESS_THAN_size_t(LatencyHistogram::BUCKET_COUNT, bucket);
+        TEST_ASSERT_TRUE(bucket == previous || bucket == previous + 1);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(value, LatencyHistogram::upperBoundOf(bucket));
+        previous = bucket;
+    }
+
+    TEST_ASSERT_EQUAL_size_t(LatencyHistogram::BUCKET_COUNT - 1, LatencyHistogram::bucketOf(0xFFFFFFFF));
+}
+
+void test_histogram_empty(void)
+{
+    LatencyHistogram histogram;
+
+    const auto summary = histogram.summary();
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.p99);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.max);
+}
+
+void test_histogram_percentiles(void)
+{
+    LatencyHistogram histogram;
+
+    for (std::uint32_t value = 1; value <= 1000; value++) {
+        histogram.record(value);
+    }
+
+    const auto summary = histogram.summary();
+    TEST_ASSERT_EQUAL_UINT32(1000, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(1, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(1000, summary.max);
+
+    // Within one bucket (25%) above the real value
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(500, summary.p50);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(625, summary.p50);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(990, summary.p99);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1000, summary.p99);
+
+    histogram.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.count());
+}
+
+void test_histogram_single_value(void)
+{
+    LatencyHistogram histogram;
+
+    histogram.record(300);
+    histogram.record(300);
+
+    const auto summary = histogram.summary();
+    TEST_ASSERT_EQUAL_UINT32(300, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(300, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(300, summary.p99);
+    TEST_ASSERT_EQUAL_UINT32(300, summary.max);
+}
+
+void test_stage_timer_laps(void)
+{
+    StageTimer<3, TestClock> timer;
+
+    for (int i = 0; i < 100; i++) {
+        timer.start();
+        TestClock::micros += 100;
+        timer.lap(0);
+        TestClock::micros += (i == 99) ? 5000 : 20;
+        timer.lap(1);
+        TestClock::micros += 3;
+        timer.lap(2);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(100, timer.getHistogram(0).count());
+    TEST_ASSERT_EQUAL_UINT32(100, timer.getHistogram(0).min());
+    TEST_ASSERT_EQUAL_UINT32(100, timer.getHistogram(0).max());
+
+    // A single outlier is visible in the max, but not in the median
+    const auto summary = timer.getHistogram(1).summary();
+    TEST_ASSERT_EQUAL_UINT32(20, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(5000, summary.max);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(23, summary.p50);
+
+    TEST_ASSERT_EQUAL_UINT32(3, timer.getHistogram(2).percentile(0.99F));
+}
+
+void test_stage_timer_clock_wraps(void)
+{
+    StageTimer<1, TestClock> timer;
+
+    TestClock::micros = 0xFFFFFFF0;
+    timer.start();
+    TestClock::micros += 0x20;
+    timer.lap(0);
+
+    TEST_ASSERT_EQUAL_UINT32(0x20, timer.getHistogram(0).max());
+}
+
+void test_stage_timer_format(void)
+{
+    StageTimer<2, TestClock> timer;
+    timer.start();
+    TestClock::micros += 10;
+    timer.lap(0);
+    TestClock::micros += 7;
+    timer.lap(1);
+
+    char buffer[128];
+    const auto length = timer.format(buffer, sizeof(buffer), { "read", "send" });
+
+    TEST_ASSERT_EQUAL_STRING("read n=1 min=10 p50=10 p99=10 max=10\nsend n=1 min=7 p50=7 p99=7 max=7\n", buffer);
+    TEST_ASSERT_EQUAL_size_t(std::strlen(buffer), length);
+
+    // Truncated to fit
+    char small[16];
+    TEST_ASSERT_EQUAL_size_t(15, timer.format(small, sizeof(small), { "read", "send" }));
+    TEST_ASSERT_EQUAL_size_t(15, std::strlen(small));
+}
+
+void test_null_stage_timer(void)
+{
+    NullStageTimer<4, TestClock> timer;
+
+    timer.start();
+    TestClock::micros += 10;
+    timer.lap(0);
+
+    char buffer[16] = "garbage";
+    TEST_ASSERT_EQUAL_size_t(0, timer.format(buffer, sizeof(buffer), { "a", "b", "c", "d" }));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+
+    TEST_ASSERT_EQUAL_size_t(1, sizeof(timer));
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_histogram_buckets);
+    RUN_TEST(test_histogram_empty);
+    RUN_TEST(test_histogram_percentiles);
+    RUN_TEST(test_histogram_single_value);
+    RUN_TEST(test_stage_timer_laps);
+    RUN_TEST(test_stage_timer_clock_wraps);
+    RUN_TEST(test_stage_timer_format);
+    RUN_TEST(test_null_stage_timer);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
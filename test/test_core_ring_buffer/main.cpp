@@ -0,0 +1,108 @@
+#include <senseshift/core/ring_buffer.hpp>
+#include <unity.h>
+
+using namespace SenseShift;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+void test_ring_buffer_push(void)
+{
+    RingBuffer<int, 3> buffer;
+
+    TEST_ASSERT_TRUE(buffer.empty());
+    TEST_ASSERT_EQUAL(3, buffer.capacity());
+
+    buffer.push(1);
+    buffer.push(2);
+    TEST_ASSERT_EQUAL(2, buffer.size());
+    TEST_ASSERT_FALSE(buffer.full());
+    TEST_ASSERT_EQUAL_INT(1, buffer.front());
+    TEST_ASSERT_EQUAL_INT(2, buffer.back());
+
+    buffer.push(3);
+    TEST_ASSERT_TRUE(buffer.full());
+    TEST_ASSERT_EQUAL_INT(1, buffer[0]);
+    TEST_ASSERT_EQUAL_INT(2, buffer[1]);
+    TEST_ASSERT_EQUAL_INT(3, buffer[2]);
+}
+
+void test_ring_buffer_overwrites_oldest(void)
+{
+    RingBuffer<int, 3> buffer;
+
+    for (int i = 1; i <= 5; i++) {
+        buffer.push(i);
+    }
+
+    TEST_ASSERT_EQUAL(3, buffer.size());
+    TEST_ASSERT_EQUAL_INT(3, buffer[0]);
+    TEST_ASSERT_EQUAL_INT(4, buffer[1]);
+    TEST_ASSERT_EQUAL_INT(5, buffer[2]);
+}
+
+void test_ring_buffer_pop(void)
+{
+    RingBuffer<int, 3> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+    buffer.push(4);
+
+    buffer.pop();
+    TEST_ASSERT_EQUAL(2, buffer.size());
+    TEST_ASSERT_EQUAL_INT(3, buffer.front());
+    TEST_ASSERT_EQUAL_INT(4, buffer.back());
+
+    buffer.pop();
+    buffer.pop();
+    buffer.pop();
+    TEST_ASSERT_TRUE(buffer.empty());
+
+    buffer.push(5);
+    TEST_ASSERT_EQUAL_INT(5, buffer.front());
+
+    buffer.clear();
+    TEST_ASSERT_TRUE(buffer.empty());
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ring_buffer_push);
+    RUN_TEST(test_ring_buffer_overwrites_oldest);
+    RUN_TEST(test_ring_buffer_pop);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
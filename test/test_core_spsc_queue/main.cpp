@@ -0,0 +1,136 @@
+#include <senseshift/core/spsc_queue.hpp>
+#include <unity.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using namespace SenseShift;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+void test_queue_fifo(void)
+{
+    SpscQueue<int, 4> queue;
+    int value = 0;
+
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_FALSE(queue.pop(value));
+
+    TEST_ASSERT_TRUE(queue.push(1));
+    TEST_ASSERT_TRUE(queue.push(2));
+    TEST_ASSERT_TRUE(queue.push(3));
+    TEST_ASSERT_EQUAL_size_t(3, queue.size());
+
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL_INT(1, value);
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL_INT(2, value);
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL_INT(3, value);
+    TEST_ASSERT_FALSE(queue.pop(value));
+}
+
+void test_queue_drops_when_full(void)
+{
+    SpscQueue<int, 4> queue;
+    int value = 0;
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+    }
+    TEST_ASSERT_FALSE(queue.push(4));
+    TEST_ASSERT_FALSE(queue.push(5));
+    TEST_ASSERT_EQUAL_UINT32(2, queue.getDroppedCount());
+
+    // The oldest values are kept
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL_INT(i, value);
+    }
+
+    // Wraps around
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL_INT(i, value);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, queue.getDroppedCount());
+}
+
+void test_queue_concurrent(void)
+{
+    constexpr std::uint32_t count = 200000;
+
+    SpscQueue<std::uint32_t, 16> queue;
+    std::atomic<bool> done{ false };
+
+    std::thread producer([&] {
+        for (std::uint32_t i = 1; i <= count; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    std::uint32_t expected = 1;
+    bool ordered = true;
+    while (true) {
+        const bool finished = done;
+        std::uint32_t value = 0;
+        while (queue.pop(value)) {
+            // Nothing lost, nothing reordered
+            ordered = ordered && value == expected;
+            expected++;
+        }
+        if (finished) {
+            break;
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL_UINT32(count + 1, expected);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_queue_fifo);
+    RUN_TEST(test_queue_drops_when_full);
+    RUN_TEST(test_queue_concurrent);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -1,6 +1,12 @@
+#include <benchmark.hpp>
 #include <senseshift/body/haptics/plane.hpp>
 #include <unity.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <vector>
+
 using namespace SenseShift::Body::Haptics;
 using namespace SenseShift::Output;
 
@@ -18,6 +24,7 @@ class TestActuator : public IOutput<float> {
   public:
     bool isSetup = false;
     float intensity = 0;
+    int writes = 0;
 
     TestActuator() : IFloatOutput()
     {
@@ -29,6 +36,16 @@ class TestActuator : public IOutput<float> {
     void writeState(float newIntensity) override
     {
         this->intensity = newIntensity;
+        this->writes++;
+    }
+};
+
+/// Deduplicates the writes by itself, like the PCA9685BankOutput.
+class TestDeduplicatingActuator : public TestActuator {
+  public:
+    [[nodiscard]] auto skipsUnchangedWrites() const -> bool override
+    {
+        return true;
     }
 };
 
@@ -187,6 +204,143 @@ void test_closest_it_updates_state(void)
     TEST_ASSERT_EQUAL_FLOAT(0.5F, plane->getActuatorStates()->at({ 64, 64 }));
 }
 
+/// Reference implementation: linear scan over all the points, ties are resolved to the lowest position.
+auto brute_force_closest(const FloatPlane::PositionSet& points, const Position& target) -> Position
+{
+    Position closest = *points.begin();
+    float closest_distance = target - closest;
+    for (const auto& point : points) {
+        const float distance = target - point;
+        if (distance < closest_distance) {
+            closest = point;
+            closest_distance = distance;
+        }
+    }
+
+    return closest;
+}
+
+void test_closest_lookup_matches_brute_force(void)
+{
+    std::array<std::array<FloatPlane::Actuator*, 4>, 5> matrix{};
+    for (auto& row : matrix) {
+        for (auto& actuator : row) {
+            actuator = new TestActuator();
+        }
+    }
+
+    const auto outputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>(matrix);
+    auto plane = new FloatPlane_Closest(outputs, FloatPlane_Closest::MAX_RESOLUTION);
+    const auto& points = *plane->getAvailablePoints();
+
+    for (int y = 0; y < 256; y++) {
+        for (int x = 0; x < 256; x++) {
+            const Position target(x, y);
+            const auto expected = brute_force_closest(points, target);
+            const auto& actual = plane->findClosestPoint(target);
+
+            TEST_ASSERT_EQUAL_UINT8(expected.x, actual.x);
+            TEST_ASSERT_EQUAL_UINT8(expected.y, actual.y);
+        }
+    }
+}
+
+void test_closest_lookup_downsampled(void)
+{
+    // (64, 64) and (70, 70), as well as (200, 30) and (201, 31), share the same 16x16 cell
+    FloatPlane_Closest::ActuatorMap outputs = {
+        { { 0, 0 }, new TestActuator() },     { { 0, 64 }, new TestActuator() },   { { 64, 0 }, new TestActuator() },
+        { { 64, 64 }, new TestActuator() },   { { 70, 70 }, new TestActuator() },  { { 200, 30 }, new TestActuator() },
+        { { 201, 31 }, new TestActuator() }, { { 31, 250 }, new TestActuator() },
+    };
+
+    for (const std::uint8_t resolution : { 0, 2, 4, 6 }) {
+        auto plane = new FloatPlane_Closest(outputs, resolution);
+        const auto& points = *plane->getAvailablePoints();
+
+        // Every point, not only the cell centers
+        for (int y = 0; y < 256; y++) {
+            for (int x = 0; x < 256; x++) {
+                const Position target(x, y);
+                const auto expected = brute_force_closest(points, target);
+                const auto& actual = plane->findClosestPoint(target);
+
+                TEST_ASSERT_EQUAL_UINT8(expected.x, actual.x);
+                TEST_ASSERT_EQUAL_UINT8(expected.y, actual.y);
+            }
+        }
+    }
+}
+
+void test_closest_lookup_random_layout(void)
+{
+    // Fixed seed, so the layout is the same on every run
+    std::uint32_t seed = 12345;
+    const auto next = [&seed]() -> std::uint8_t {
+        seed = seed * 1664525U + 1013904223U;
+        return static_cast<std::uint8_t>(seed >> 24);
+    };
+
+    FloatPlane_Closest::ActuatorMap outputs{};
+    while (outputs.size() < 40) {
+        outputs[{ next(), next() }] = new TestActuator();
+    }
+
+    auto plane = new FloatPlane_Closest(outputs, 3);
+    const auto& points = *plane->getAvailablePoints();
+
+    for (int i = 0; i < 10000; i++) {
+        const Position target(next(), next());
+        const auto expected = brute_force_closest(points, target);
+        const auto& actual = plane->findClosestPoint(target);
+
+        TEST_ASSERT_EQUAL_UINT8(expected.x, actual.x);
+        TEST_ASSERT_EQUAL_UINT8(expected.y, actual.y);
+    }
+}
+
+void test_closest_lookup_too_many_actuators(void)
+{
+    FloatPlane_Closest::ActuatorMap outputs{};
+    for (int y = 0; y < 20; y++) {
+        for (int x = 0; x < 20; x++) {
+            outputs[{ static_cast<std::uint8_t>(x * 13), static_cast<std::uint8_t>(y * 13) }] = new TestActuator();
+        }
+    }
+
+    // Linear search instead of the lookup grid
+    auto plane = new FloatPlane_Closest(outputs);
+    TEST_ASSERT_EQUAL(400 * sizeof(Position), plane->getLookupMemoryUsage());
+
+    const auto& points = *plane->getAvailablePoints();
+    for (const auto& target : { Position(0, 0), Position(7, 6), Position(100, 200), Position(255, 255) }) {
+        const auto expected = brute_force_closest(points, target);
+        const auto& actual = plane->findClosestPoint(target);
+
+        TEST_ASSERT_EQUAL_UINT8(expected.x, actual.x);
+        TEST_ASSERT_EQUAL_UINT8(expected.y, actual.y);
+    }
+
+    auto* actuator = static_cast<TestActuator*>(plane->getActuator({ 250, 250 }));
+    TEST_ASSERT_TRUE(actuator == outputs.at({ 247, 247 }));
+}
+
+void test_closest_lookup_memory_usage(void)
+{
+    FloatPlane_Closest::ActuatorMap outputs = {
+        { { 0, 0 }, new TestActuator() },
+        { { 64, 64 }, new TestActuator() },
+    };
+
+    // The cells along the edge between the actuators share the same candidates: a count and 2 indices
+    auto plane = new FloatPlane_Closest(outputs);
+    TEST_ASSERT_EQUAL_UINT8(FloatPlane_Closest::DEFAULT_RESOLUTION, plane->getResolution());
+    TEST_ASSERT_EQUAL(64 * 64 * 2 + 3 + 2 * sizeof(Position), plane->getLookupMemoryUsage());
+
+    auto full_plane = new FloatPlane_Closest(outputs, 8);
+    TEST_ASSERT_EQUAL(256 * 256 * 2 + 3 + 2 * sizeof(Position), full_plane->getLookupMemoryUsage());
+}
+
 void test_plain_mapper_margin_map_points(void)
 {
     auto point = PlaneMapper_Margin::mapPoint<uint8_t>(0, 0, 0, 0);
@@ -205,6 +359,251 @@ void test_plain_mapper_margin_map_points(void)
     TEST_ASSERT_EQUAL(170, point.y);
 }
 
+void test_dense_it_sets_up_actuators(void)
+{
+    FloatDensePlane::ActuatorMap outputs = {
+        { { 1, 1 }, new TestActuator() },
+        { { 0, 1 }, new TestActuator() },
+        { { 1, 0 }, new TestActuator() },
+        { { 0, 0 }, new TestActuator() },
+    };
+
+    auto plane = new FloatDensePlane(outputs);
+    plane->setup();
+
+    TEST_ASSERT_EQUAL(outputs.size(), plane->size());
+    TEST_ASSERT_EQUAL(outputs.size(), plane->getActuatorStates().size());
+    for (auto& kv : outputs) {
+        TEST_ASSERT_TRUE_MESSAGE(plane->findIndex(kv.first).has_value(), "Expected point was not found");
+        TEST_ASSERT_TRUE_MESSAGE(static_cast<TestActuator*>(kv.second)->isSetup, "Actuator was not setup");
+    }
+
+    // Points are sorted
+    for (std::size_t i = 1; i < plane->size(); i++) {
+        TEST_ASSERT_TRUE(plane->getAvailablePoints()[i - 1] < plane->getAvailablePoints()[i]);
+    }
+}
+
+void test_dense_it_writes_to_correct_output(void)
+{
+    auto actuator = new TestActuator(), actuator2 = new TestActuator(), actuator3 = new TestActuator(),
+         actuator4 = new TestActuator();
+
+    auto plane = new FloatDensePlane({
+      { { 0, 0 }, actuator },
+      { { 0, 1 }, actuator2 },
+      { { 1, 0 }, actuator3 },
+      { { 1, 1 }, actuator4 },
+    });
+
+    plane->effect({ 0, 0 }, 0.25F);
+    plane->effect({ 0, 1 }, 0.5F);
+    plane->effect({ 1, 0 }, 0.75F);
+    plane->effect({ 1, 1 }, 1.0F);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, actuator->intensity);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, actuator2->intensity);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, actuator3->intensity);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, actuator4->intensity);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, plane->getActuatorStates()[plane->findIndex({ 0, 0 }).value()]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, plane->getActuatorStates()[plane->findIndex({ 1, 1 }).value()]);
+}
+
+void test_dense_it_ignores_unknown_point(void)
+{
+    auto actuator = new TestActuator(), actuator2 = new TestActuator();
+
+    auto plane = new FloatDensePlane({
+      { { 0, 0 }, actuator },
+      { { 64, 64 }, actuator2 },
+    });
+
+    TEST_ASSERT_FALSE(plane->findIndex({ 16, 16 }).has_value());
+    TEST_ASSERT_FALSE(plane->findIndex({ 255, 255 }).has_value());
+
+    plane->effect({ 16, 16 }, 0.25F);
+    plane->effect(std::size_t{ 2 }, 0.25F);
+
+    TEST_ASSERT_EQUAL_FLOAT(0, actuator->intensity);
+    TEST_ASSERT_EQUAL_FLOAT(0, actuator2->intensity);
+    TEST_ASSERT_EQUAL_INT(0, actuator->writes + actuator2->writes);
+}
+
+void test_dense_it_finds_every_mapped_point(void)
+{
+    std::array<std::array<FloatPlane::Actuator*, 4>, 5> matrix{};
+    for (auto& row : matrix) {
+        for (auto& actuator : row) {
+            actuator = new TestActuator();
+        }
+    }
+
+    const auto outputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>(matrix);
+    auto plane = new FloatDensePlane(outputs);
+
+    TEST_ASSERT_EQUAL(20, plane->size());
+
+    float value = 0.0F;
+    for (const auto& [point, actuator] : outputs) {
+        value += 0.01F;
+        plane->effect(point, value);
+        TEST_ASSERT_EQUAL_FLOAT(value, static_cast<TestActuator*>(actuator)->intensity);
+    }
+}
+
+void test_it_skips_unchanged_writes(void)
+{
+    auto actuator = new TestActuator(), actuator2 = new TestActuator();
+
+    auto plane = new FloatPlane({
+      { { 0, 0 }, actuator },
+      { { 0, 1 }, actuator2 },
+    });
+    plane->enableChangeOnlyWrites(4095);
+    plane->setup();
+
+    plane->effect({ 0, 0 }, 0.5F);
+    plane->effect({ 0, 1 }, 0.5F);
+    plane->effect({ 0, 0 }, 0.5F);
+    plane->effect({ 0, 1 }, 0.75F);
+
+    TEST_ASSERT_TRUE(actuator->isSetup);
+    TEST_ASSERT_EQUAL_INT(1, actuator->writes);
+    TEST_ASSERT_EQUAL_INT(2, actuator2->writes);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, actuator2->intensity);
+
+    // State is tracked, even if the write was skipped
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, plane->getActuatorStates()->at({ 0, 0 }));
+
+    TEST_ASSERT_EQUAL_UINT32(3, plane->getWriteCounters().issued);
+    TEST_ASSERT_EQUAL_UINT32(1, plane->getWriteCounters().suppressed);
+}
+
+void test_dense_it_skips_unchanged_writes(void)
+{
+    auto actuator = new TestActuator(), actuator2 = new TestActuator();
+
+    auto plane = new FloatDensePlane({
+      { { 0, 0 }, actuator },
+      { { 0, 1 }, actuator2 },
+    });
+    plane->enableChangeOnlyWrites(4095);
+    plane->setup();
+
+    plane->effect({ 0, 0 }, 0.25F);
+    plane->effect({ 0, 0 }, 0.25F);
+
+    // Writes done through the looked up actuator (e.g. by the layout bindings) are deduplicated as well
+    auto* bound = plane->getActuator({ 0, 1 });
+    bound->writeState(1.0F);
+    bound->writeState(1.0F);
+    bound->writeState(0.0F);
+
+    TEST_ASSERT_EQUAL_INT(1, actuator->writes);
+    TEST_ASSERT_EQUAL_INT(2, actuator2->writes);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, actuator2->intensity);
+
+    TEST_ASSERT_EQUAL_UINT32(3, plane->getWriteCounters().issued);
+    TEST_ASSERT_EQUAL_UINT32(2, plane->getWriteCounters().suppressed);
+}
+
+void test_change_only_writes_wrap_once(void)
+{
+    auto actuator = new TestActuator();
+    auto deduplicating = new TestDeduplicatingActuator();
+
+    auto plane = new FloatDensePlane({
+      { { 0, 0 }, actuator },
+      { { 0, 1 }, deduplicating },
+    });
+    plane->enableChangeOnlyWrites(4095);
+    plane->enableChangeOnlyWrites(4095);
+    plane->setup();
+
+    // Left as is
+    TEST_ASSERT_TRUE(plane->getActuator({ 0, 1 }) == deduplicating);
+
+    // Wrapped once
+    auto* wrapped = static_cast<ChangeOnlyOutputDecorator*>(plane->getActuator({ 0, 0 }));
+    TEST_ASSERT_TRUE(wrapped->getOutput() == actuator);
+
+    plane->effect({ 0, 0 }, 0.5F);
+    plane->effect({ 0, 0 }, 0.5F);
+    TEST_ASSERT_EQUAL_INT(1, actuator->writes);
+    TEST_ASSERT_EQUAL_UINT32(1, plane->getWriteCounters().issued);
+    TEST_ASSERT_EQUAL_UINT32(1, plane->getWriteCounters().suppressed);
+}
+
+void test_it_writes_all_by_default(void)
+{
+    auto actuator = new TestActuator();
+
+    auto plane = new FloatDensePlane({
+      { { 0, 0 }, actuator },
+    });
+
+    plane->effect({ 0, 0 }, 0.5F);
+    plane->effect({ 0, 0 }, 0.5F);
+
+    TEST_ASSERT_EQUAL_INT(2, actuator->writes);
+    TEST_ASSERT_EQUAL_UINT32(0, plane->getWriteCounters().issued);
+    TEST_ASSERT_EQUAL_UINT32(0, plane->getWriteCounters().suppressed);
+}
+
+void test_benchmark_dense_plane(void)
+{
+    constexpr std::size_t iterations = 100000;
+
+    // TactSuit X40 front plane layout
+    std::array<std::array<FloatPlane::Actuator*, 4>, 5> map_matrix{};
+    std::array<std::array<FloatPlane::Actuator*, 4>, 5> dense_matrix{};
+    for (std::size_t y = 0; y < 5; y++) {
+        for (std::size_t x = 0; x < 4; x++) {
+            map_matrix[y][x] = new TestActuator();
+            dense_matrix[y][x] = new TestActuator();
+        }
+    }
+
+    const auto map_outputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>(map_matrix);
+    const auto dense_outputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>(dense_matrix);
+
+    std::vector<Position> points{};
+    for (const auto& [point, _] : map_outputs) {
+        points.push_back(point);
+    }
+
+    auto map_plane = new FloatPlane(map_outputs);
+    auto dense_plane = new FloatDensePlane(dense_outputs);
+
+    const auto map_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        map_plane->effect(points[i % points.size()], static_cast<float>(i % 256) / 255.0F);
+    });
+    const auto dense_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        dense_plane->effect(points[i % points.size()], static_cast<float>(i % 256) / 255.0F);
+    });
+
+    // Both planes must end up in the same state
+    for (std::size_t y = 0; y < 5; y++) {
+        for (std::size_t x = 0; x < 4; x++) {
+            TEST_ASSERT_EQUAL_FLOAT(
+              static_cast<TestActuator*>(map_matrix[y][x])->intensity,
+              static_cast<TestActuator*>(dense_matrix[y][x])->intensity
+            );
+        }
+    }
+
+    char message[128];
+    snprintf(
+      message,
+      sizeof(message),
+      "plane effect: map %.0f effects/s, dense %.0f effects/s",
+      1e9 / map_ns,
+      1e9 / dense_ns
+    );
+    TEST_MESSAGE(message);
+}
+
 int process(void)
 {
     UNITY_BEGIN();
@@ -216,9 +615,26 @@ int process(void)
     RUN_TEST(test_closest_it_writes_to_correct_if_exact);
     RUN_TEST(test_closest_it_correctly_finds_closest);
     RUN_TEST(test_closest_it_updates_state);
+    RUN_TEST(test_closest_lookup_matches_brute_force);
+    RUN_TEST(test_closest_lookup_downsampled);
+    RUN_TEST(test_closest_lookup_random_layout);
+    RUN_TEST(test_closest_lookup_too_many_actuators);
+    RUN_TEST(test_closest_lookup_memory_usage);
+
+    RUN_TEST(test_dense_it_sets_up_actuators);
+    RUN_TEST(test_dense_it_writes_to_correct_output);
+    RUN_TEST(test_dense_it_ignores_unknown_point);
+    RUN_TEST(test_dense_it_finds_every_mapped_point);
+
+    RUN_TEST(test_it_skips_unchanged_writes);
+    RUN_TEST(test_dense_it_skips_unchanged_writes);
+    RUN_TEST(test_change_only_writes_wrap_once);
+    RUN_TEST(test_it_writes_all_by_default);
 
     RUN_TEST(test_plain_mapper_margin_map_points);
 
+    RUN_TEST(test_benchmark_dense_plane);
+
     return UNITY_END();
 }
 
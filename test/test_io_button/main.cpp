@@ -0,0 +1,246 @@
+#include <senseshift/input/sensor/button.hpp>
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace SenseShift::Input;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+class TestEventLog {
+  public:
+    std::vector<ButtonEvent> events;
+
+    auto callback() -> ButtonEventDetector::CallbackType
+    {
+        return [this](ButtonEvent event) { this->events.push_back(event); };
+    }
+
+    /// Number of the given events since the last take().
+    auto take(const ButtonEvent event) -> std::size_t
+    {
+        std::size_t count = 0;
+        for (const auto logged : this->events) {
+            count += logged == event ? 1 : 0;
+        }
+        this->events.clear();
+        return count;
+    }
+};
+
+void test_debounce(void)
+{
+    TestEventLog log;
+    ButtonEventDetector detector({ 20, 300, 800 });
+    detector.addEventCallback(log.callback());
+
+    // Contact bounce on press, accepted on the first edge
+    detector.edge({ 100, true });
+    TEST_ASSERT_TRUE(detector.isPressed());
+    detector.edge({ 101, false });
+    detector.edge({ 102, true });
+    detector.edge({ 104, false });
+    detector.edge({ 105, true });
+    detector.update(150);
+    TEST_ASSERT_TRUE(detector.isPressed());
+    TEST_ASSERT_EQUAL_size_t(1, log.events.size());
+    TEST_ASSERT_EQUAL_size_t(1, log.take(ButtonEvent::Press));
+
+    // And on release
+    detector.edge({ 300, false });
+    TEST_ASSERT_FALSE(detector.isPressed());
+    detector.edge({ 301, true });
+    detector.edge({ 303, false });
+    detector.update(400);
+    TEST_ASSERT_FALSE(detector.isPressed());
+    TEST_ASSERT_EQUAL_size_t(1, log.events.size());
+    TEST_ASSERT_EQUAL_size_t(1, log.take(ButtonEvent::Release));
+}
+
+void test_debounce_settles_after_lockout(void)
+{
+    TestEventLog log;
+    ButtonEventDetector detector({ 20, 300, 800 });
+    detector.addEventCallback(log.callback());
+
+    // Released within the debounce time
+    detector.edge({ 100, true });
+    detector.edge({ 105, false });
+    detector.update(110);
+    TEST_ASSERT_TRUE(detector.isPressed());
+
+    detector.update(120);
+    TEST_ASSERT_FALSE(detector.isPressed());
+    TEST_ASSERT_EQUAL_size_t(2, log.events.size());
+    TEST_ASSERT_TRUE(log.events[0] == ButtonEvent::Press);
+    TEST_ASSERT_TRUE(log.events[1] == ButtonEvent::Release);
+    log.take(ButtonEvent::Press);
+
+    // Settled by the next edge as well, without an update in between
+    detector.edge({ 200, true });
+    detector.edge({ 210, false });
+    detector.edge({ 500, true });
+    TEST_ASSERT_EQUAL_size_t(2, log.take(ButtonEvent::Press));
+}
+
+void test_double_click(void)
+{
+    TestEventLog log;
+    ButtonEventDetector detector({ 20, 300, 800 });
+    detector.addEventCallback(log.callback());
+
+    detector.edge({ 1000, true });
+    detector.edge({ 1100, false });
+    detector.edge({ 1250, true });
+    TEST_ASSERT_EQUAL_size_t(1, log.take(ButtonEvent::DoubleClick));
+
+    // Third click does not continue the double click
+    detector.edge({ 1350, false });
+    detector.edge({ 1450, true });
+    detector.edge({ 1550, false });
+    TEST_ASSERT_EQUAL_size_t(0, log.take(ButtonEvent::DoubleClick));
+
+    // Too slow
+    detector.edge({ 3000, true });
+    detector.edge({ 3100, false });
+    detector.edge({ 3500, true });
+    detector.edge({ 3600, false });
+    TEST_ASSERT_EQUAL_size_t(0, log.take(ButtonEvent::DoubleClick));
+}
+
+void test_long_press(void)
+{
+    TestEventLog log;
+    ButtonEventDetector detector({ 20, 300, 800 });
+    detector.addEventCallback(log.callback());
+
+    detector.edge({ 1000, true });
+    detector.update(1799);
+    TEST_ASSERT_EQUAL_size_t(1, log.take(ButtonEvent::Press));
+
+    detector.update(1800);
+    TEST_ASSERT_EQUAL_size_t(1, log.take(ButtonEvent::LongPress));
+
+    // Once per press
+    detector.update(5000);
+    TEST_ASSERT_EQUAL_size_t(0, log.events.size());
+
+    // Long press does not start a double click
+    detector.edge({ 5100, false });
+    detector.edge({ 5200, true });
+    TEST_ASSERT_EQUAL_size_t(0, log.take(ButtonEvent::DoubleClick));
+
+    // Detected on release, when the edges are processed late
+    detector.edge({ 5300, false });
+    detector.edge({ 8000, true });
+    detector.edge({ 9000, false });
+    TEST_ASSERT_EQUAL_size_t(4, log.events.size());
+    TEST_ASSERT_TRUE(log.events[2] == ButtonEvent::LongPress);
+    TEST_ASSERT_TRUE(log.events[3] == ButtonEvent::Release);
+}
+
+void test_sensor_latches_short_press(void)
+{
+    TestEventLog log;
+    EdgeButtonSensor<> sensor;
+    sensor.addEventCallback(log.callback());
+
+    sensor.update(0);
+    TEST_ASSERT_FALSE(sensor.getValue());
+
+    // Pressed and released between two ticks
+    sensor.pushEdge(true, 5);
+    sensor.pushEdge(false, 40);
+    sensor.update(50);
+    TEST_ASSERT_TRUE(sensor.getValue());
+    TEST_ASSERT_FALSE(sensor.isPressed());
+    TEST_ASSERT_EQUAL_size_t(2, log.events.size());
+
+    sensor.update(60);
+    TEST_ASSERT_FALSE(sensor.getValue());
+
+    // Held across the ticks
+    sensor.pushEdge(true, 100);
+    sensor.update(110);
+    TEST_ASSERT_TRUE(sensor.getValue());
+    sensor.update(120);
+    TEST_ASSERT_TRUE(sensor.getValue());
+}
+
+class TestResyncButtonSensor : public EdgeButtonSensor<4> {
+  public:
+    bool level = false;
+    int resyncs = 0;
+
+  protected:
+    void onEdgesDropped(const std::uint32_t now_ms) override
+    {
+        this->resyncs++;
+        this->injectLevel(this->level, now_ms);
+    }
+};
+
+void test_sensor_resyncs_on_overflow(void)
+{
+    TestResyncButtonSensor sensor;
+
+    // More edges than the queue fits, the input ends up pressed
+    for (std::uint32_t i = 0; i < 7; i++) {
+        sensor.pushEdge(i % 2 == 0, 100 * i);
+    }
+    sensor.level = true;
+    TEST_ASSERT_EQUAL_UINT32(3, sensor.getDroppedEdgeCount());
+
+    // Last queued edge is a release
+    sensor.update(1000);
+    TEST_ASSERT_EQUAL_INT(1, sensor.resyncs);
+    TEST_ASSERT_TRUE(sensor.isPressed());
+
+    sensor.update(1100);
+    TEST_ASSERT_EQUAL_INT(1, sensor.resyncs);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_debounce);
+    RUN_TEST(test_debounce_settles_after_lockout);
+    RUN_TEST(test_double_click);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_sensor_latches_short_press);
+    RUN_TEST(test_sensor_resyncs_on_overflow);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,337 @@
+#include <senseshift/input/calibration.hpp>
+#include <senseshift/input/calibration_store.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor_table.hpp>
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace SenseShift::Input;
+using namespace SenseShift::Input::Calibration;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+class TestStorage : public ICalibrationStorage {
+  public:
+    std::vector<std::uint8_t> data;
+    int writes = 0;
+
+    auto read(std::uint8_t* buffer, const std::size_t capacity) -> std::size_t override
+    {
+        if (this->data.size() > capacity) {
+            return 0;
+        }
+        std::copy(this->data.begin(), this->data.end(), buffer);
+        return this->data.size();
+    }
+
+    auto write(const std::uint8_t* buffer, const std::size_t length) -> bool override
+    {
+        this->data.assign(buffer, buffer + length);
+        this->writes++;
+        return true;
+    }
+};
+
+void test_calibrator_ranges(void)
+{
+    MinMaxCalibrator<float> min_max;
+    CalibrationRange<float> range{};
+
+    // Nothing learned yet
+    TEST_ASSERT_FALSE(min_max.getRange(range));
+
+    min_max.update(0.2F);
+    min_max.update(0.7F);
+    TEST_ASSERT_TRUE(min_max.getRange(range));
+    TEST_ASSERT_EQUAL_FLOAT(0.2F, range.min);
+    TEST_ASSERT_EQUAL_FLOAT(0.7F, range.max);
+
+    MinMaxCalibrator<float> restored;
+    TEST_ASSERT_FALSE(restored.setRange({ 0.8F, 0.1F }));
+    TEST_ASSERT_TRUE(restored.setRange(range));
+    for (const auto input : { 0.0F, 0.3F, 0.45F, 0.6F, 1.0F }) {
+        TEST_ASSERT_EQUAL_FLOAT(min_max.calibrate(input), restored.calibrate(input));
+    }
+
+    CenterPointDeviationCalibrator<float> center(100.0F, 20.0F);
+    TEST_ASSERT_FALSE(center.getRange(range));
+    center.update(0.25F);
+    center.update(0.75F);
+    TEST_ASSERT_TRUE(center.getRange(range));
+
+    CenterPointDeviationCalibrator<float> center_restored(100.0F, 20.0F);
+    TEST_ASSERT_FALSE(center_restored.setRange({ 0.0F, 150.0F }));
+    TEST_ASSERT_TRUE(center_restored.setRange(range));
+    for (const auto input : { 0.0F, 0.4F, 0.5F, 0.6F, 1.0F }) {
+        TEST_ASSERT_EQUAL_FLOAT(center.calibrate(input), center_restored.calibrate(input));
+    }
+
+    // Nothing to persist
+    FixedCenterPointDeviationCalibrator<float> fixed(100.0F, 20.0F);
+    TEST_ASSERT_FALSE(fixed.getRange(range));
+    TEST_ASSERT_FALSE(fixed.setRange({ 0.0F, 1.0F }));
+}
+
+void test_blob_round_trip(void)
+{
+    CalibrationBlob blob;
+    blob.setConfigHash(0xDEADBEEF);
+    TEST_ASSERT_TRUE(blob.set(0, { 0.1F, 0.9F }));
+    TEST_ASSERT_TRUE(blob.set(20, { 30.0F, 70.0F }));
+    TEST_ASSERT_TRUE(blob.set(0, { 0.2F, 0.8F }));
+    TEST_ASSERT_EQUAL_size_t(2, blob.size());
+
+    std::array<std::uint8_t, CalibrationBlob::MAX_SIZE> buffer{};
+    const auto length = blob.encode(buffer.data(), buffer.size());
+    TEST_ASSERT_EQUAL_size_t(8 + 2 * 9 + 2, length);
+    TEST_ASSERT_EQUAL_size_t(0, blob.encode(buffer.data(), length - 1));
+
+    CalibrationBlob decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer.data(), length));
+    TEST_ASSERT_EQUAL_size_t(2, decoded.size());
+    TEST_ASSERT_EQUAL_UINT32(0xDEADBEEF, decoded.getConfigHash());
+
+    CalibrationBlob::Range range{};
+    TEST_ASSERT_TRUE(decoded.get(0, range));
+    TEST_ASSERT_EQUAL_FLOAT(0.2F, range.min);
+    TEST_ASSERT_EQUAL_FLOAT(0.8F, range.max);
+    TEST_ASSERT_TRUE(decoded.get(20, range));
+    TEST_ASSERT_EQUAL_FLOAT(30.0F, range.min);
+    TEST_ASSERT_EQUAL_FLOAT(70.0F, range.max);
+    TEST_ASSERT_FALSE(decoded.get(1, range));
+
+    // Full
+    CalibrationBlob full;
+    for (std::size_t i = 0; i < CalibrationBlob::MAX_ENTRIES; i++) {
+        TEST_ASSERT_TRUE(full.set(static_cast<std::uint8_t>(i), { 0.0F, 1.0F }));
+    }
+    TEST_ASSERT_FALSE(full.set(CalibrationBlob::MAX_ENTRIES, { 0.0F, 1.0F }));
+    TEST_ASSERT_EQUAL_size_t(CalibrationBlob::MAX_SIZE, full.encode(buffer.data(), buffer.size()));
+}
+
+void test_blob_rejects_invalid(void)
+{
+    CalibrationBlob blob;
+    blob.set(3, { 0.1F, 0.9F });
+
+    std::array<std::uint8_t, CalibrationBlob::MAX_SIZE> buffer{};
+    const auto length = blob.encode(buffer.data(), buffer.size());
+
+    CalibrationBlob decoded;
+    TEST_ASSERT_FALSE(decoded.decode(buffer.data(), 0));
+    TEST_ASSERT_FALSE(decoded.decode(buffer.data(), length - 1));
+
+    // Every corrupted byte is detected
+    for (std::size_t i = 0; i < length; i++) {
+        auto corrupted = buffer;
+        corrupted[i] ^= 0x10;
+        TEST_ASSERT_FALSE(decoded.decode(corrupted.data(), length));
+        TEST_ASSERT_EQUAL_size_t(0, decoded.size());
+    }
+
+    // Other version, even with a valid checksum
+    auto other_version = buffer;
+    other_version[2] = CalibrationBlob::VERSION + 1;
+    const auto crc = CalibrationBlob::crc16(other_version.data(), length - 2);
+    other_version[length - 2] = static_cast<std::uint8_t>(crc & 0xFF);
+    other_version[length - 1] = static_cast<std::uint8_t>(crc >> 8);
+    TEST_ASSERT_FALSE(decoded.decode(other_version.data(), length));
+
+    TEST_ASSERT_TRUE(decoded.decode(buffer.data(), length));
+}
+
+void test_store_warm_start(void)
+{
+    TestStorage storage;
+
+    // First boot: nothing stored, calibrate from scratch
+    CalibrationStore first_boot(&storage);
+    TEST_ASSERT_FALSE(first_boot.load());
+
+    MinMaxCalibrator<float> curl;
+    CenterPointDeviationCalibrator<float> splay(100.0F, 20.0F);
+    for (const auto input : { 0.15F, 0.85F, 0.5F }) {
+        curl.update(input);
+        splay.update(input);
+    }
+
+    TEST_ASSERT_TRUE(first_boot.collect(0, curl));
+    TEST_ASSERT_TRUE(first_boot.collect(20, splay));
+    TEST_ASSERT_TRUE(first_boot.save());
+    TEST_ASSERT_EQUAL_INT(1, storage.writes);
+
+    // Same calibration again: not written
+    TEST_ASSERT_TRUE(first_boot.save());
+    TEST_ASSERT_EQUAL_INT(1, storage.writes);
+    TEST_ASSERT_EQUAL_UINT32(1, first_boot.getWriteCount());
+
+    // Second boot: restored before any input
+    CalibrationStore second_boot(&storage);
+    TEST_ASSERT_TRUE(second_boot.load());
+
+    MinMaxCalibrator<float> restored_curl;
+    CenterPointDeviationCalibrator<float> restored_splay(100.0F, 20.0F);
+    MinMaxCalibrator<float> unknown;
+    TEST_ASSERT_TRUE(second_boot.restore(0, restored_curl));
+    TEST_ASSERT_TRUE(second_boot.restore(20, restored_splay));
+    TEST_ASSERT_FALSE(second_boot.restore(1, unknown));
+
+    for (const auto input : { 0.0F, 0.3F, 0.5F, 0.7F, 1.0F }) {
+        TEST_ASSERT_EQUAL_FLOAT(curl.calibrate(input), restored_curl.calibrate(input));
+        TEST_ASSERT_EQUAL_FLOAT(splay.calibrate(input), restored_splay.calibrate(input));
+    }
+
+    // Loaded blob is not written back unchanged
+    TEST_ASSERT_TRUE(second_boot.save());
+    TEST_ASSERT_EQUAL_INT(1, storage.writes);
+
+    restored_curl.update(0.95F);
+    TEST_ASSERT_TRUE(second_boot.collect(0, restored_curl));
+    TEST_ASSERT_TRUE(second_boot.save());
+    TEST_ASSERT_EQUAL_INT(2, storage.writes);
+}
+
+void test_store_corrupted_storage(void)
+{
+    TestStorage storage;
+    storage.data = { 'S', 'C', CalibrationBlob::VERSION, 1, 0, 0, 0, 0, 0, 0, 0 };
+
+    CalibrationStore store(&storage);
+    TEST_ASSERT_FALSE(store.load());
+    TEST_ASSERT_EQUAL_size_t(0, store.getBlob().size());
+
+    MinMaxCalibrator<float> calibrator;
+    TEST_ASSERT_FALSE(store.restore(0, calibrator));
+}
+
+void test_store_other_config(void)
+{
+    TestStorage storage;
+
+    CalibrationStore first_boot(&storage, CalibrationBlob::configHash("36,false|39,false"));
+    MinMaxCalibrator<float> curl;
+    curl.update(0.2F);
+    curl.update(0.4F);
+    TEST_ASSERT_TRUE(first_boot.collect(0, curl));
+    TEST_ASSERT_TRUE(first_boot.save());
+
+    CalibrationStore same_config(&storage, CalibrationBlob::configHash("36,false|39,false"));
+    TEST_ASSERT_TRUE(same_config.load());
+
+    // The pins were swapped: the ranges belong to the other sensors
+    CalibrationStore other_config(&storage, CalibrationBlob::configHash("39,false|36,false"));
+    TEST_ASSERT_FALSE(other_config.load());
+    TEST_ASSERT_EQUAL_size_t(0, other_config.getBlob().size());
+
+    MinMaxCalibrator<float> restored;
+    TEST_ASSERT_FALSE(other_config.restore(0, restored));
+
+    // Written back with the new configuration
+    TEST_ASSERT_TRUE(other_config.save());
+    TEST_ASSERT_EQUAL_INT(2, storage.writes);
+
+    CalibrationStore next_boot(&storage, CalibrationBlob::configHash("39,false|36,false"));
+    TEST_ASSERT_TRUE(next_boot.load());
+}
+
+void test_sensor_table_ranges(void)
+{
+    SensorTable<2> table;
+    table.bind(0, new FloatSensor(), true);
+    table.bind(1, new FloatSensor());
+
+    CalibrationRange<float> range{};
+    TEST_ASSERT_FALSE(table.getCalibrationRange(0, range));
+    TEST_ASSERT_FALSE(table.getCalibrationRange(1, range));
+
+    TEST_ASSERT_FALSE(table.setCalibrationRange(1, { 0.2F, 0.6F }));
+    TEST_ASSERT_FALSE(table.setCalibrationRange(0, { 0.6F, 0.2F }));
+    TEST_ASSERT_TRUE(table.setCalibrationRange(0, { 0.2F, 0.6F }));
+
+    TEST_ASSERT_TRUE(table.getCalibrationRange(0, range));
+    TEST_ASSERT_EQUAL_FLOAT(0.2F, range.min);
+    TEST_ASSERT_EQUAL_FLOAT(0.6F, range.max);
+
+    // Restored range is applied without calibrating
+    table.getSensor(0)->publishState(0.4F);
+    table.tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, table.getValue(0));
+}
+
+void test_file_storage(void)
+{
+    const char* path = "test_io_calibration_store.bin";
+    std::remove(path);
+
+    FileCalibrationStorage storage(path);
+    std::array<std::uint8_t, CalibrationBlob::MAX_SIZE> buffer{};
+    TEST_ASSERT_EQUAL_size_t(0, storage.read(buffer.data(), buffer.size()));
+
+    CalibrationStore store(&storage);
+    TEST_ASSERT_FALSE(store.load());
+    store.getBlob().set(7, { 0.25F, 0.75F });
+    TEST_ASSERT_TRUE(store.save());
+
+    CalibrationStore reloaded(&storage);
+    TEST_ASSERT_TRUE(reloaded.load());
+
+    CalibrationBlob::Range range{};
+    TEST_ASSERT_TRUE(reloaded.getBlob().get(7, range));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, range.min);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, range.max);
+
+    // Does not fit the buffer
+    TEST_ASSERT_EQUAL_size_t(0, storage.read(buffer.data(), 4));
+
+    std::remove(path);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_calibrator_ranges);
+    RUN_TEST(test_blob_round_trip);
+    RUN_TEST(test_blob_rejects_invalid);
+    RUN_TEST(test_store_warm_start);
+    RUN_TEST(test_store_corrupted_storage);
+    RUN_TEST(test_store_other_config);
+    RUN_TEST(test_sensor_table_ranges);
+    RUN_TEST(test_file_storage);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
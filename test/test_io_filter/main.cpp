@@ -2,7 +2,12 @@
 #include <senseshift/input/sensor.hpp>
 #include <unity.h>
 
+#include <climits>
+#include <cmath>
+#include <cstdio>
 #include <map>
+#include <random>
+#include <vector>
 
 #define ASSERT_EQUAL_FLOAT_ROUNDED(expected, actual, precision)                \
     TEST_ASSERT_EQUAL_FLOAT(                                                   \
@@ -103,6 +108,83 @@ void test_sliding_window_moving_average_filter(void)
     ASSERT_EQUAL_FLOAT_ROUNDED(11.33f, filter->filter(nullptr, 12.0f), 2); // (11 + 11 + 12) / 3 = 11.33
 }
 
+void test_static_sliding_window_moving_average_filter(void)
+{
+    IFilter<float>* filter = new StaticSlidingWindowMovingAverageFilter<float, 3>();
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, filter->filter(nullptr, 1.0f));   // 1 / 1 = 1
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, filter->filter(nullptr, 2.0f));   // (1 + 2) / 2 = 1.5
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, filter->filter(nullptr, 3.0f));   // (1 + 2 + 3) / 3 = 2
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, filter->filter(nullptr, 4.0f));   // (2 + 3 + 4) / 3 = 3
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, filter->filter(nullptr, 5.0f));   // (3 + 4 + 5) / 3 = 4
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, filter->filter(nullptr, 21.0f)); // (4 + 5 + 21) / 3 = 10
+
+    ASSERT_EQUAL_FLOAT_ROUNDED(15.67f, filter->filter(nullptr, 21.0f), 2); // (5 + 21 + 21) / 3 = 15.67
+    TEST_ASSERT_EQUAL_FLOAT(21.0f, filter->filter(nullptr, 21.0f));        // (21 + 21 + 21) / 3 = 21
+
+    auto* int_filter = new StaticSlidingWindowMovingAverageFilter<int, 4>();
+    TEST_ASSERT_EQUAL_INT(4000, int_filter->filter(nullptr, 4000));
+    TEST_ASSERT_EQUAL_INT(4001, int_filter->filter(nullptr, 4002));
+    TEST_ASSERT_EQUAL_INT(4002, int_filter->filter(nullptr, 4004));
+    TEST_ASSERT_EQUAL_INT(4003, int_filter->filter(nullptr, 4006));
+    TEST_ASSERT_EQUAL_INT(4005, int_filter->filter(nullptr, 4008)); // (4002 + 4004 + 4006 + 4008) / 4 = 4005
+}
+
+void test_static_sliding_window_moving_average_filter_does_not_drift(void)
+{
+    auto* filter = new StaticSlidingWindowMovingAverageFilter<float, 8>();
+    auto* reference = new SlidingWindowMovingAverageFilter<float>(8);
+
+    float value = 0.0f;
+    float expected = 0.0f;
+    for (auto i = 0; i < 100000; i++) {
+        // Mix of large and small values, so the running sum loses precision
+        const float sample = (i % 7 == 0) ? 1000.0f : static_cast<float>(i % 13) / 13.0f;
+        value = filter->filter(nullptr, sample);
+        expected = reference->filter(nullptr, sample);
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, value);
+}
+
+void test_static_sliding_window_median_filter(void)
+{
+    IFilter<float>* filter = new StaticSlidingWindowMedianFilter<float, 3>();
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, filter->filter(nullptr, 1.0f));   // [1]
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, filter->filter(nullptr, 2.0f));   // [1, 2]
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, filter->filter(nullptr, 100.0f)); // [1, 2, 100]
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, filter->filter(nullptr, 3.0f));   // [2, 3, 100]
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, filter->filter(nullptr, 4.0f));   // [3, 4, 100]
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, filter->filter(nullptr, -5.0f));  // [-5, 3, 4]
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, filter->filter(nullptr, 5.0f));   // [-5, 4, 5]
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, filter->filter(nullptr, 6.0f));   // [-5, 5, 6]
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, filter->filter(nullptr, 5.0f));   // [5, 5, 6]
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, filter->filter(nullptr, 5.0f));   // [5, 5, 6]
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, filter->filter(nullptr, 5.0f));   // [5, 5, 5]
+
+    // The mean of the middle values does not overflow
+    auto* int_filter = new StaticSlidingWindowMedianFilter<int, 4>();
+    int_filter->filter(nullptr, INT_MAX);
+    TEST_ASSERT_EQUAL_INT(INT_MAX - 1, int_filter->filter(nullptr, INT_MAX - 2)); // [MAX - 2, MAX]
+}
+
+void test_static_sliding_window_trimmed_mean_filter(void)
+{
+    IFilter<float>* filter = new StaticSlidingWindowTrimmedMeanFilter<float, 5, 1>();
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, filter->filter(nullptr, 1.0f));    // [1]
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, filter->filter(nullptr, 2.0f));    // [1, 2]
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, filter->filter(nullptr, 100.0f));  // [(1), 2, (100)]
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, filter->filter(nullptr, 3.0f));    // [(1), 2, 3, (100)]
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, filter->filter(nullptr, 4.0f));    // [(1), 2, 3, 4, (100)]
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, filter->filter(nullptr, 5.0f));    // [(2), 3, 4, 5, (100)]
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, filter->filter(nullptr, -50.0f));  // [(-50), 3, 4, 5, (100)]
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, filter->filter(nullptr, 6.0f));    // [(-50), 3, 4, 5, (6)]
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, filter->filter(nullptr, 7.0f));    // [(-50), 4, 5, 6, (7)]
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, filter->filter(nullptr, 8.0f));    // [(-50), 5, 6, 7, (8)]
+}
+
 void test_exponential_moving_average_filter(void)
 {
     IFilter<float>* filter = new ExponentialMovingAverageFilter<float>(0.5f);
@@ -130,6 +212,141 @@ void test_exponential_moving_average_filter(void)
     ASSERT_EQUAL_FLOAT_ROUNDED(4.999889, filter->filter(nullptr, 5.0f), 2); // (0.9 * 5.0) + (0.1 * 4.99889) = 4.999889
 }
 
+void test_one_euro_filter(void)
+{
+    // Without the speed term, it is an exponential moving average with the fixed cutoff
+    OneEuroFilter<float> filter(100.0f, 1.0f, 0.0f);
+    const auto alpha = 1.0f / (1.0f + 100.0f / (2.0f * static_cast<float>(M_PI) * 1.0f));
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, filter.filter(nullptr, 1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f + alpha, filter.filter(nullptr, 2.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f + alpha + alpha * (2.0f - 1.0f - alpha), filter.filter(nullptr, 2.0f));
+}
+
+void test_alpha_beta_filter(void)
+{
+    AlphaBetaFilter<float> filter(0.5f, 0.1f, 2.0f);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, filter.filter(nullptr, 1.0f));
+
+    // Predicted 1.0, residual 1.0: value 1.5, velocity 0.1, extrapolated 2 samples ahead
+    TEST_ASSERT_EQUAL_FLOAT(1.7f, filter.filter(nullptr, 2.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, filter.getVelocity());
+}
+
+struct FilterResponse {
+    /// Samples until the output first gets within 10% of the step from the new level.
+    std::size_t step_lag;
+    /// Steady lag on the ramp, in samples. Negative, when the output is ahead.
+    float ramp_lag;
+    /// Standard deviation of the output at rest, with the noisy input.
+    float rest_noise;
+};
+
+/// Response of the filter to a finger-like input, normalized to 0..1 and sampled at 100 Hz.
+template<typename Factory>
+auto measure_response(Factory make_filter, const std::size_t input_delay = 0) -> FilterResponse
+{
+    FilterResponse response{};
+
+    // Step from 0.2 to 0.8
+    {
+        auto filter = make_filter();
+        for (auto i = 0; i < 100; i++) {
+            filter.filter(nullptr, 0.2f);
+        }
+        std::size_t lag = 0;
+        while (lag < 100 && std::fabs(filter.filter(nullptr, 0.8f) - 0.8f) > 0.06f) {
+            lag++;
+        }
+        response.step_lag = lag;
+    }
+
+    // Ramp at 0.02 per sample (full curl in half a second), seen with the given delay
+    {
+        constexpr float slope = 0.02f;
+        auto filter = make_filter();
+        float output = 0.0f;
+        for (std::size_t i = 0; i < 40; i++) {
+            const auto delayed = static_cast<float>(i < input_delay ? 0 : i - input_delay);
+            output = filter.filter(nullptr, 0.1f + slope * delayed);
+        }
+        // Against the actual (not delayed) position
+        response.ramp_lag = (0.1f + slope * 39.0f - output) / slope;
+    }
+
+    // Rest with the ADC-like noise
+    {
+        std::mt19937 random(42);
+        std::normal_distribution<float> noise(0.0f, 0.01f);
+
+        auto filter = make_filter();
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        for (auto i = 0; i < 1000; i++) {
+            const auto output = filter.filter(nullptr, 0.5f + noise(random));
+            if (i >= 100) {
+                sum += output;
+                sum_squares += static_cast<double>(output) * output;
+            }
+        }
+        const auto mean = sum / 900.0;
+        response.rest_noise = static_cast<float>(std::sqrt(sum_squares / 900.0 - mean * mean));
+    }
+
+    return response;
+}
+
+void report_response(const char* name, const FilterResponse& response)
+{
+    char message[128];
+    snprintf(
+      message,
+      sizeof(message),
+      "%s: step lag %u samples, ramp lag %.2f samples, rest noise %.4f",
+      name,
+      static_cast<unsigned>(response.step_lag),
+      response.ramp_lag,
+      response.rest_noise
+    );
+    TEST_MESSAGE(message);
+}
+
+void test_adaptive_filters_response(void)
+{
+    const auto ema_fast = measure_response([] { return ExponentialMovingAverageFilter<float>(0.8f); });
+    const auto ema_smooth = measure_response([] { return ExponentialMovingAverageFilter<float>(0.2f); });
+    const auto one_euro = measure_response([] { return OneEuroFilter<float>(100.0f, 1.0f, 20.0f); });
+    const auto alpha_beta = measure_response([] { return AlphaBetaFilter<float>(0.3f, 0.053f); });
+
+    report_response("ema(0.8)", ema_fast);
+    report_response("ema(0.2)", ema_smooth);
+    report_response("one-euro(1 Hz, 20)", one_euro);
+    report_response("alpha-beta(0.3, 0.053)", alpha_beta);
+
+    // Smoother at rest than the fast moving average, with a fraction of the lag of the equally smooth one
+    TEST_ASSERT_LESS_THAN_FLOAT(ema_fast.rest_noise, one_euro.rest_noise);
+    TEST_ASSERT_LESS_THAN_FLOAT(ema_smooth.ramp_lag / 2.0f, one_euro.ramp_lag);
+    TEST_ASSERT_LESS_THAN_size_t(ema_smooth.step_lag, one_euro.step_lag);
+
+    // No steady lag on the ramp at all
+    TEST_ASSERT_LESS_THAN_FLOAT(ema_fast.rest_noise, alpha_beta.rest_noise);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, alpha_beta.ramp_lag);
+}
+
+void test_alpha_beta_compensates_delay(void)
+{
+    constexpr std::size_t delay = 3;
+
+    const auto delayed = measure_response([] { return AlphaBetaFilter<float>(0.3f, 0.053f); }, delay);
+    const auto compensated = measure_response([] { return AlphaBetaFilter<float>(0.3f, 0.053f, delay); }, delay);
+
+    report_response("alpha-beta, 3 samples late", delayed);
+    report_response("alpha-beta, 3 samples late, 3 samples lead", compensated);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, static_cast<float>(delay), delayed.ramp_lag);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, compensated.ramp_lag);
+}
+
 void test_center_deadzone_filter(void)
 {
     IFilter<float>* filter = new CenterDeadzoneFilter(0.1f);
@@ -173,6 +390,55 @@ void test_lookup_table_interpolate_linear_filter(void)
     TEST_ASSERT_EQUAL_FLOAT(17.5f, filter->filter(nullptr, 6.0f));
 }
 
+void test_static_filter_chain(void)
+{
+    auto chain = StaticFilterChain(MultiplyFilter<float>(2.0f), AddFilter<float>(1.0f), ClampFilter<float>(0.0f, 10.0f));
+
+    TEST_ASSERT_EQUAL(3, chain.size());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, chain.filter(nullptr, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, chain.filter(nullptr, 2.0f));  // 2 * 2 + 1 = 5
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, chain.filter(nullptr, 6.0f)); // 6 * 2 + 1 = 13, clamped to 10
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, chain.filter(nullptr, -3.0f)); // -3 * 2 + 1 = -5, clamped to 0
+}
+
+void test_static_filter_chain_keeps_state(void)
+{
+    auto chain = StaticFilterChain(ExponentialMovingAverageFilter<float>(0.5f), AnalogInvertFilter());
+    auto runtime = std::vector<IFilter<float>*>{ new ExponentialMovingAverageFilter<float>(0.5f),
+                                                 new AnalogInvertFilter() };
+
+    for (const auto value : { 0.0f, 1.0f, 0.25f, 0.75f, 0.5f }) {
+        auto expected = value;
+        for (auto* filter : runtime) {
+            expected = filter->filter(nullptr, expected);
+        }
+
+        TEST_ASSERT_EQUAL_FLOAT(expected, chain.filter(nullptr, value));
+    }
+
+    // The chain can also be used as a single node of the runtime chain
+    IFilter<float>* filter = new StaticFilterChain(MultiplyFilter<float>(3.0f), SubtractFilter<float>(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, filter->filter(nullptr, 2.0f));
+}
+
+void test_static_filter_chain_identity(void)
+{
+    // Filters, disabled at compile time, are left out of the chain
+    constexpr bool invert = false;
+    auto chain = StaticFilterChain(
+      MultiplyFilter<float>(0.5f),
+      std::conditional_t<invert, AnalogInvertFilter, IdentityFilter<float>>()
+    );
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, chain.filter(nullptr, 0.5f));
+
+    constexpr bool inverted = true;
+    auto inverted_chain = StaticFilterChain(
+      MultiplyFilter<float>(0.5f),
+      std::conditional_t<inverted, AnalogInvertFilter, IdentityFilter<float>>()
+    );
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, inverted_chain.filter(nullptr, 0.5f));
+}
+
 int process(void)
 {
     UNITY_BEGIN();
@@ -184,9 +450,20 @@ int process(void)
     RUN_TEST(test_clamp_filter);
     RUN_TEST(test_lambda_filter);
     RUN_TEST(test_sliding_window_moving_average_filter);
+    RUN_TEST(test_static_sliding_window_moving_average_filter);
+    RUN_TEST(test_static_sliding_window_moving_average_filter_does_not_drift);
+    RUN_TEST(test_static_sliding_window_median_filter);
+    RUN_TEST(test_static_sliding_window_trimmed_mean_filter);
     RUN_TEST(test_exponential_moving_average_filter);
+    RUN_TEST(test_one_euro_filter);
+    RUN_TEST(test_alpha_beta_filter);
+    RUN_TEST(test_adaptive_filters_response);
+    RUN_TEST(test_alpha_beta_compensates_delay);
     RUN_TEST(test_center_deadzone_filter);
     RUN_TEST(test_lookup_table_interpolate_linear_filter);
+    RUN_TEST(test_static_filter_chain);
+    RUN_TEST(test_static_filter_chain_keeps_state);
+    RUN_TEST(test_static_filter_chain_identity);
 
     return UNITY_END();
 }
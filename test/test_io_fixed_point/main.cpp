@@ -0,0 +1,288 @@
+#include <senseshift/input/calibration.hpp>
+#include <senseshift/input/filter.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor/fixed_point.hpp>
+#include <senseshift/math/fixed_point.hpp>
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace SenseShift::Input;
+using namespace SenseShift::Input::Calibration;
+using SenseShift::Math::Q15;
+
+using Fixed = Q15::ValueType;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// One LSB of Q15, as a float.
+constexpr float LSB = 1.0F / static_cast<float>(Q15::ONE);
+
+/// 12-bit ADC, replaying the same readings for the float and the fixed-point pipelines.
+class TestAdc {
+  public:
+    std::vector<std::uint16_t> readings;
+    std::size_t position = 0;
+
+    auto next() -> std::uint16_t
+    {
+        return this->readings[this->position++ % this->readings.size()];
+    }
+};
+
+class TestFloatAdcSensor : public IFloatSimpleSensor {
+  public:
+    explicit TestFloatAdcSensor(TestAdc adc) : adc_(std::move(adc))
+    {
+    }
+
+    void init() override
+    {
+    }
+
+    auto getValue() -> float override
+    {
+        return static_cast<float>(this->adc_.next()) / 4095.0F;
+    }
+
+  private:
+    TestAdc adc_;
+};
+
+class TestFixedAdcSensor : public ISimpleSensor<Fixed> {
+  public:
+    explicit TestFixedAdcSensor(TestAdc adc) : adc_(std::move(adc))
+    {
+    }
+
+    void init() override
+    {
+    }
+
+    auto getValue() -> Fixed override
+    {
+        return Q15::fromRaw<4095>(this->adc_.next());
+    }
+
+  private:
+    TestAdc adc_;
+};
+
+/// Finger-like signal: slow sweeps with ADC noise.
+auto make_readings(std::size_t count) -> TestAdc
+{
+    std::mt19937 random(7);
+    std::normal_distribution<float> noise(0.0F, 15.0F);
+
+    TestAdc adc;
+    for (std::size_t i = 0; i < count; i++) {
+        const auto level = 2048.0F + 1500.0F * std::sin(static_cast<float>(i) * 0.01F);
+        adc.readings.push_back(static_cast<std::uint16_t>(std::clamp(level + noise(random), 0.0F, 4095.0F)));
+    }
+    return adc;
+}
+
+void test_format_conversions(void)
+{
+    TEST_ASSERT_EQUAL_INT32(32768, Q15::ONE);
+    TEST_ASSERT_EQUAL_INT32(Q15::HALF, Q15::fromFloat(0.5F));
+    TEST_ASSERT_EQUAL_INT32(-Q15::HALF, Q15::fromFloat(-0.5F));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, Q15::toFloat(Q15::ONE / 4));
+    TEST_ASSERT_EQUAL_INT32(Q15::ONE / 4, Q15::multiply(Q15::HALF, Q15::HALF));
+
+    // Every ADC reading is within half of the LSB from the float conversion
+    TEST_ASSERT_EQUAL_INT32(0, Q15::fromRaw<4095>(0));
+    TEST_ASSERT_EQUAL_INT32(Q15::ONE, Q15::fromRaw<4095>(4095));
+    TEST_ASSERT_EQUAL_INT32(Q15::ONE, Q15::fromRaw<1023>(1023));
+
+    float max_error = 0.0F;
+    for (std::uint32_t raw = 0; raw <= 4095; raw++) {
+        const auto error = std::fabs(Q15::toFloat(Q15::fromRaw<4095>(raw)) - static_cast<float>(raw) / 4095.0F);
+        max_error = std::max(max_error, error);
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(0.51F * LSB, max_error);
+}
+
+void test_ema_cross_check(void)
+{
+    auto adc = make_readings(5000);
+
+    for (const auto alpha : { 0.1F, 0.5F, 0.8F }) {
+        Filter::ExponentialMovingAverageFilter<float> float_ema(alpha);
+        Filter::ExponentialMovingAverageFilter<Fixed> fixed_ema(alpha);
+
+        float max_error = 0.0F;
+        for (const auto raw : adc.readings) {
+            const auto expected = float_ema.filter(nullptr, static_cast<float>(raw) / 4095.0F);
+            const auto actual = Q15::toFloat(fixed_ema.filter(nullptr, Q15::fromRaw<4095>(raw)));
+            max_error = std::max(max_error, std::fabs(expected - actual));
+        }
+
+        char message[64];
+        snprintf(message, sizeof(message), "ema(%.1f): max error %.2f LSB", alpha, max_error / LSB);
+        TEST_MESSAGE(message);
+
+        // The rounding does not accumulate
+        TEST_ASSERT_LESS_THAN_FLOAT(2.0F * LSB, max_error);
+    }
+}
+
+void test_ema_settles_on_small_steps(void)
+{
+    // With an integer accumulator, steps smaller than 1 / alpha would never be reached
+    Filter::ExponentialMovingAverageFilter<Fixed> ema(0.05F);
+    ema.filter(nullptr, 1000);
+
+    Fixed value = 0;
+    for (auto i = 0; i < 500; i++) {
+        value = ema.filter(nullptr, 1010);
+    }
+    TEST_ASSERT_EQUAL_INT32(1010, value);
+}
+
+void test_calibrator_cross_check(void)
+{
+    MinMaxCalibrator<float> float_calibrator;
+    MinMaxCalibrator<Fixed> fixed_calibrator(0, Q15::ONE);
+
+    // Neutral before any data
+    TEST_ASSERT_EQUAL_INT32(Q15::HALF, fixed_calibrator.calibrate(Q15::fromFloat(0.3F)));
+
+    for (const auto input : { 0.2F, 0.75F, 0.4F }) {
+        float_calibrator.update(input);
+        fixed_calibrator.update(Q15::fromFloat(input));
+    }
+
+    float max_error = 0.0F;
+    for (auto i = 0; i <= 1000; i++) {
+        const auto input = static_cast<float>(i) / 1000.0F;
+        const auto expected = float_calibrator.calibrate(input);
+        const auto actual = Q15::toFloat(fixed_calibrator.calibrate(Q15::fromFloat(input)));
+        max_error = std::max(max_error, std::fabs(expected - actual));
+    }
+
+    // Scaled up by the 1 / 0.55 of the calibrated range
+    TEST_ASSERT_LESS_THAN_FLOAT(4.0F * LSB, max_error);
+}
+
+void test_pipeline_cross_check(void)
+{
+    const auto adc = make_readings(2000);
+
+    // Float pipeline, as in the finger sensors
+    auto* float_sensor = new StaticFilteredSensorDecorator(
+      new TestFloatAdcSensor(adc),
+      Filter::StaticFilterChain(Filter::ExponentialMovingAverageFilter<float>(0.8F))
+    );
+    float_sensor->addFilter(new Filter::AnalogInvertFilter());
+    float_sensor->setCalibrator(new MinMaxCalibrator<float>());
+
+    // The same, in fixed point, converted to float at the end
+    auto* fixed_source = new StaticFilteredSensorDecorator(
+      new TestFixedAdcSensor(adc),
+      Filter::StaticFilterChain(Filter::ExponentialMovingAverageFilter<Fixed>(0.8F))
+    );
+    fixed_source->addFilter(new Filter::FixedPointAnalogInvertFilter<Q15>());
+    FixedPointSensorAdapter<Q15> fixed_sensor(fixed_source, new MinMaxCalibrator<Fixed>(0, Q15::ONE));
+
+    float_sensor->init();
+    fixed_sensor.init();
+    float_sensor->startCalibration();
+    fixed_sensor.startCalibration();
+
+    float max_error = 0.0F;
+    for (std::size_t i = 0; i < adc.readings.size(); i++) {
+        if (i == adc.readings.size() / 2) {
+            float_sensor->stopCalibration();
+            fixed_sensor.stopCalibration();
+        }
+
+        float_sensor->tick();
+        fixed_sensor.tick();
+
+        // While the learned range is only a few readings wide, any rounding is scaled up by the calibration
+        if (i >= 100) {
+            max_error = std::max(max_error, std::fabs(float_sensor->getValue() - fixed_sensor.getValue()));
+        }
+    }
+
+    char message[64];
+    snprintf(message, sizeof(message), "pipeline: max error %.2f LSB (%.6f)", max_error / LSB, max_error);
+    TEST_MESSAGE(message);
+
+    // Well below the 12-bit ADC resolution
+    TEST_ASSERT_LESS_THAN_FLOAT(1.0F / 4095.0F, max_error);
+}
+
+void test_adapter_calibration_range(void)
+{
+    auto* calibrator = new MinMaxCalibrator<Fixed>(0, Q15::ONE);
+    FixedPointSensorAdapter<Q15> sensor(new Sensor<Fixed>(), calibrator);
+
+    TEST_ASSERT_NOT_NULL(sensor.getCalibrator());
+
+    CalibrationRange<float> range{};
+    TEST_ASSERT_FALSE(sensor.getCalibrator()->getRange(range));
+
+    // Restored from the float blob into the fixed-point calibrator
+    TEST_ASSERT_TRUE(sensor.getCalibrator()->setRange({ 0.25F, 0.75F }));
+    TEST_ASSERT_TRUE(sensor.getCalibrator()->getRange(range));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, range.min);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, range.max);
+    TEST_ASSERT_EQUAL_INT32(Q15::HALF, calibrator->calibrate(Q15::HALF));
+
+    sensor.resetCalibration();
+    TEST_ASSERT_FALSE(sensor.getCalibrator()->getRange(range));
+
+    // Without a calibrator, nothing to forward
+    FixedPointSensorAdapter<Q15> uncalibrated(new Sensor<Fixed>());
+    TEST_ASSERT_NULL(uncalibrated.getCalibrator());
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_format_conversions);
+    RUN_TEST(test_ema_cross_check);
+    RUN_TEST(test_ema_settles_on_small_steps);
+    RUN_TEST(test_calibrator_cross_check);
+    RUN_TEST(test_pipeline_cross_check);
+    RUN_TEST(test_adapter_calibration_range);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
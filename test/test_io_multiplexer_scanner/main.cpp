@@ -0,0 +1,172 @@
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor/multiplexer_scanner.hpp>
+#include <unity.h>
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+using namespace SenseShift::Input;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Records the selected channels. The GPIO writes of the real one are tested in test_arduino_multiplexer.
+template<std::size_t N>
+class TestMultiplexer {
+  public:
+    int setupCounter = 0;
+    std::uint8_t activeChannel = 0;
+    std::vector<std::uint8_t> selected{};
+
+    void init()
+    {
+        this->setupCounter++;
+    }
+
+    void selectChannel(const std::uint8_t channel)
+    {
+        this->activeChannel = channel;
+        this->selected.push_back(channel);
+    }
+};
+
+/// Returns a distinct value for every selected channel of the multiplexer.
+template<std::size_t N>
+class TestMultiplexedSignal : public IFloatSimpleSensor {
+  public:
+    explicit TestMultiplexedSignal(TestMultiplexer<N>* mux) : mux_(mux)
+    {
+    }
+
+    int setupCounter = 0;
+
+    void init() override
+    {
+        this->setupCounter++;
+    }
+
+    auto getValue() -> float override
+    {
+        return static_cast<float>(this->mux_->activeChannel) / 100.0F;
+    }
+
+  private:
+    TestMultiplexer<N>* mux_;
+};
+
+void test_gray_code_rank(void)
+{
+    // Gray code sequence: 0, 1, 3, 2, 6, 7, 5, 4
+    TEST_ASSERT_EQUAL_UINT8(0, grayCodeRank(0b000));
+    TEST_ASSERT_EQUAL_UINT8(1, grayCodeRank(0b001));
+    TEST_ASSERT_EQUAL_UINT8(2, grayCodeRank(0b011));
+    TEST_ASSERT_EQUAL_UINT8(3, grayCodeRank(0b010));
+    TEST_ASSERT_EQUAL_UINT8(4, grayCodeRank(0b110));
+    TEST_ASSERT_EQUAL_UINT8(5, grayCodeRank(0b111));
+    TEST_ASSERT_EQUAL_UINT8(6, grayCodeRank(0b101));
+    TEST_ASSERT_EQUAL_UINT8(7, grayCodeRank(0b100));
+    TEST_ASSERT_EQUAL_UINT8(15, grayCodeRank(0b1000));
+}
+
+void test_scanner_orders_channels(void)
+{
+    auto* mux = new TestMultiplexer<3>();
+    auto* scanner = new MultiplexerScanner(mux, new TestMultiplexedSignal(mux));
+
+    for (std::uint8_t channel = 0; channel < 8; channel++) {
+        scanner->addChannel(channel, new FloatSensor());
+    }
+
+    const std::uint8_t expected[] = { 0, 1, 3, 2, 6, 7, 5, 4 };
+    const auto& channels = scanner->getChannels();
+    TEST_ASSERT_EQUAL_size_t(8, channels.size());
+    for (std::size_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_UINT8(expected[i], channels[i].channel);
+    }
+}
+
+void test_scanner_publishes_values(void)
+{
+    auto* mux = new TestMultiplexer<3>();
+    auto* signal = new TestMultiplexedSignal(mux);
+    auto* scanner = new MultiplexerScanner(mux, signal);
+
+    auto* sensor_a = new FloatSensor();
+    auto* sensor_b = new FloatSensor();
+    auto* sensor_c = new FloatSensor();
+    scanner->addChannel(5, sensor_a);
+    scanner->addChannel(2, sensor_b);
+    scanner->addChannel(7, sensor_c);
+
+    scanner->init();
+    TEST_ASSERT_EQUAL_INT(1, mux->setupCounter);
+    TEST_ASSERT_EQUAL_INT(1, signal->setupCounter);
+
+    scanner->tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.05F, sensor_a->getValue());
+    TEST_ASSERT_EQUAL_FLOAT(0.02F, sensor_b->getValue());
+    TEST_ASSERT_EQUAL_FLOAT(0.07F, sensor_c->getValue());
+}
+
+void test_scanner_toggles_single_pin(void)
+{
+    auto* mux = new TestMultiplexer<4>();
+    auto* scanner = new MultiplexerScanner(mux, new TestMultiplexedSignal(mux));
+
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        scanner->addChannel(channel, new FloatSensor());
+    }
+    scanner->init();
+
+    scanner->tick();
+    scanner->tick();
+    TEST_ASSERT_EQUAL_size_t(32, mux->selected.size());
+
+    // including the wrap-around from the last channel back to channel 0
+    for (std::size_t i = 1; i < mux->selected.size(); i++) {
+        const std::uint8_t changed = mux->selected[i - 1] ^ mux->selected[i];
+        TEST_ASSERT_EQUAL_size_t(1, std::bitset<8>(changed).count());
+    }
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_gray_code_rank);
+    RUN_TEST(test_scanner_orders_channels);
+    RUN_TEST(test_scanner_publishes_values);
+    RUN_TEST(test_scanner_toggles_single_pin);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,143 @@
+#include <senseshift/output/output.hpp>
+#include <unity.h>
+
+using namespace SenseShift::Output;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+class TestOutput : public IFloatOutput {
+  public:
+    int setupCounter = 0;
+    int writes = 0;
+    float value = 0.0F;
+
+    void init() override
+    {
+        this->setupCounter++;
+    }
+
+    void writeState(float newValue) override
+    {
+        this->value = newValue;
+        this->writes++;
+    }
+};
+
+void test_change_only_init(void)
+{
+    auto* output = new TestOutput();
+    auto* decorator = new ChangeOnlyOutputDecorator(output, 4095);
+
+    decorator->init();
+
+    TEST_ASSERT_EQUAL_INT(1, output->setupCounter);
+    TEST_ASSERT_EQUAL_PTR(output, decorator->getOutput());
+}
+
+void test_change_only_first_write(void)
+{
+    auto* output = new TestOutput();
+    auto* decorator = new ChangeOnlyOutputDecorator(output, 4095);
+
+    // Even the zero value is written, as the initial state of the output is unknown
+    decorator->writeState(0.0F);
+
+    TEST_ASSERT_EQUAL_INT(1, output->writes);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, output->value);
+}
+
+void test_change_only_skips_unchanged(void)
+{
+    auto* output = new TestOutput();
+    OutputWriteCounters counters;
+    auto* decorator = new ChangeOnlyOutputDecorator(output, 4095, &counters);
+
+    decorator->writeState(0.5F);
+    decorator->writeState(0.5F);
+    decorator->writeState(0.5F);
+    decorator->writeState(1.0F);
+    decorator->writeState(0.5F);
+
+    TEST_ASSERT_EQUAL_INT(3, output->writes);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, output->value);
+    TEST_ASSERT_EQUAL_UINT32(3, counters.issued);
+    TEST_ASSERT_EQUAL_UINT32(2, counters.suppressed);
+}
+
+void test_change_only_compares_quantised(void)
+{
+    auto* output = new TestOutput();
+    OutputWriteCounters counters;
+    auto* decorator = new ChangeOnlyOutputDecorator(output, 255, &counters);
+
+    decorator->writeState(0.5F);   // 127
+    decorator->writeState(0.501F); // 127
+    decorator->writeState(0.503F); // 128
+
+    TEST_ASSERT_EQUAL_INT(2, output->writes);
+    TEST_ASSERT_EQUAL_FLOAT(0.503F, output->value);
+    TEST_ASSERT_EQUAL_UINT32(2, counters.issued);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.suppressed);
+}
+
+void test_change_only_shared_counters(void)
+{
+    auto* output = new TestOutput();
+    auto* output2 = new TestOutput();
+    OutputWriteCounters counters;
+    auto* decorator = new ChangeOnlyOutputDecorator(output, 4095, &counters);
+    auto* decorator2 = new ChangeOnlyOutputDecorator(output2, 4095, &counters);
+
+    decorator->writeState(0.25F);
+    decorator2->writeState(0.25F);
+    decorator->writeState(0.25F);
+    decorator2->writeState(0.25F);
+
+    TEST_ASSERT_EQUAL_INT(1, output->writes);
+    TEST_ASSERT_EQUAL_INT(1, output2->writes);
+    TEST_ASSERT_EQUAL_UINT32(2, counters.issued);
+    TEST_ASSERT_EQUAL_UINT32(2, counters.suppressed);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_change_only_init);
+    RUN_TEST(test_change_only_first_write);
+    RUN_TEST(test_change_only_skips_unchanged);
+    RUN_TEST(test_change_only_compares_quantised);
+    RUN_TEST(test_change_only_shared_counters);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
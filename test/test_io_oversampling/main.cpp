@@ -0,0 +1,225 @@
+#include <senseshift/input/filter.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor/oversampling.hpp>
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace SenseShift::Input;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+class TestSequenceSensor : public ISimpleSensor<float> {
+  public:
+    std::vector<float> values;
+    std::size_t reads = 0;
+    int setupCounter = 0;
+
+    void init() override
+    {
+        this->setupCounter++;
+    }
+
+    auto getValue() -> float override
+    {
+        return this->values[this->reads++ % this->values.size()];
+    }
+};
+
+/// ADC-like source: the current level, with gaussian noise and rare spikes on every read.
+class TestNoisySensor : public ISimpleSensor<float> {
+  public:
+    float level = 0.0F;
+
+    TestNoisySensor(const float noise, const float spike_chance) :
+      noise_(0.0F, noise), spike_chance_(spike_chance)
+    {
+    }
+
+    void init() override
+    {
+    }
+
+    auto getValue() -> float override
+    {
+        if (this->uniform_(this->random_) < this->spike_chance_) {
+            return this->uniform_(this->random_) < 0.5F ? 0.0F : 1.0F;
+        }
+        return this->level + this->noise_(this->random_);
+    }
+
+  private:
+    std::mt19937 random_{ 42 };
+    std::normal_distribution<float> noise_;
+    std::uniform_real_distribution<float> uniform_{ 0.0F, 1.0F };
+    float spike_chance_;
+};
+
+void test_oversampling_mean(void)
+{
+    auto* source = new TestSequenceSensor();
+    source->values = { 0.1F, 0.2F, 0.3F, 0.4F };
+
+    OversamplingSensor sensor(source, 4);
+    sensor.init();
+    TEST_ASSERT_EQUAL_INT(1, source->setupCounter);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, sensor.getValue());
+    TEST_ASSERT_EQUAL_size_t(4, source->reads);
+}
+
+void test_oversampling_trims_outliers(void)
+{
+    auto* source = new TestSequenceSensor();
+    source->values = { 0.5F, 1.0F, 0.4F, 0.0F, 0.6F, 0.5F };
+
+    OversamplingSensor sensor(source, 6, 1);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, sensor.getValue());
+}
+
+void test_oversampling_config_limits(void)
+{
+    auto* source = new TestSequenceSensor();
+    source->values = { 0.3F };
+
+    OversamplingSensor zero(source, 0, 5);
+    TEST_ASSERT_EQUAL_size_t(1, zero.getSamples());
+    TEST_ASSERT_EQUAL_size_t(0, zero.getTrim());
+    TEST_ASSERT_EQUAL_FLOAT(0.3F, zero.getValue());
+
+    OversamplingSensor many(source, 200, 200);
+    TEST_ASSERT_EQUAL_size_t(OversamplingSensor::MAX_SAMPLES, many.getSamples());
+    // At least one sample is always left
+    TEST_ASSERT_EQUAL_size_t((OversamplingSensor::MAX_SAMPLES - 1) / 2, many.getTrim());
+    TEST_ASSERT_EQUAL_FLOAT(0.3F, many.getValue());
+}
+
+struct StepResponse {
+    /// Ticks after the step, until the output first gets within 10% of the step from the new level.
+    std::size_t settle_ticks;
+    /// Standard deviation of the output, before the step.
+    float noise;
+};
+
+/// Feed a step from 0.2 to 0.8 through the sensor, one tick per level change.
+template<typename Sensor>
+auto measure_step(Sensor& sensor, TestNoisySensor& source) -> StepResponse
+{
+    constexpr std::size_t ticks = 2000;
+    constexpr std::size_t step_tick = 1000;
+    constexpr float low = 0.2F;
+    constexpr float high = 0.8F;
+
+    std::vector<float> output;
+    for (std::size_t tick = 0; tick < ticks; tick++) {
+        source.level = tick < step_tick ? low : high;
+        sensor.tick();
+        output.push_back(sensor.getValue());
+    }
+
+    // Skip the start-up transient
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    const std::size_t from = 100;
+    for (std::size_t tick = from; tick < step_tick; tick++) {
+        sum += output[tick];
+        sum_squares += static_cast<double>(output[tick]) * output[tick];
+    }
+    const auto count = static_cast<double>(step_tick - from);
+    const auto mean = sum / count;
+    const auto noise = static_cast<float>(std::sqrt(sum_squares / count - mean * mean));
+
+    const float tolerance = (high - low) * 0.1F;
+    std::size_t settled = step_tick;
+    while (settled < ticks && std::fabs(output[settled] - high) > tolerance) {
+        settled++;
+    }
+
+    return { settled - step_tick, noise };
+}
+
+void test_oversampling_vs_moving_average(void)
+{
+    constexpr float adc_noise = 0.02F;
+    constexpr float spike_chance = 0.01F;
+
+    // The current finger chain: one read per tick, smoothed across the ticks
+    auto* ema_source = new TestNoisySensor(adc_noise, spike_chance);
+    StaticFilteredSensorDecorator ema_sensor(
+      ema_source,
+      Filter::StaticFilterChain(Filter::ExponentialMovingAverageFilter<float>(0.8F))
+    );
+    const auto ema = measure_step(ema_sensor, *ema_source);
+
+    // Oversampled burst, no smoothing across the ticks
+    auto* burst_source = new TestNoisySensor(adc_noise, spike_chance);
+    StaticFilteredSensorDecorator burst_sensor(
+      new OversamplingSensor(burst_source, 8, 2),
+      Filter::StaticFilterChain(Filter::ExponentialMovingAverageFilter<float>(1.0F))
+    );
+    const auto burst = measure_step(burst_sensor, *burst_source);
+
+    char message[128];
+    snprintf(
+      message,
+      sizeof(message),
+      "ema(0.8): noise %.4f, settles in %u ticks; oversampling(8, trim 2): noise %.4f, settles in %u ticks",
+      ema.noise,
+      static_cast<unsigned>(ema.settle_ticks),
+      burst.noise,
+      static_cast<unsigned>(burst.settle_ticks)
+    );
+    TEST_MESSAGE(message);
+
+    // Settles on the very first tick after the step, the moving average takes longer
+    TEST_ASSERT_EQUAL_size_t(0, burst.settle_ticks);
+    TEST_ASSERT_LESS_THAN_size_t(ema.settle_ticks, burst.settle_ticks);
+    // At a lower noise floor, with the spikes rejected
+    TEST_ASSERT_LESS_THAN_FLOAT(ema.noise, burst.noise);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_oversampling_mean);
+    RUN_TEST(test_oversampling_trims_outliers);
+    RUN_TEST(test_oversampling_config_limits);
+    RUN_TEST(test_oversampling_vs_moving_average);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
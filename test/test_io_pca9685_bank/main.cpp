@@ -0,0 +1,279 @@
+#include <senseshift/output/pca9685_bank.hpp>
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace SenseShift::Output;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Mimics the TwoWire API, backed by the register file of a single PCA9685.
+class TestI2CBus {
+  public:
+    std::uint8_t address = 0x40;
+    std::array<std::uint8_t, 256> registers{};
+    /// Number of the completed write transactions.
+    int transactions = 0;
+    /// Bytes written in the last transaction, including the register address.
+    std::size_t lastLength = 0;
+    std::uint8_t error = 0;
+
+    void beginTransmission(std::uint8_t device)
+    {
+        this->device_ = device;
+        this->buffer_.clear();
+    }
+
+    auto write(std::uint8_t data) -> std::size_t
+    {
+        this->buffer_.push_back(data);
+        return 1;
+    }
+
+    auto write(const std::uint8_t* data, std::size_t length) -> std::size_t
+    {
+        this->buffer_.insert(this->buffer_.end(), data, data + length);
+        return length;
+    }
+
+    auto endTransmission(bool sendStop = true) -> std::uint8_t
+    {
+        (void) sendStop;
+        if (this->error != 0) {
+            return this->error;
+        }
+        if (this->device_ != this->address || this->buffer_.empty()) {
+            return 2;
+        }
+
+        this->pointer_ = this->buffer_[0];
+        if (this->buffer_.size() == 1) {
+            // Register address only, the read follows
+            return 0;
+        }
+
+        const bool autoIncrement = (this->registers[0x00] & 0x20) != 0;
+        if (!autoIncrement && this->buffer_.size() > 2) {
+            return 4;
+        }
+        for (std::size_t i = 1; i < this->buffer_.size(); i++) {
+            this->registers[this->pointer_++] = this->buffer_[i];
+        }
+
+        this->transactions++;
+        this->lastLength = this->buffer_.size();
+        return 0;
+    }
+
+    auto requestFrom(std::uint8_t device, std::uint8_t quantity) -> std::uint8_t
+    {
+        return device == this->address ? quantity : 0;
+    }
+
+    auto read() -> int
+    {
+        return this->registers[this->pointer_++];
+    }
+
+    /// OFF time of the channel, as the PCA9685 would output it.
+    [[nodiscard]] auto getDuty(std::uint8_t channel) const -> std::uint16_t
+    {
+        const auto base = 0x06 + channel * 4;
+        if ((this->registers[base + 3] & 0x10) != 0) {
+            return 0;
+        }
+        if ((this->registers[base + 1] & 0x10) != 0) {
+            return 4095;
+        }
+        return this->registers[base + 2] | ((this->registers[base + 3] & 0x0F) << 8);
+    }
+
+  private:
+    std::uint8_t device_ = 0;
+    std::uint8_t pointer_ = 0;
+    std::vector<std::uint8_t> buffer_{};
+};
+
+void test_bank_init_enables_auto_increment(void)
+{
+    TestI2CBus bus;
+    bus.registers[0x00] = 0x01; // ALLCALL
+
+    PCA9685Bank<TestI2CBus> bank(bus, 0x40);
+    bank.init();
+
+    TEST_ASSERT_EQUAL_HEX8(0x21, bus.registers[0x00]);
+}
+
+void test_bank_encode_duty(void)
+{
+    const std::array<std::uint8_t, 4> off = { 0x00, 0x00, 0x00, 0x10 };
+    const std::array<std::uint8_t, 4> on = { 0x00, 0x10, 0x00, 0x00 };
+    const std::array<std::uint8_t, 4> half = { 0x00, 0x00, 0xFF, 0x07 };
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(off.data(), PCA9685Bank<TestI2CBus>::encodeDuty(0).data(), 4);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(on.data(), PCA9685Bank<TestI2CBus>::encodeDuty(4095).data(), 4);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(half.data(), PCA9685Bank<TestI2CBus>::encodeDuty(2047).data(), 4);
+}
+
+void test_bank_flushes_in_single_transaction(void)
+{
+    TestI2CBus bus;
+    PCA9685Bank<TestI2CBus> bank(bus, 0x40);
+    bank.init();
+    bus.transactions = 0;
+
+    std::array<IFloatOutput*, 16> outputs{};
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        outputs[channel] = bank.getOutput(channel);
+    }
+
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        outputs[channel]->writeState(static_cast<float>(channel) / 15.0F);
+    }
+    // Nothing is written before the flush
+    TEST_ASSERT_EQUAL_INT(0, bus.transactions);
+    TEST_ASSERT_TRUE(bank.isDirty());
+
+    TEST_ASSERT_TRUE(bank.flush());
+    TEST_ASSERT_EQUAL_INT(1, bus.transactions);
+    TEST_ASSERT_EQUAL_size_t(1 + 16 * 4, bus.lastLength);
+    TEST_ASSERT_FALSE(bank.isDirty());
+
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        TEST_ASSERT_EQUAL_UINT16(bank.getChannel(channel), bus.getDuty(channel));
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, bus.getDuty(0));
+    TEST_ASSERT_EQUAL_UINT16(4095, bus.getDuty(15));
+}
+
+void test_bank_writes_changed_range_only(void)
+{
+    TestI2CBus bus;
+    PCA9685Bank<TestI2CBus> bank(bus, 0x40);
+    bank.init();
+
+    for (std::uint8_t channel = 0; channel < 16; channel++) {
+        bank.setChannel(channel, 100);
+    }
+    bank.flush();
+    bus.transactions = 0;
+
+    // Unchanged values do not make the bank dirty
+    bank.setChannel(3, 100);
+    TEST_ASSERT_FALSE(bank.isDirty());
+    TEST_ASSERT_TRUE(bank.flush());
+    TEST_ASSERT_EQUAL_INT(0, bus.transactions);
+
+    bank.setChannel(5, 200);
+    bank.setChannel(7, 300);
+    TEST_ASSERT_TRUE(bank.flush());
+    TEST_ASSERT_EQUAL_INT(1, bus.transactions);
+    TEST_ASSERT_EQUAL_size_t(1 + 3 * 4, bus.lastLength);
+
+    TEST_ASSERT_EQUAL_UINT16(100, bus.getDuty(4));
+    TEST_ASSERT_EQUAL_UINT16(200, bus.getDuty(5));
+    TEST_ASSERT_EQUAL_UINT16(100, bus.getDuty(6));
+    TEST_ASSERT_EQUAL_UINT16(300, bus.getDuty(7));
+}
+
+void test_bank_first_write_goes_through(void)
+{
+    TestI2CBus bus;
+    // Register state left from the previous run
+    bus.registers[0x06 + 2 * 4 + 2] = 0xFF;
+
+    PCA9685Bank<TestI2CBus> bank(bus, 0x40);
+    bank.init();
+
+    bank.setChannel(2, 0);
+    TEST_ASSERT_TRUE(bank.isDirty());
+    bank.flush();
+
+    TEST_ASSERT_EQUAL_UINT16(0, bus.getDuty(2));
+}
+
+void test_bank_output_clamps_value(void)
+{
+    TestI2CBus bus;
+    PCA9685Bank<TestI2CBus> bank(bus, 0x40);
+    auto* output = bank.getOutput(0);
+
+    output->writeState(-0.5F);
+    TEST_ASSERT_EQUAL_UINT16(0, bank.getChannel(0));
+
+    output->writeState(1.5F);
+    TEST_ASSERT_EQUAL_UINT16(4095, bank.getChannel(0));
+
+    output->writeState(std::numeric_limits<float>::quiet_NaN());
+    TEST_ASSERT_EQUAL_UINT16(0, bank.getChannel(0));
+
+    output->writeState(0.5F);
+    TEST_ASSERT_EQUAL_UINT16(2047, bank.getChannel(0));
+}
+
+void test_bank_retries_failed_flush(void)
+{
+    TestI2CBus bus;
+    PCA9685Bank<TestI2CBus> bank(bus, 0x40);
+    bank.init();
+    bus.transactions = 0;
+
+    bank.setChannel(1, 1000);
+    bus.error = 2;
+    TEST_ASSERT_FALSE(bank.flush());
+    TEST_ASSERT_TRUE(bank.isDirty());
+
+    bus.error = 0;
+    TEST_ASSERT_TRUE(bank.flush());
+    TEST_ASSERT_EQUAL_INT(1, bus.transactions);
+    TEST_ASSERT_EQUAL_UINT16(1000, bus.getDuty(1));
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bank_init_enables_auto_increment);
+    RUN_TEST(test_bank_encode_duty);
+    RUN_TEST(test_bank_flushes_in_single_transaction);
+    RUN_TEST(test_bank_writes_changed_range_only);
+    RUN_TEST(test_bank_first_write_goes_through);
+    RUN_TEST(test_bank_output_clamps_value);
+    RUN_TEST(test_bank_retries_failed_flush);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -1,7 +1,10 @@
+#include <benchmark.hpp>
 #include <senseshift/input/sensor.hpp>
 #include <senseshift/input/sensor/analog_threshold.hpp>
 #include <unity.h>
 
+#include <cstdio>
+
 using namespace SenseShift::Input;
 
 void setUp(void)
@@ -235,6 +238,117 @@ void test_sensor_analog_threshold(void)
     TEST_ASSERT_FALSE(sensor->getValue());
 }
 
+void test_static_filtered_sensor(void)
+{
+    auto inner = new TestAnalogSensor();
+    auto sensor = new StaticFilteredSensorDecorator(
+      inner,
+      ::SenseShift::Input::Filter::StaticFilterChain(
+        ::SenseShift::Input::Filter::MultiplyFilter(2),
+        ::SenseShift::Input::Filter::AddFilter(1)
+      )
+    );
+
+    TEST_ASSERT_EQUAL_INT(0, inner->setupCounter);
+    sensor->init();
+    TEST_ASSERT_EQUAL_INT(1, inner->setupCounter);
+
+    inner->value = 1;
+    sensor->tick();
+    TEST_ASSERT_EQUAL_INT(1, sensor->getRawValue());
+    TEST_ASSERT_EQUAL_INT(3, sensor->getValue());
+
+    // Runtime filters are applied after the compile-time chain
+    sensor->addFilter(new ::SenseShift::Input::Filter::MultiplyFilter(10));
+
+    inner->value = 16;
+    sensor->tick();
+    TEST_ASSERT_EQUAL_INT(330, sensor->getValue());
+}
+
+void test_static_filtered_sensor_calibrated(void)
+{
+    auto inner = new TestFloatSensor();
+    auto calibrator = new DummyCalibrator();
+
+    auto sensor = new StaticFilteredSensorDecorator(
+      inner,
+      ::SenseShift::Input::Filter::StaticFilterChain(::SenseShift::Input::Filter::AnalogInvertFilter())
+    );
+    sensor->setCalibrator(calibrator);
+
+    // Calibration is applied before the compile-time chain
+    sensor->startCalibration();
+    inner->value = 0.25f;
+    sensor->tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, sensor->getValue());
+
+    sensor->stopCalibration();
+    inner->value = 0.5f;
+    sensor->tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, sensor->getValue());
+}
+
+void test_static_filtered_sensor_published_through_base(void)
+{
+    auto inner = new TestAnalogSensor();
+    auto sensor = new StaticFilteredSensorDecorator(
+      inner,
+      ::SenseShift::Input::Filter::StaticFilterChain(
+        ::SenseShift::Input::Filter::MultiplyFilter(2),
+        ::SenseShift::Input::Filter::AddFilter(1)
+      )
+    );
+
+    // As the MultiplexerScanner does
+    Sensor<int>* base = sensor;
+    base->publishState(5);
+
+    TEST_ASSERT_EQUAL_INT(5, sensor->getRawValue());
+    TEST_ASSERT_EQUAL_INT(11, sensor->getValue());
+}
+
+void test_benchmark_static_filter_chain(void)
+{
+    constexpr std::size_t iterations = 100000;
+
+    auto runtime_inner = new TestFloatSensor();
+    auto runtime_sensor = new SimpleSensorDecorator(runtime_inner);
+    runtime_sensor->addFilters({
+      new ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<float>(0.8F),
+      new ::SenseShift::Input::Filter::CenterDeadzoneFilter(0.03F),
+      new ::SenseShift::Input::Filter::AnalogInvertFilter(),
+      new ::SenseShift::Input::Filter::ClampFilter<float>(0.0F, 1.0F),
+    });
+
+    auto static_inner = new TestFloatSensor();
+    auto static_sensor = new StaticFilteredSensorDecorator(
+      static_inner,
+      ::SenseShift::Input::Filter::StaticFilterChain(
+        ::SenseShift::Input::Filter::ExponentialMovingAverageFilter<float>(0.8F),
+        ::SenseShift::Input::Filter::CenterDeadzoneFilter(0.03F),
+        ::SenseShift::Input::Filter::AnalogInvertFilter(),
+        ::SenseShift::Input::Filter::ClampFilter<float>(0.0F, 1.0F)
+      )
+    );
+
+    const auto runtime_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        runtime_inner->value = static_cast<float>(i % 4096) / 4095.0F;
+        runtime_sensor->tick();
+    });
+    const auto static_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        static_inner->value = static_cast<float>(i % 4096) / 4095.0F;
+        static_sensor->tick();
+    });
+
+    // Both pipelines must produce the same output
+    TEST_ASSERT_EQUAL_FLOAT(runtime_sensor->getValue(), static_sensor->getValue());
+
+    char message[96];
+    snprintf(message, sizeof(message), "filter chain: runtime %.1f ns/sample, static %.1f ns/sample", runtime_ns, static_ns);
+    TEST_MESSAGE(message);
+}
+
 int process(void)
 {
     UNITY_BEGIN();
@@ -245,6 +359,11 @@ int process(void)
     RUN_TEST(test_sensor_filter_center_deadzone);
     RUN_TEST(test_sensor_multiple_filters);
     RUN_TEST(test_sensor_analog_threshold);
+    RUN_TEST(test_static_filtered_sensor);
+    RUN_TEST(test_static_filtered_sensor_calibrated);
+    RUN_TEST(test_static_filtered_sensor_published_through_base);
+
+    RUN_TEST(test_benchmark_static_filter_chain);
 
     return UNITY_END();
 }
@@ -0,0 +1,247 @@
+#include <senseshift/body/hands/input/gesture.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor_graph.hpp>
+#include <unity.h>
+
+#include <string>
+#include <vector>
+
+using namespace SenseShift::Input;
+using namespace SenseShift::Body::Hands::Input;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Records the ticks into the shared log, and publishes the pending value (if any).
+class TestSourceSensor : public FloatSensor {
+  public:
+    TestSourceSensor(std::string name, std::vector<std::string>& log) : name_(std::move(name)), log_(log)
+    {
+    }
+
+    float next = 0.0F;
+    int inits = 0;
+
+    void init() override
+    {
+        this->inits++;
+    }
+
+    void tick() override
+    {
+        this->log_.push_back(this->name_);
+        this->publishState(this->next);
+    }
+
+  private:
+    std::string name_;
+    std::vector<std::string>& log_;
+};
+
+/// Sum of the dependencies, recording the ticks into the shared log.
+class TestSumSensor : public FloatSensor {
+  public:
+    TestSumSensor(std::string name, std::vector<std::string>& log, std::vector<FloatSensor*> sources) :
+      name_(std::move(name)), log_(log), sources_(std::move(sources))
+    {
+    }
+
+    int ticks = 0;
+
+    auto getDependencies() -> std::vector<ISensorNode*> override
+    {
+        return { this->sources_.begin(), this->sources_.end() };
+    }
+
+    void tick() override
+    {
+        this->ticks++;
+        this->log_.push_back(this->name_);
+
+        float sum = 0.0F;
+        for (auto* source : this->sources_) {
+            sum += source->getValue();
+        }
+        this->publishState(sum);
+    }
+
+    void setSources(std::vector<FloatSensor*> sources)
+    {
+        this->sources_ = std::move(sources);
+    }
+
+  private:
+    std::string name_;
+    std::vector<std::string>& log_;
+    std::vector<FloatSensor*> sources_;
+};
+
+void test_sensor_graph_order(void)
+{
+    std::vector<std::string> log;
+
+    TestSourceSensor a("a", log);
+    TestSourceSensor b("b", log);
+    TestSumSensor sum("sum", log, { &a, &b });
+    TestSumSensor total("total", log, { &sum, &a });
+
+    // Only the top one is added, the rest is learned from the dependencies
+    SensorGraph graph;
+    graph.add(&total);
+    graph.init();
+
+    TEST_ASSERT_EQUAL(4, graph.size());
+    TEST_ASSERT_EQUAL(1, a.inits);
+    TEST_ASSERT_EQUAL(1, b.inits);
+
+    a.next = 1.0F;
+    b.next = 2.0F;
+    graph.tick();
+
+    const std::vector<std::string> expected{ "a", "b", "sum", "total" };
+    TEST_ASSERT_EQUAL(expected.size(), log.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        TEST_ASSERT_EQUAL_STRING(expected[i].c_str(), log[i].c_str());
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, sum.getValue());
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, total.getValue());
+}
+
+void test_sensor_graph_skips_unchanged(void)
+{
+    std::vector<std::string> log;
+
+    TestSourceSensor a("a", log);
+    TestSourceSensor b("b", log);
+    TestSumSensor sum("sum", log, { &a, &b });
+    TestSumSensor only_b("only_b", log, { &b });
+
+    SensorGraph graph;
+    graph.add(&a);
+    graph.add(&b);
+    graph.add(&sum);
+    graph.add(&only_b);
+    graph.add(&sum); // Added twice, still ticked once
+    graph.init();
+
+    TEST_ASSERT_EQUAL(4, graph.size());
+
+    // Evaluated on the first tick, even without the changes
+    graph.tick();
+    TEST_ASSERT_EQUAL(1, sum.ticks);
+    TEST_ASSERT_EQUAL(1, only_b.ticks);
+
+    graph.tick();
+    TEST_ASSERT_EQUAL(1, sum.ticks);
+    TEST_ASSERT_EQUAL(1, only_b.ticks);
+
+    a.next = 0.5F;
+    graph.tick();
+    TEST_ASSERT_EQUAL(2, sum.ticks);
+    TEST_ASSERT_EQUAL(1, only_b.ticks);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, sum.getValue());
+
+    b.next = 0.25F;
+    graph.tick();
+    TEST_ASSERT_EQUAL(3, sum.ticks);
+    TEST_ASSERT_EQUAL(2, only_b.ticks);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, sum.getValue());
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, only_b.getValue());
+}
+
+void test_sensor_graph_cycle(void)
+{
+    std::vector<std::string> log;
+
+    TestSourceSensor a("a", log);
+    TestSumSensor first("first", log, { &a });
+    TestSumSensor second("second", log, { &first });
+    first.setSources({ &a, &second });
+
+    SensorGraph graph;
+    graph.add(&first);
+    graph.init();
+
+    TEST_ASSERT_EQUAL(3, graph.size());
+
+    // The cycle is broken, and every sensor is ticked once
+    a.next = 1.0F;
+    graph.tick();
+
+    TEST_ASSERT_EQUAL(3, log.size());
+    TEST_ASSERT_EQUAL(1, first.ticks);
+    TEST_ASSERT_EQUAL(1, second.ticks);
+}
+
+void test_sensor_graph_gestures(void)
+{
+    std::vector<std::string> log;
+
+    TestSourceSensor thumb("thumb", log);
+    TestSourceSensor index("index", log);
+
+    auto* trigger = new TriggerGesture(&index, 0.5F);
+    auto* pinch = new PinchGesture({ .thumb = &thumb, .index = &index }, 0.5F);
+
+    SensorGraph graph;
+    graph.add(trigger);
+    graph.add(pinch);
+    graph.init();
+
+    TEST_ASSERT_EQUAL(4, graph.size());
+
+    index.next = 0.6F;
+    graph.tick();
+    TEST_ASSERT_TRUE(trigger->getValue());
+    TEST_ASSERT_FALSE(pinch->getValue());
+
+    thumb.next = 0.6F;
+    graph.tick();
+    TEST_ASSERT_TRUE(trigger->getValue());
+    TEST_ASSERT_TRUE(pinch->getValue());
+
+    // Each finger once per tick, before the gestures
+    TEST_ASSERT_EQUAL(4, log.size());
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sensor_graph_order);
+    RUN_TEST(test_sensor_graph_skips_unchanged);
+    RUN_TEST(test_sensor_graph_cycle);
+    RUN_TEST(test_sensor_graph_gestures);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
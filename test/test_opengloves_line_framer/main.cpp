@@ -0,0 +1,263 @@
+#include <senseshift/opengloves/line_framer.hpp>
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SenseShift::OpenGloves;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Mimics the Stream API: only the delivered bytes are available, the rest "is still in flight".
+class TestStream {
+  public:
+    explicit TestStream(std::string data) : data_(std::move(data))
+    {
+    }
+
+    /// Make the next \p count bytes available.
+    void deliver(std::size_t count)
+    {
+        this->delivered_ = std::min(this->delivered_ + count, this->data_.size());
+    }
+
+    [[nodiscard]] auto isDrained() const -> bool
+    {
+        return this->position_ == this->data_.size();
+    }
+
+    auto available() -> int
+    {
+        return static_cast<int>(this->delivered_ - this->position_);
+    }
+
+    auto read() -> int
+    {
+        if (this->position_ >= this->delivered_) {
+            return -1;
+        }
+        return static_cast<unsigned char>(this->data_[this->position_++]);
+    }
+
+  private:
+    std::string data_;
+    std::size_t delivered_ = 0;
+    std::size_t position_ = 0;
+};
+
+void test_framer_single_line(void)
+{
+    LineFramer<32> framer;
+    char buffer[32];
+
+    TEST_ASSERT_FALSE(framer.hasFrame());
+    TEST_ASSERT_EQUAL_size_t(0, framer.read(buffer, sizeof(buffer)));
+
+    framer.push("A512B", 5);
+    TEST_ASSERT_FALSE(framer.hasFrame());
+
+    framer.push("\n", 1);
+    TEST_ASSERT_TRUE(framer.hasFrame());
+    TEST_ASSERT_EQUAL_size_t(5, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A512B", buffer);
+
+    TEST_ASSERT_FALSE(framer.hasFrame());
+    TEST_ASSERT_EQUAL_size_t(0, framer.read(buffer, sizeof(buffer)));
+}
+
+void test_framer_keeps_newest(void)
+{
+    LineFramer<32> framer;
+    char buffer[32];
+
+    const std::string data = "A1\nA2\nA3\nA4";
+    framer.push(data.data(), data.size());
+
+    TEST_ASSERT_EQUAL_size_t(2, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A3", buffer);
+    TEST_ASSERT_EQUAL_UINT32(2, framer.getDroppedCount());
+
+    // The incomplete line is kept
+    framer.push("\n", 1);
+    TEST_ASSERT_EQUAL_size_t(2, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A4", buffer);
+}
+
+void test_framer_skips_empty_lines(void)
+{
+    LineFramer<32> framer;
+    char buffer[32];
+
+    framer.push("\n\nA1\n\n", 6);
+
+    TEST_ASSERT_EQUAL_size_t(2, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A1", buffer);
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getDroppedCount());
+}
+
+void test_framer_discards_long_lines(void)
+{
+    LineFramer<8> framer;
+    char buffer[8];
+
+    // Exactly fits: 7 characters and the terminator
+    framer.push("ABCDEFG\n", 8);
+    TEST_ASSERT_EQUAL_size_t(7, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("ABCDEFG", buffer);
+
+    framer.push("ABCDEFGHIJKLMNOP\nA1\n", 20);
+    TEST_ASSERT_EQUAL_UINT32(1, framer.getOverflowCount());
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getDroppedCount());
+    TEST_ASSERT_EQUAL_size_t(2, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A1", buffer);
+}
+
+void test_framer_truncates_to_destination(void)
+{
+    LineFramer<32> framer;
+    char buffer[4];
+
+    framer.push("ABCDEFG\n", 8);
+
+    TEST_ASSERT_EQUAL_size_t(3, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("ABC", buffer);
+}
+
+void test_framer_feed_does_not_wait(void)
+{
+    LineFramer<32> framer;
+    char buffer[32];
+    TestStream stream("A100B200\nA300");
+
+    stream.deliver(4);
+    TEST_ASSERT_EQUAL_size_t(4, framer.feed(stream));
+    TEST_ASSERT_FALSE(framer.hasFrame());
+
+    // Nothing new arrived
+    TEST_ASSERT_EQUAL_size_t(0, framer.feed(stream));
+
+    stream.deliver(7);
+    framer.feed(stream);
+    TEST_ASSERT_EQUAL_size_t(8, framer.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A100B200", buffer);
+    TEST_ASSERT_FALSE(framer.hasFrame());
+}
+
+void test_framer_random_splits(void)
+{
+    std::mt19937 random(42); // NOLINT(cert-msc51-cpp): reproducible splits
+
+    std::vector<std::string> commands;
+    std::string data;
+    for (int i = 0; i < 500; i++) {
+        commands.push_back("A" + std::to_string(i) + "B" + std::to_string(i * 7 % 1000) + "C0D0E0");
+        data += commands.back() + "\n";
+    }
+
+    TestStream stream(data);
+    LineFramer<64> framer;
+    char buffer[64];
+
+    std::size_t last = 0;
+    std::uint32_t received = 0;
+    std::uniform_int_distribution<std::size_t> chunk(0, 40);
+    std::bernoulli_distribution consume(0.5);
+
+    while (!stream.isDrained()) {
+        stream.deliver(chunk(random));
+        framer.feed(stream);
+
+        // Sometimes the consumer is too slow, and misses the commands
+        if (!consume(random)) {
+            continue;
+        }
+
+        const auto length = framer.read(buffer, sizeof(buffer));
+        if (length == 0) {
+            continue;
+        }
+
+        // Every frame is one of the complete commands, and the commands only go forward
+        bool found = false;
+        for (std::size_t i = last; i < commands.size(); i++) {
+            if (commands[i] == buffer) {
+                TEST_ASSERT_EQUAL_size_t(commands[i].size(), length);
+                last = i + 1;
+                found = true;
+                break;
+            }
+        }
+        TEST_ASSERT_TRUE_MESSAGE(found, buffer);
+        received++;
+    }
+
+    // The last command is never lost
+    if (framer.hasFrame()) {
+        framer.read(buffer, sizeof(buffer));
+        received++;
+    }
+    TEST_ASSERT_EQUAL_STRING(commands.back().c_str(), buffer);
+    TEST_ASSERT_EQUAL_UINT32(commands.size(), received + framer.getDroppedCount());
+    TEST_ASSERT_EQUAL_UINT32(0, framer.getOverflowCount());
+}
+
+void test_is_command(void)
+{
+    TEST_ASSERT_TRUE(isCommand("SS_PROFILE", 10, "SS_PROFILE"));
+    // CRLF line endings
+    TEST_ASSERT_TRUE(isCommand("SS_PROFILE\r", 11, "SS_PROFILE"));
+
+    TEST_ASSERT_FALSE(isCommand("SS_PROFILE\r\r", 12, "SS_PROFILE"));
+    TEST_ASSERT_FALSE(isCommand("SS_PROFILER", 11, "SS_PROFILE"));
+    TEST_ASSERT_FALSE(isCommand("SS_PROF", 7, "SS_PROFILE"));
+    TEST_ASSERT_FALSE(isCommand("\r", 1, "SS_PROFILE"));
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_framer_single_line);
+    RUN_TEST(test_framer_keeps_newest);
+    RUN_TEST(test_framer_skips_empty_lines);
+    RUN_TEST(test_framer_discards_long_lines);
+    RUN_TEST(test_framer_truncates_to_destination);
+    RUN_TEST(test_framer_feed_does_not_wait);
+    RUN_TEST(test_framer_random_splits);
+    RUN_TEST(test_is_command);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
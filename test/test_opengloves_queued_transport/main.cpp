@@ -0,0 +1,225 @@
+#include <senseshift/core/mailbox_worker.hpp>
+#include <senseshift/opengloves/queued_transport.hpp>
+#include <unity.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SenseShift;
+using namespace SenseShift::OpenGloves;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Records the sent frames. Can hold the writer inside send(), like a slow radio would.
+class TestTransport : public ITransport {
+  public:
+    int setupCounter = 0;
+    std::vector<std::string> sent{};
+
+    std::atomic<bool> blocking{ false };
+    std::atomic<bool> sending{ false };
+
+    void init() override
+    {
+        this->setupCounter++;
+    }
+
+    auto send(const char* buffer, size_t length) -> size_t override
+    {
+        this->sending = true;
+        while (this->blocking) {
+            std::this_thread::yield();
+        }
+
+        this->sent.emplace_back(buffer, length);
+        this->sending = false;
+        return length;
+    }
+
+    auto hasData() -> bool override
+    {
+        return true;
+    }
+
+    auto read(char* buffer, size_t length) -> size_t override
+    {
+        std::strncpy(buffer, "A0", length);
+        return 2;
+    }
+};
+
+using TestQueuedTransport = QueuedTransport<ThreadMailboxWorker<TransportFrame<32>>>;
+
+void test_queued_transport_sends(void)
+{
+    auto* transport = new TestTransport();
+    auto* queued = new TestQueuedTransport(transport);
+    queued->init();
+
+    TEST_ASSERT_EQUAL_size_t(5, queued->send("A1B2\n", 5));
+    queued->getWorker().stop();
+
+    TEST_ASSERT_EQUAL_INT(1, transport->setupCounter);
+    TEST_ASSERT_EQUAL_size_t(1, transport->sent.size());
+    TEST_ASSERT_EQUAL_STRING("A1B2\n", transport->sent[0].c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, queued->getDroppedCount());
+
+    delete queued;
+}
+
+void test_queued_transport_keeps_newest(void)
+{
+    auto* transport = new TestTransport();
+    auto* queued = new TestQueuedTransport(transport);
+    queued->init();
+
+    // Hold the writer in the middle of the first frame
+    transport->blocking = true;
+    queued->send("A0\n", 3);
+    while (!transport->sending) {
+        std::this_thread::yield();
+    }
+
+    // The sender is not blocked by the busy writer
+    for (int i = 1; i <= 10; i++) {
+        const auto frame = "A" + std::to_string(i) + "\n";
+        TEST_ASSERT_EQUAL_size_t(frame.size(), queued->send(frame.data(), frame.size()));
+    }
+
+    transport->blocking = false;
+    queued->getWorker().stop();
+
+    TEST_ASSERT_EQUAL_size_t(2, transport->sent.size());
+    TEST_ASSERT_EQUAL_STRING("A0\n", transport->sent[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("A10\n", transport->sent[1].c_str());
+    TEST_ASSERT_EQUAL_UINT32(9, queued->getDroppedCount());
+
+    delete queued;
+}
+
+void test_queued_transport_reliable_frame(void)
+{
+    auto* transport = new TestTransport();
+    auto* queued = new TestQueuedTransport(transport);
+    queued->init();
+
+    // Hold the writer in the middle of the first frame
+    transport->blocking = true;
+    queued->send("A0\n", 3);
+    while (!transport->sending) {
+        std::this_thread::yield();
+    }
+
+    TEST_ASSERT_EQUAL_size_t(7, queued->sendReliable("report\n", 7));
+    // Not written yet
+    TEST_ASSERT_EQUAL_size_t(0, queued->sendReliable("other\n", 6));
+
+    // The regular frames do not replace it
+    for (int i = 1; i <= 10; i++) {
+        const auto frame = "A" + std::to_string(i) + "\n";
+        queued->send(frame.data(), frame.size());
+    }
+
+    transport->blocking = false;
+    queued->getWorker().stop();
+
+    TEST_ASSERT_EQUAL_size_t(3, transport->sent.size());
+    TEST_ASSERT_EQUAL_STRING("A0\n", transport->sent[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("report\n", transport->sent[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("A10\n", transport->sent[2].c_str());
+
+    delete queued;
+}
+
+void test_queued_transport_truncates(void)
+{
+    auto* transport = new TestTransport();
+    auto* queued = new TestQueuedTransport(transport);
+    queued->init();
+
+    const std::string frame(40, 'A');
+    TEST_ASSERT_EQUAL_size_t(32, queued->send(frame.data(), frame.size()));
+    queued->getWorker().stop();
+
+    TEST_ASSERT_EQUAL_size_t(1, transport->sent.size());
+    TEST_ASSERT_EQUAL_size_t(32, transport->sent[0].size());
+
+    delete queued;
+}
+
+void test_queued_transport_init_once(void)
+{
+    auto* transport = new TestTransport();
+    auto* queued = new TestQueuedTransport(transport);
+
+    // Both the tracking and the force feedback components initialize the transport
+    queued->init();
+    queued->init();
+    queued->send("A1\n", 3);
+    queued->getWorker().stop();
+
+    TEST_ASSERT_EQUAL_INT(2, transport->setupCounter);
+    TEST_ASSERT_EQUAL_size_t(1, transport->sent.size());
+
+    delete queued;
+}
+
+void test_queued_transport_reads_directly(void)
+{
+    auto* transport = new TestTransport();
+    auto* queued = new TestQueuedTransport(transport);
+    char buffer[8];
+
+    TEST_ASSERT_TRUE(queued->hasData());
+    TEST_ASSERT_EQUAL_size_t(2, queued->read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("A0", buffer);
+
+    delete queued;
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_queued_transport_sends);
+    RUN_TEST(test_queued_transport_keeps_newest);
+    RUN_TEST(test_queued_transport_reliable_frame);
+    RUN_TEST(test_queued_transport_truncates);
+    RUN_TEST(test_queued_transport_init_once);
+    RUN_TEST(test_queued_transport_reads_directly);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,195 @@
+#include <senseshift/opengloves/send_on_change.hpp>
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+
+using namespace SenseShift::OpenGloves;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+/// Same shape as og::InputPeripheralData.
+struct TestData {
+    struct FingerCurl {
+        std::array<float, 4> curl;
+    };
+    struct Button {
+        bool press;
+    };
+    struct AnalogButton {
+        bool press;
+        float value;
+    };
+
+    struct {
+        std::array<FingerCurl, 5> fingers;
+    } curl;
+    struct {
+        std::array<float, 5> fingers;
+    } splay;
+    struct {
+        float x;
+        float y;
+        bool press;
+    } joystick;
+    std::array<Button, 4> buttons;
+    std::array<AnalogButton, 2> analog_buttons;
+};
+
+auto make_config() -> SendOnChangeConfig
+{
+    SendOnChangeConfig config;
+    config.analog_max = 1000;
+    config.curl_threshold = 10;
+    config.splay_threshold = 20;
+    config.joystick_threshold = 50;
+    config.analog_button_threshold = 100;
+    config.keepalive_ms = 100;
+    return config;
+}
+
+void test_change_detects_fields(void)
+{
+    const auto config = make_config();
+    const TestData base{};
+
+    TEST_ASSERT_FALSE(hasSignificantChange(base, base, config));
+
+    auto data = base;
+    data.curl.fingers[2].curl[3] = 0.005F;
+    TEST_ASSERT_FALSE(hasSignificantChange(base, data, config));
+    data.curl.fingers[2].curl[3] = 0.015F;
+    TEST_ASSERT_TRUE(hasSignificantChange(base, data, config));
+
+    data = base;
+    data.splay.fingers[4] = 0.015F;
+    TEST_ASSERT_FALSE(hasSignificantChange(base, data, config));
+    data.splay.fingers[4] = -0.025F;
+    TEST_ASSERT_TRUE(hasSignificantChange(base, data, config));
+
+    data = base;
+    data.joystick.y = 0.04F;
+    TEST_ASSERT_FALSE(hasSignificantChange(base, data, config));
+    data.joystick.press = true;
+    TEST_ASSERT_TRUE(hasSignificantChange(base, data, config));
+
+    data = base;
+    data.buttons[3].press = true;
+    TEST_ASSERT_TRUE(hasSignificantChange(base, data, config));
+
+    data = base;
+    data.analog_buttons[1].value = 0.09F;
+    TEST_ASSERT_FALSE(hasSignificantChange(base, data, config));
+    data.analog_buttons[1].press = true;
+    TEST_ASSERT_TRUE(hasSignificantChange(base, data, config));
+}
+
+void test_change_compares_encoded_values(void)
+{
+    // 12-bit encoding, any change of the encoded value
+    const SendOnChangeConfig config{};
+    TestData previous{};
+    TestData current{};
+
+    // Same encoded value, even if the raw values differ
+    previous.curl.fingers[0].curl[0] = 100.2F / 4095.0F;
+    current.curl.fingers[0].curl[0] = 100.9F / 4095.0F;
+    TEST_ASSERT_FALSE(hasSignificantChange(previous, current, config));
+
+    // The next encoded value, even if the raw values barely differ
+    previous.curl.fingers[0].curl[0] = 100.95F / 4095.0F;
+    current.curl.fingers[0].curl[0] = 101.05F / 4095.0F;
+    TEST_ASSERT_TRUE(hasSignificantChange(previous, current, config));
+}
+
+void test_gate_sends_first_frame(void)
+{
+    SendOnChangeGate<TestData> gate(make_config());
+
+    TEST_ASSERT_TRUE(gate.shouldSend(TestData{}, 0));
+    TEST_ASSERT_FALSE(gate.shouldSend(TestData{}, 1));
+}
+
+void test_gate_skips_idle_frames(void)
+{
+    SendOnChangeGate<TestData> gate(make_config());
+    TestData data{};
+
+    int sent = 0;
+    for (std::uint32_t now = 1000; now < 2000; now += 5) {
+        sent += gate.shouldSend(data, now) ? 1 : 0;
+    }
+
+    // The first frame, and one keepalive every 100ms
+    TEST_ASSERT_EQUAL_INT(10, sent);
+}
+
+void test_gate_compares_against_last_sent(void)
+{
+    SendOnChangeGate<TestData> gate(make_config());
+    TestData data{};
+
+    TEST_ASSERT_TRUE(gate.shouldSend(data, 0));
+
+    // Slow drift is below the threshold on every step, but not in total
+    data.curl.fingers[0].curl[0] = 0.006F;
+    TEST_ASSERT_FALSE(gate.shouldSend(data, 1));
+    data.curl.fingers[0].curl[0] = 0.012F;
+    TEST_ASSERT_TRUE(gate.shouldSend(data, 2));
+    data.curl.fingers[0].curl[0] = 0.018F;
+    TEST_ASSERT_FALSE(gate.shouldSend(data, 3));
+}
+
+void test_gate_keepalive_wraps(void)
+{
+    SendOnChangeGate<TestData> gate(make_config());
+    TestData data{};
+
+    TEST_ASSERT_TRUE(gate.shouldSend(data, 0xFFFFFFF0));
+    TEST_ASSERT_FALSE(gate.shouldSend(data, 0x00000010));
+    TEST_ASSERT_TRUE(gate.shouldSend(data, 0x00000060));
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_change_detects_fields);
+    RUN_TEST(test_change_compares_encoded_values);
+    RUN_TEST(test_gate_sends_first_frame);
+    RUN_TEST(test_gate_skips_idle_frames);
+    RUN_TEST(test_gate_compares_against_last_sent);
+    RUN_TEST(test_gate_keepalive_wraps);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -0,0 +1,529 @@
+#include <benchmark.hpp>
+#include <senseshift/input/calibration.hpp>
+#include <senseshift/input/sensor.hpp>
+#include <senseshift/input/sensor_table.hpp>
+#include <senseshift/opengloves/input_table.hpp>
+#include <unity.h>
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+using namespace SenseShift::Input;
+using namespace SenseShift::OpenGloves;
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+class TestFloatSensor : public ISimpleSensor<float> {
+  public:
+    float value = 0.0F;
+
+    void init() override
+    {
+    }
+
+    auto getValue() -> float override
+    {
+        return this->value;
+    }
+};
+
+/// Same shape as og::InputPeripheral.
+template<typename Float, typename Binary>
+struct TestPeripheral {
+    struct FingerCurl {
+        std::array<Float, 4> curl;
+    };
+    struct Button {
+        Binary press;
+    };
+    struct AnalogButton {
+        Binary press;
+        Float value;
+    };
+
+    struct {
+        std::array<FingerCurl, 5> fingers;
+    } curl;
+    struct {
+        std::array<Float, 5> fingers;
+    } splay;
+    struct {
+        Float x;
+        Float y;
+        Binary press;
+    } joystick;
+    std::array<Button, 4> buttons;
+    std::array<AnalogButton, 2> analog_buttons;
+};
+
+using TestSensors = TestPeripheral<FloatSensor*, BinarySensor*>;
+using TestData = TestPeripheral<float, bool>;
+
+void test_table_unbound_channels(void)
+{
+    SensorTable<4> table;
+
+    TEST_ASSERT_FALSE(table.bind(4, new SimpleSensorDecorator(new TestFloatSensor())));
+    TEST_ASSERT_EQUAL_size_t(0, table.getActiveCount());
+
+    table.tick();
+    for (std::size_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, table.getValue(i));
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, table.getRawValue(i));
+    }
+}
+
+void test_table_tick_copies_values(void)
+{
+    SensorTable<3> table;
+
+    auto* inner = new TestFloatSensor();
+    auto* sensor = new SimpleSensorDecorator(inner);
+    sensor->addFilter(new Filter::MultiplyFilter<float>(2.0F));
+
+    TEST_ASSERT_TRUE(table.bind(1, sensor));
+    TEST_ASSERT_EQUAL_size_t(1, table.getActiveCount());
+    TEST_ASSERT_EQUAL_PTR(sensor, table.getSensor(1));
+
+    inner->value = 0.25F;
+    table.tick();
+
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, table.getRawValue(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, table.getFilteredValue(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, table.getValue(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, sensor->getValue());
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, table.getValue(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, table.getValue(2));
+
+    table.bind(1, nullptr);
+    TEST_ASSERT_EQUAL_size_t(0, table.getActiveCount());
+}
+
+void test_table_collect_does_not_tick(void)
+{
+    SensorTable<2> table;
+
+    auto* inner = new TestFloatSensor();
+    auto* sensor = new SimpleSensorDecorator(inner);
+    table.bind(0, sensor);
+
+    inner->value = 0.25F;
+    table.collect();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, table.getValue(0));
+
+    // Ticked elsewhere
+    sensor->tick();
+    table.collect();
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, table.getRawValue(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, table.getValue(0));
+}
+
+void test_table_calibration_matches_min_max_calibrator(void)
+{
+    SensorTable<1> table;
+
+    auto* table_inner = new TestFloatSensor();
+    table.bind(0, new SimpleSensorDecorator(table_inner), true);
+
+    auto* reference_inner = new TestFloatSensor();
+    auto* reference = new SimpleSensorDecorator(reference_inner);
+    reference->setCalibrator(new Calibration::MinMaxCalibrator<float>());
+
+    const auto step = [&](const float input) {
+        table_inner->value = input;
+        reference_inner->value = input;
+        table.tick();
+        reference->tick();
+        TEST_ASSERT_EQUAL_FLOAT(reference->getValue(), table.getValue(0));
+    };
+
+    // No calibration data yet
+    step(0.3F);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, table.getValue(0));
+
+    table.startCalibration();
+    reference->startCalibration();
+    for (const auto input : { 0.4F, 0.2F, 0.2F, 0.8F, 0.5F }) {
+        step(input);
+    }
+    table.stopCalibration();
+    reference->stopCalibration();
+
+    TEST_ASSERT_EQUAL_FLOAT(0.2F, table.getCalibrationMin(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.8F, table.getCalibrationMax(0));
+
+    // Bounds are frozen, values outside are clamped
+    for (const auto input : { 0.0F, 0.2F, 0.35F, 0.65F, 0.8F, 1.0F }) {
+        step(input);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.2F, table.getCalibrationMin(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.8F, table.getCalibrationMax(0));
+
+    table.resetCalibration();
+    reference->resetCalibration();
+    step(0.7F);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, table.getValue(0));
+}
+
+void test_table_calibrates_only_flagged_channels(void)
+{
+    SensorTable<2> table;
+
+    auto* calibrated = new TestFloatSensor();
+    auto* passthrough = new TestFloatSensor();
+    table.bind(0, new SimpleSensorDecorator(calibrated), true);
+    table.bind(1, new SimpleSensorDecorator(passthrough));
+
+    table.startCalibration();
+    for (const auto input : { 0.1F, 0.9F }) {
+        calibrated->value = input;
+        passthrough->value = input;
+        table.tick();
+    }
+    table.stopCalibration();
+
+    calibrated->value = 0.5F;
+    passthrough->value = 0.3F;
+    table.tick();
+
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, table.getValue(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.3F, table.getValue(1));
+
+    // Rebound without the calibration, the channel is copied as is
+    table.bind(0, new SimpleSensorDecorator(calibrated));
+    calibrated->value = 0.7F;
+    table.tick();
+    TEST_ASSERT_EQUAL_FLOAT(0.7F, table.getValue(0));
+}
+
+void test_analog_channel_order(void)
+{
+    TEST_ASSERT_EQUAL_size_t(5 * 4 + 5 + 2 + 2, analogChannelCount<TestData>());
+    TEST_ASSERT_EQUAL_size_t(analogChannelCount<TestData>(), analogChannelCount<TestSensors>());
+
+    TEST_ASSERT_TRUE(isCurlChannel<TestData>(0));
+    TEST_ASSERT_TRUE(isCurlChannel<TestData>(19));
+    TEST_ASSERT_FALSE(isCurlChannel<TestData>(20));
+
+    TestData data{};
+    forEachAnalogChannel(data, [](const std::size_t channel, float& field) {
+        field = static_cast<float>(channel);
+    });
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, data.curl.fingers[0].curl[0]);
+    TEST_ASSERT_EQUAL_FLOAT(7.0F, data.curl.fingers[1].curl[3]);
+    TEST_ASSERT_EQUAL_FLOAT(19.0F, data.curl.fingers[4].curl[3]);
+    TEST_ASSERT_EQUAL_FLOAT(20.0F, data.splay.fingers[0]);
+    TEST_ASSERT_EQUAL_FLOAT(24.0F, data.splay.fingers[4]);
+    TEST_ASSERT_EQUAL_FLOAT(25.0F, data.joystick.x);
+    TEST_ASSERT_EQUAL_FLOAT(26.0F, data.joystick.y);
+    TEST_ASSERT_EQUAL_FLOAT(27.0F, data.analog_buttons[0].value);
+    TEST_ASSERT_EQUAL_FLOAT(28.0F, data.analog_buttons[1].value);
+}
+
+/// Same as SS_OG_COLLECT_DATA(getValue), for the analog fields: the current layout.
+auto collect_pointers(const TestSensors& sensors) -> TestData
+{
+    TestData data{};
+
+    for (std::size_t i = 0; i < sensors.curl.fingers.size(); i++) {
+        const auto& finger_curl = sensors.curl.fingers[i].curl;
+        for (std::size_t j = 0; j < finger_curl.size(); j++) {
+            auto* joint_sensor = finger_curl[j];
+            if (joint_sensor != nullptr) {
+                data.curl.fingers[i].curl[j] = joint_sensor->getValue();
+            }
+        }
+
+        auto* finger_splay = sensors.splay.fingers[i];
+        if (finger_splay != nullptr) {
+            data.splay.fingers[i] = finger_splay->getValue();
+        }
+    }
+
+    if (sensors.joystick.x != nullptr) {
+        data.joystick.x = sensors.joystick.x->getValue();
+    }
+    if (sensors.joystick.y != nullptr) {
+        data.joystick.y = sensors.joystick.y->getValue();
+    }
+
+    for (std::size_t i = 0; i < sensors.analog_buttons.size(); i++) {
+        auto* value = sensors.analog_buttons[i].value;
+        if (value != nullptr) {
+            data.analog_buttons[i].value = value->getValue();
+        }
+    }
+
+    return data;
+}
+
+/// Glove with a curl and a splay sensor on every finger, a joystick and a trigger.
+struct TestGlove {
+    TestSensors sensors{};
+    std::vector<TestFloatSensor*> inputs{};
+
+    explicit TestGlove(const bool curl_calibrator)
+    {
+        const auto make = [this](Calibration::ICalibrator<float>* calibrator) -> FloatSensor* {
+            auto* input = new TestFloatSensor();
+            auto* sensor = new SimpleSensorDecorator(input);
+            sensor->setCalibrator(calibrator);
+            this->inputs.push_back(input);
+            return sensor;
+        };
+
+        for (std::size_t i = 0; i < 5; i++) {
+            this->sensors.curl.fingers[i].curl[0] =
+              make(curl_calibrator ? new Calibration::MinMaxCalibrator<float>() : nullptr);
+            this->sensors.splay.fingers[i] = make(nullptr);
+        }
+        this->sensors.joystick.x = make(nullptr);
+        this->sensors.joystick.y = make(nullptr);
+        this->sensors.analog_buttons[0].value = make(nullptr);
+    }
+
+    void feed(const std::size_t seed)
+    {
+        for (std::size_t i = 0; i < this->inputs.size(); i++) {
+            this->inputs[i]->value = static_cast<float>((seed * 7 + i * 13) % 101) / 100.0F;
+        }
+    }
+
+    void tick()
+    {
+        forEachAnalogChannel(this->sensors, [](std::size_t /*channel*/, FloatSensor* sensor) {
+            if (sensor != nullptr) {
+                sensor->tick();
+            }
+        });
+    }
+};
+
+void assert_equal_data(TestData expected, TestData actual)
+{
+    std::vector<float> expected_fields;
+    forEachAnalogChannel(expected, [&](std::size_t /*channel*/, float& field) { expected_fields.push_back(field); });
+
+    forEachAnalogChannel(actual, [&](const std::size_t channel, float& field) {
+        TEST_ASSERT_EQUAL_FLOAT(expected_fields[channel], field);
+    });
+}
+
+void test_bind_and_collect(void)
+{
+    TestGlove glove(true);
+    AnalogSensorTable<TestSensors> table;
+    bindAnalogChannels(glove.sensors, table);
+
+    TEST_ASSERT_EQUAL_size_t(5 + 5 + 2 + 1, table.getActiveCount());
+
+    // Curls have calibrators of their own, the table passes their values through
+    for (auto& finger : glove.sensors.curl.fingers) {
+        finger.curl[0]->startCalibration();
+    }
+    for (std::size_t seed = 0; seed < 3; seed++) {
+        glove.feed(seed);
+        table.tick();
+    }
+
+    TestData data{};
+    collectAnalogChannels(table, data, false);
+    assert_equal_data(collect_pointers(glove.sensors), data);
+
+    TestData raw{};
+    collectAnalogChannels(table, raw, true);
+    TEST_ASSERT_EQUAL_FLOAT(glove.sensors.joystick.y->getRawValue(), raw.joystick.y);
+}
+
+void test_bind_calibrates_curls_without_calibrator(void)
+{
+    TestGlove glove(false);
+    AnalogSensorTable<TestSensors> table;
+    bindAnalogChannels(glove.sensors, table);
+
+    TestGlove reference(true);
+
+    table.startCalibration();
+    forEachAnalogChannel(reference.sensors, [](std::size_t /*channel*/, FloatSensor* sensor) {
+        if (sensor != nullptr) {
+            sensor->startCalibration();
+        }
+    });
+
+    for (std::size_t seed = 0; seed < 10; seed++) {
+        glove.feed(seed);
+        reference.feed(seed);
+        table.tick();
+        reference.tick();
+
+        TestData data{};
+        collectAnalogChannels(table, data, false);
+        assert_equal_data(collect_pointers(reference.sensors), data);
+    }
+
+    // Splays are not curls: never calibrated by the table
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, table.getCalibrationMin(20));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, table.getCalibrationMax(20));
+}
+
+void test_benchmark_sensor_table(void)
+{
+    constexpr std::size_t iterations = 100000;
+
+    TestGlove pointer_glove(true);
+    TestGlove table_glove(false);
+    AnalogSensorTable<TestSensors> table;
+    bindAnalogChannels(table_glove.sensors, table);
+
+    pointer_glove.feed(1);
+    table_glove.feed(1);
+    pointer_glove.tick();
+    table.tick();
+
+    // Collection only: the sensors are already ticked
+    float pointer_sink = 0.0F;
+    const auto pointer_collect_ns = benchmark_ns(iterations, [&](std::size_t /*i*/) {
+        pointer_sink += collect_pointers(pointer_glove.sensors).joystick.x;
+    });
+    float table_sink = 0.0F;
+    const auto table_collect_ns = benchmark_ns(iterations, [&](std::size_t /*i*/) {
+        TestData data{};
+        collectAnalogChannels(table, data, false);
+        table_sink += data.joystick.x;
+    });
+    TEST_ASSERT_EQUAL_FLOAT(pointer_sink, table_sink);
+
+    // Calibration of the already read values: per-sensor virtual calibrators vs the table loops
+    std::vector<FloatSensor*> curls;
+    for (auto& finger : pointer_glove.sensors.curl.fingers) {
+        curls.push_back(finger.curl[0]);
+    }
+    const auto pointer_calibrate = [&](const bool calibrating) {
+        for (auto* sensor : curls) {
+            auto* calibrator = sensor->getCalibrator();
+            const auto input = sensor->getRawValue();
+            if (calibrating) {
+                calibrator->update(input);
+            }
+            pointer_sink += calibrator->calibrate(input);
+        }
+    };
+
+    table.startCalibration();
+    const auto pointer_calibrating_ns = benchmark_ns(iterations, [&](std::size_t /*i*/) { pointer_calibrate(true); });
+    const auto table_calibrating_ns = benchmark_ns(iterations, [&](std::size_t /*i*/) {
+        table.calibrate();
+        table_sink += table.getValue(0);
+    });
+
+    table.stopCalibration();
+    const auto pointer_calibrated_ns = benchmark_ns(iterations, [&](std::size_t /*i*/) { pointer_calibrate(false); });
+    const auto table_calibrated_ns = benchmark_ns(iterations, [&](std::size_t /*i*/) {
+        table.calibrate();
+        table_sink += table.getValue(0);
+    });
+
+    for (auto* sensor : curls) {
+        sensor->startCalibration();
+    }
+    table.startCalibration();
+
+    // Full tick and collect, with calibration
+    for (auto* sensor : curls) {
+        sensor->resetCalibration();
+    }
+    table.resetCalibration();
+
+    const auto pointer_tick_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        pointer_glove.feed(i);
+        pointer_glove.tick();
+        pointer_sink += collect_pointers(pointer_glove.sensors).curl.fingers[0].curl[0];
+    });
+    const auto table_tick_ns = benchmark_ns(iterations, [&](std::size_t i) {
+        table_glove.feed(i);
+        table.tick();
+        TestData data{};
+        collectAnalogChannels(table, data, false);
+        table_sink += data.curl.fingers[0].curl[0];
+    });
+
+    // Both layouts must produce the same output
+    assert_equal_data(collect_pointers(pointer_glove.sensors), [&] {
+        TestData data{};
+        collectAnalogChannels(table, data, false);
+        return data;
+    }());
+
+    char message[96];
+    snprintf(message, sizeof(message), "collect: pointers %.1f ns, table %.1f ns", pointer_collect_ns, table_collect_ns);
+    TEST_MESSAGE(message);
+    snprintf(
+      message,
+      sizeof(message),
+      "calibrating: pointers %.1f ns, table %.1f ns",
+      pointer_calibrating_ns,
+      table_calibrating_ns
+    );
+    TEST_MESSAGE(message);
+    snprintf(
+      message,
+      sizeof(message),
+      "calibrated: pointers %.1f ns, table %.1f ns",
+      pointer_calibrated_ns,
+      table_calibrated_ns
+    );
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message), "tick: pointers %.1f ns, table %.1f ns", pointer_tick_ns, table_tick_ns);
+    TEST_MESSAGE(message);
+}
+
+int process(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_table_unbound_channels);
+    RUN_TEST(test_table_tick_copies_values);
+    RUN_TEST(test_table_collect_does_not_tick);
+    RUN_TEST(test_table_calibration_matches_min_max_calibrator);
+    RUN_TEST(test_table_calibrates_only_flagged_channels);
+    RUN_TEST(test_analog_channel_order);
+    RUN_TEST(test_bind_and_collect);
+    RUN_TEST(test_bind_calibrates_curls_without_calibrator);
+
+    RUN_TEST(test_benchmark_sensor_table);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+void setup(void)
+{
+    process();
+}
+
+void loop(void)
+{
+}
+
+#else
+
+int main()
+{
+    return process();
+}
+
+#endif
@@ -31,6 +31,7 @@ static constexpr Body::Hands::HandSide handSide = Body::Hands::HandSide::SS_HAND
 // clang-format off
 static const auto& bhLayout = handSide == Body::Hands::HandSide::Left ? BH::TactGloveLeftLayout : BH::TactGloveRightLayout;
 // clang-format on
+static FloatBody::LayoutBinding<BH_LAYOUT_TACTGLOVE_SIZE> bhBinding;
 
 void setup()
 {
@@ -48,6 +49,7 @@ void setup()
     );
 
     app->getVibroBody()->setup();
+    bhBinding = app->getVibroBody()->bindLayout(bhLayout);
 
     auto* bhBleConnection = new BLE::Connection(
       {
@@ -55,8 +57,8 @@ void setup()
         .appearance = BH_BLE_APPEARANCE,
         .serialNumber = BH_SERIAL_NUMBER,
       },
-      [](std::string& value) -> void {
-          Decoder::applyPlain(app->getVibroBody(), value, bhLayout, Effect::Vibro);
+      [](const std::uint8_t* data, std::size_t length) -> void {
+          Decoder::applyPlain(bhBinding, data, length);
       },
       app
     );
@@ -28,6 +28,7 @@ Application App;
 Application* app = &App;
 
 static const std::array<Position, BH_LAYOUT_TACTOSYH_SIZE> bhLayout = { BH_LAYOUT_TACTOSYH };
+static FloatBody::LayoutBinding<BH_LAYOUT_TACTOSYH_SIZE> bhBinding;
 
 void setup()
 {
@@ -40,9 +41,10 @@ void setup()
       // clang-format on
     });
 
-    app->getVibroBody()->addTarget(Target::Accessory, new FloatPlane(handOutputs));
+    app->getVibroBody()->addTarget(Target::Accessory, new FloatDensePlane(handOutputs));
 
     app->getVibroBody()->setup();
+    bhBinding = app->getVibroBody()->bindLayout(Target::Accessory, bhLayout);
 
     auto* bhBleConnection = new BLE::Connection(
       {
@@ -50,8 +52,8 @@ void setup()
         .appearance = BH_BLE_APPEARANCE,
         .serialNumber = BH_SERIAL_NUMBER,
       },
-      [](std::string& value) -> void {
-          Decoder::applyPlain(app->getVibroBody(), value, bhLayout, Effect::Vibro, Target::Accessory);
+      [](const std::uint8_t* data, std::size_t length) -> void {
+          Decoder::applyPlain(bhBinding, data, length);
       },
       app
     );
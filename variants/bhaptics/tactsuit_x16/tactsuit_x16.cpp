@@ -28,6 +28,7 @@ Application App;
 Application* app = &App;
 
 static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX16_SIZE> bhLayout = { BH_LAYOUT_TACTSUITX16 };
+static FloatBody::LayoutBinding<BH_LAYOUT_TACTSUITX16_SIZE> bhBinding;
 
 // Ouput indices, responsible for x40 => x16 grouping
 static const std::array<std::uint8_t, BH_LAYOUT_TACTSUITX16_GROUPS_SIZE> layoutGroups = BH_LAYOUT_TACTSUITX16_GROUPS;
@@ -48,10 +49,11 @@ void setup()
       // clang-format on
     });
 
-    app->getVibroBody()->addTarget(Target::ChestFront, new FloatPlane(frontOutputs));
-    app->getVibroBody()->addTarget(Target::ChestBack, new FloatPlane(backOutputs));
+    app->getVibroBody()->addTarget(Target::ChestFront, new FloatDensePlane(frontOutputs));
+    app->getVibroBody()->addTarget(Target::ChestBack, new FloatDensePlane(backOutputs));
 
     app->getVibroBody()->setup();
+    bhBinding = app->getVibroBody()->bindLayout(bhLayout);
 
     auto* bhBleConnection = new BLE::Connection(
       {
@@ -59,8 +61,8 @@ void setup()
         .appearance = BH_BLE_APPEARANCE,
         .serialNumber = BH_SERIAL_NUMBER,
       },
-      [](std::string& value) -> void {
-          Decoder::applyVestGrouped(app->getVibroBody(), value, bhLayout, layoutGroups);
+      [](const std::uint8_t* data, std::size_t length) -> void {
+          Decoder::applyVestGrouped(bhBinding, data, length, layoutGroups);
       },
       app
     );
@@ -15,7 +15,7 @@
 #include <senseshift/bh/devices.hpp>
 #include <senseshift/bh/encoding.hpp>
 #include <senseshift/freertos/task.hpp>
-#include <senseshift/output/i2cdevlib_pwm.hpp>
+#include <senseshift/output/pca9685_bank.hpp>
 
 using namespace SenseShift;
 using namespace SenseShift::Input;
@@ -31,6 +31,9 @@ Application App;
 Application* app = &App;
 
 static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX16_SIZE> bhLayout = { BH_LAYOUT_TACTSUITX16 };
+static FloatBody::LayoutBinding<BH_LAYOUT_TACTSUITX16_SIZE> bhBinding;
+static ::SenseShift::FreeRTOS::MailboxTask<Decoder::VestPayload>* bhOutputTask;
+static PCA9685Bank<TwoWire>* pwmBank;
 
 // Ouput indices, responsible for x40 => x16 grouping
 static const std::array<std::uint8_t, BH_LAYOUT_TACTSUITX16_GROUPS_SIZE> layoutGroups = BH_LAYOUT_TACTSUITX16_GROUPS;
@@ -48,24 +51,44 @@ void setup()
         LOG_E("pca9685", "Failed to wake up");
     }
 
+    // Stage the channel values, and write the chip in a single transaction per packet
+    pwmBank = new PCA9685Bank<TwoWire>(Wire, 0x40);
+    pwmBank->init();
+
     // Assign the pins on the configured PCA9685 to positions on the vest
     auto frontOutputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>({
       // clang-format off
-      { new PCA9685Output(pwm, 0), new PCA9685Output(pwm, 1), new PCA9685Output(pwm, 2), new PCA9685Output(pwm, 3) },
-      { new PCA9685Output(pwm, 4), new PCA9685Output(pwm, 5), new PCA9685Output(pwm, 6), new PCA9685Output(pwm, 7) },
+      { pwmBank->getOutput(0), pwmBank->getOutput(1), pwmBank->getOutput(2), pwmBank->getOutput(3) },
+      { pwmBank->getOutput(4), pwmBank->getOutput(5), pwmBank->getOutput(6), pwmBank->getOutput(7) },
       // clang-format on
     });
     auto backOutputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>({
       // clang-format off
-      { new PCA9685Output(pwm, 8),  new PCA9685Output(pwm, 9),  new PCA9685Output(pwm, 10), new PCA9685Output(pwm, 11) },
-      { new PCA9685Output(pwm, 12), new PCA9685Output(pwm, 13), new PCA9685Output(pwm, 14), new PCA9685Output(pwm, 15) },
+      { pwmBank->getOutput(8),  pwmBank->getOutput(9),  pwmBank->getOutput(10), pwmBank->getOutput(11) },
+      { pwmBank->getOutput(12), pwmBank->getOutput(13), pwmBank->getOutput(14), pwmBank->getOutput(15) },
       // clang-format on
     });
 
-    app->getVibroBody()->addTarget(Target::ChestFront, new FloatPlane(frontOutputs));
-    app->getVibroBody()->addTarget(Target::ChestBack, new FloatPlane(backOutputs));
+    auto* frontPlane = new FloatDensePlane(frontOutputs);
+    auto* backPlane = new FloatDensePlane(backOutputs);
+    // Most of the packets repeat the previous intensities, skip the I2C writes for those
+    frontPlane->enableChangeOnlyWrites(PCA9685_VALUE_MAX);
+    backPlane->enableChangeOnlyWrites(PCA9685_VALUE_MAX);
+
+    app->getVibroBody()->addTarget(Target::ChestFront, frontPlane);
+    app->getVibroBody()->addTarget(Target::ChestBack, backPlane);
 
     app->getVibroBody()->setup();
+    bhBinding = app->getVibroBody()->bindLayout(bhLayout);
+
+    bhOutputTask = new ::SenseShift::FreeRTOS::MailboxTask<Decoder::VestPayload>(
+      [](const Decoder::VestPayload& packet) -> void {
+          Decoder::applyVestGrouped(bhBinding, packet, layoutGroups);
+          pwmBank->flush();
+      },
+      { "Haptic Output", 4096, SS_BH_OUTPUT_TASK_PRIORITY, tskNO_AFFINITY }
+    );
+    bhOutputTask->begin();
 
     auto* bhBleConnection = new BLE::Connection(
       {
@@ -73,8 +96,11 @@ void setup()
         .appearance = BH_BLE_APPEARANCE,
         .serialNumber = BH_SERIAL_NUMBER,
       },
-      [](std::string& value) -> void {
-          Decoder::applyVestGrouped(app->getVibroBody(), value, bhLayout, layoutGroups);
+      [](const std::uint8_t* data, std::size_t length) -> void {
+          // Only hand the packet over, the I2C writes are done by the output task
+          Decoder::VestPayload packet{};
+          std::memcpy(packet.data(), data, std::min(length, packet.size()));
+          bhOutputTask->publish(packet);
       },
       app
     );
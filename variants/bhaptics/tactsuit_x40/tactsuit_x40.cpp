@@ -16,7 +16,7 @@
 #include <senseshift/bh/devices.hpp>
 #include <senseshift/bh/encoding.hpp>
 #include <senseshift/freertos/task.hpp>
-#include <senseshift/output/i2cdevlib_pwm.hpp>
+#include <senseshift/output/pca9685_bank.hpp>
 
 using namespace SenseShift;
 using namespace SenseShift::Input;
@@ -33,6 +33,10 @@ Application App;
 Application* app = &App;
 
 static const std::array<OutputLayout, BH_LAYOUT_TACTSUITX40_SIZE> bhLayout = { BH_LAYOUT_TACTSUITX40 };
+static FloatBody::LayoutBinding<BH_LAYOUT_TACTSUITX40_SIZE> bhBinding;
+static ::SenseShift::FreeRTOS::MailboxTask<Decoder::VestPayload>* bhOutputTask;
+static PCA9685Bank<TwoWire>* pwmBank0;
+static PCA9685Bank<TwoWire>* pwmBank1;
 
 void setup()
 {
@@ -55,31 +59,54 @@ void setup()
         LOG_E("pca9685", "Failed to wake up");
     }
 
+    // Stage the channel values, and write each chip in a single transaction per packet
+    pwmBank0 = new PCA9685Bank<TwoWire>(Wire, 0x40);
+    pwmBank0->init();
+    pwmBank1 = new PCA9685Bank<TwoWire>(Wire, 0x41);
+    pwmBank1->init();
+
     // Assign the pins on the configured PCA9685s and PWM pins to locations on the
     // vest
     auto frontOutputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>({
       // clang-format off
-          { new PCA9685Output(pwm0, 0),  new PCA9685Output(pwm0, 1),  new PCA9685Output(pwm0, 2),  new PCA9685Output(pwm0, 3)  },
-          { new PCA9685Output(pwm0, 4),  new PCA9685Output(pwm0, 5),  new PCA9685Output(pwm0, 6),  new PCA9685Output(pwm0, 7)  },
-          { new PCA9685Output(pwm0, 8),  new PCA9685Output(pwm0, 9),  new PCA9685Output(pwm0, 10), new PCA9685Output(pwm0, 11) },
-          { new PCA9685Output(pwm0, 12), new PCA9685Output(pwm0, 13), new PCA9685Output(pwm0, 14), new PCA9685Output(pwm0, 15) },
-          { new LedcOutput(32),          new LedcOutput(33),          new LedcOutput(25),          new LedcOutput(26)          },
+          { pwmBank0->getOutput(0),  pwmBank0->getOutput(1),  pwmBank0->getOutput(2),  pwmBank0->getOutput(3)  },
+          { pwmBank0->getOutput(4),  pwmBank0->getOutput(5),  pwmBank0->getOutput(6),  pwmBank0->getOutput(7)  },
+          { pwmBank0->getOutput(8),  pwmBank0->getOutput(9),  pwmBank0->getOutput(10), pwmBank0->getOutput(11) },
+          { pwmBank0->getOutput(12), pwmBank0->getOutput(13), pwmBank0->getOutput(14), pwmBank0->getOutput(15) },
+          { new LedcOutput(32),      new LedcOutput(33),      new LedcOutput(25),      new LedcOutput(26)      },
       // clang-format on
     });
     auto backOutputs = PlaneMapper_Margin::mapMatrixCoordinates<FloatPlane::Actuator*>({
       // clang-format off
-          { new PCA9685Output(pwm1, 0),  new PCA9685Output(pwm1, 1),  new PCA9685Output(pwm1, 2),  new PCA9685Output(pwm1, 3)  },
-          { new PCA9685Output(pwm1, 4),  new PCA9685Output(pwm1, 5),  new PCA9685Output(pwm1, 6),  new PCA9685Output(pwm1, 7)  },
-          { new PCA9685Output(pwm1, 8),  new PCA9685Output(pwm1, 9),  new PCA9685Output(pwm1, 10), new PCA9685Output(pwm1, 11) },
-          { new PCA9685Output(pwm1, 12), new PCA9685Output(pwm1, 13), new PCA9685Output(pwm1, 14), new PCA9685Output(pwm1, 15) },
-          { new LedcOutput(27),          new LedcOutput(14),          new LedcOutput(12),          new LedcOutput(13)          },
+          { pwmBank1->getOutput(0),  pwmBank1->getOutput(1),  pwmBank1->getOutput(2),  pwmBank1->getOutput(3)  },
+          { pwmBank1->getOutput(4),  pwmBank1->getOutput(5),  pwmBank1->getOutput(6),  pwmBank1->getOutput(7)  },
+          { pwmBank1->getOutput(8),  pwmBank1->getOutput(9),  pwmBank1->getOutput(10), pwmBank1->getOutput(11) },
+          { pwmBank1->getOutput(12), pwmBank1->getOutput(13), pwmBank1->getOutput(14), pwmBank1->getOutput(15) },
+          { new LedcOutput(27),      new LedcOutput(14),      new LedcOutput(12),      new LedcOutput(13)      },
       // clang-format on
     });
 
-    app->getVibroBody()->addTarget(Target::ChestFront, new FloatPlane(frontOutputs));
-    app->getVibroBody()->addTarget(Target::ChestBack, new FloatPlane(backOutputs));
+    auto* frontPlane = new FloatDensePlane(frontOutputs);
+    auto* backPlane = new FloatDensePlane(backOutputs);
+    // Most of the packets repeat the previous intensities, skip the I2C writes for those
+    frontPlane->enableChangeOnlyWrites(PCA9685_VALUE_MAX);
+    backPlane->enableChangeOnlyWrites(PCA9685_VALUE_MAX);
+
+    app->getVibroBody()->addTarget(Target::ChestFront, frontPlane);
+    app->getVibroBody()->addTarget(Target::ChestBack, backPlane);
 
     app->getVibroBody()->setup();
+    bhBinding = app->getVibroBody()->bindLayout(bhLayout);
+
+    bhOutputTask = new ::SenseShift::FreeRTOS::MailboxTask<Decoder::VestPayload>(
+      [](const Decoder::VestPayload& packet) -> void {
+          Decoder::applyVest(bhBinding, packet);
+          pwmBank0->flush();
+          pwmBank1->flush();
+      },
+      { "Haptic Output", 4096, SS_BH_OUTPUT_TASK_PRIORITY, tskNO_AFFINITY }
+    );
+    bhOutputTask->begin();
 
     auto* bhBleConnection = new BLE::Connection(
       {
@@ -87,8 +114,11 @@ void setup()
         .appearance = BH_BLE_APPEARANCE,
         .serialNumber = BH_SERIAL_NUMBER,
       },
-      [](std::string& value) -> void {
-          Decoder::applyVest(app->getVibroBody(), value, bhLayout);
+      [](const std::uint8_t* data, std::size_t length) -> void {
+          // Only hand the packet over, the I2C writes are done by the output task
+          Decoder::VestPayload packet{};
+          std::memcpy(packet.data(), data, std::min(length, packet.size()));
+          bhOutputTask->publish(packet);
       },
       app
     );
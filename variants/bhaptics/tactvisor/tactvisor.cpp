@@ -28,6 +28,7 @@ Application App;
 Application* app = &App;
 
 static const std::array<Position, BH_LAYOUT_TACTVISOR_SIZE> bhLayout = { BH_LAYOUT_TACTVISOR };
+static FloatBody::LayoutBinding<BH_LAYOUT_TACTVISOR_SIZE> bhBinding;
 
 void setup()
 {
@@ -38,9 +39,10 @@ void setup()
       // clang-format on
     });
 
-    app->getVibroBody()->addTarget(Target::FaceFront, new FloatPlane(faceOutputs));
+    app->getVibroBody()->addTarget(Target::FaceFront, new FloatDensePlane(faceOutputs));
 
     app->getVibroBody()->setup();
+    bhBinding = app->getVibroBody()->bindLayout(Target::FaceFront, bhLayout);
 
     auto* bhBleConnection = new BLE::Connection(
       {
@@ -48,8 +50,8 @@ void setup()
         .appearance = BH_BLE_APPEARANCE,
         .serialNumber = BH_SERIAL_NUMBER,
       },
-      [](std::string& value) -> void {
-          Decoder::applyPlain(app->getVibroBody(), value, bhLayout, Effect::Vibro, Target::FaceFront);
+      [](const std::uint8_t* data, std::size_t length) -> void {
+          Decoder::applyPlain(bhBinding, data, length);
       },
       app
     );
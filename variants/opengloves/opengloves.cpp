@@ -1,6 +1,8 @@
 #include <senseshift/freertos/task.hpp>
 #include <senseshift/opengloves/autoconfig.hpp>
+#include <senseshift/opengloves/line_framer.hpp>
 #include <senseshift/opengloves/opengloves_component.hpp>
+#include <senseshift/opengloves/queued_transport.hpp>
 
 #include "opengloves/alpha.hpp"
 
@@ -9,21 +11,46 @@ namespace og = ::opengloves;
 
 void setup()
 {
-    auto* communication = AutoConfig::createTransport();
+    // Frames are written by a separate task, so the tracking never waits for the radio
+    auto* communication = new QueuedTransport<::SenseShift::FreeRTOS::MailboxTask<TransportFrame<256>>>(
+      AutoConfig::createTransport(),
+      ::SenseShift::FreeRTOS::TaskConfig{
+        .name = "OG_TX",
+        .stackDepth = 4096,
+        .priority = 2,
+      }
+    );
 
     auto input_sensors = AutoConfig::createInput();
 
+    std::optional<SendOnChangeConfig> send_on_change = std::nullopt;
+#if SEND_ON_CHANGE_ENABLED
+    send_on_change = SendOnChangeConfig{
+        .analog_max = SEND_ON_CHANGE_ANALOG_MAX,
+        .curl_threshold = SEND_ON_CHANGE_THRESHOLD,
+        .splay_threshold = SEND_ON_CHANGE_THRESHOLD,
+        .joystick_threshold = SEND_ON_CHANGE_THRESHOLD,
+        .analog_button_threshold = SEND_ON_CHANGE_THRESHOLD,
+        .keepalive_ms = SEND_ON_CHANGE_KEEPALIVE,
+    };
+#endif
+
     OpenGlovesTrackingComponent<og::AlphaEncoding>::Config tracking_config(
       CALIBRATION_DURATION,
-      CALIBRATION_ALWAYS_CALIBRATE
+      CALIBRATION_ALWAYS_CALIBRATE,
+      send_on_change
+    );
+    auto* og_tracking = new OpenGlovesTrackingComponent<og::AlphaEncoding>(
+      tracking_config,
+      input_sensors,
+      communication,
+      AutoConfig::createCalibrationStore()
     );
-    auto* og_tracking =
-      new OpenGlovesTrackingComponent<og::AlphaEncoding>(tracking_config, input_sensors, communication);
 
     auto* og_tracking_task =
       new SenseShift::FreeRTOS::ComponentUpdateTask<OpenGlovesTrackingComponent<og::AlphaEncoding>>(
         og_tracking,
-        1000 / UPDATE_RATE,
+        std::chrono::microseconds(1000000 / UPDATE_RATE),
         {
           .name = "OG_TRACKING",
           .stackDepth = 8192,
@@ -36,11 +63,24 @@ void setup()
     auto output_writers = AutoConfig::createFfbOutputs();
 
     auto* og_ffb = new OpenGlovesForceFeedbackComponent<og::AlphaEncoding>(output_writers, communication);
+    og_ffb->setCommandHandler([og_tracking](const char* command, size_t length) -> bool {
+#if defined(SS_PROFILING_ENABLED) && SS_PROFILING_ENABLED == true
+        if (isCommand(command, length, SS_PROFILING_COMMAND)) {
+            og_tracking->requestStageReport();
+            return true;
+        }
+#endif
+        if (isCommand(command, length, CALIBRATION_RESET_COMMAND)) {
+            og_tracking->requestCalibrationReset();
+            return true;
+        }
+        return false;
+    });
 
     auto* og_ffb_task =
       new ::SenseShift::FreeRTOS::ComponentUpdateTask<OpenGlovesForceFeedbackComponent<og::AlphaEncoding>>(
         og_ffb,
-        1000 / UPDATE_RATE,
+        std::chrono::microseconds(1000000 / UPDATE_RATE),
         {
           .name = "OG_FFB",
           .stackDepth = 8192,